@@ -16,4 +16,17 @@ vec3 DecodeNormal(vec2 encodedNormal)
     return normalize(decodedNormal);
 }
 
+vec3 DecodeNormal(uint encodedNormal)
+{
+    return DecodeNormal(unpackSnorm2x16(encodedNormal));
+}
+
+// the lowest bit of the second component carries the bitangent sign
+vec4 DecodeTangent(uint encodedTangent)
+{
+    const uint tangentSignBit = 1u << 16;
+    float tangentSign = (encodedTangent & tangentSignBit) != 0u ? -1.0 : 1.0;
+    return vec4(DecodeNormal(unpackSnorm2x16(encodedTangent & ~tangentSignBit)), tangentSign);
+}
+
 #endif // BASICFUNCTIONS_INCLUDE_GLSL
\ No newline at end of file
@@ -0,0 +1,46 @@
+#version 460 core
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+// level 0 is reduced from the depth buffer, every further level from the level above it
+layout(binding = 0) uniform sampler2D u_depth;
+layout(binding = 0, r32f) uniform readonly image2D u_source_level;
+layout(binding = 1, r32f) uniform writeonly image2D u_destination_level;
+
+layout(location = 0) uniform int u_level;
+
+void main()
+{
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 destinationSize = imageSize(u_destination_level);
+    if (any(greaterThanEqual(texel, destinationSize))) {
+        return;
+    }
+
+    // every texel keeps the farthest depth it covers, so a bounds in front of it is in front of everything below it
+    float farthestDepth = 0.0;
+    if (u_level == 0) {
+
+        // level 0 is the power of two below the depth buffer, a texel can cover parts of up to three depth texels per axis
+        ivec2 sourceSize = textureSize(u_depth, 0);
+        vec2 ratio = vec2(sourceSize) / vec2(destinationSize);
+        ivec2 firstSourceTexel = ivec2(floor(vec2(texel) * ratio));
+        ivec2 lastSourceTexel = min(ivec2(ceil(vec2(texel + 1) * ratio)) - 1, sourceSize - 1);
+        for (int y = firstSourceTexel.y; y <= lastSourceTexel.y; ++y) {
+            for (int x = firstSourceTexel.x; x <= lastSourceTexel.x; ++x) {
+                farthestDepth = max(farthestDepth, texelFetch(u_depth, ivec2(x, y), 0).r);
+            }
+        }
+    } else {
+
+        // power of two levels halve exactly, only an axis which reached 1 already repeats its last texel
+        ivec2 sourceSize = imageSize(u_source_level);
+        ivec2 sourceTexel = texel * 2;
+        ivec2 nextSourceTexel = min(sourceTexel + 1, sourceSize - 1);
+        farthestDepth = max(
+            max(imageLoad(u_source_level, sourceTexel).r, imageLoad(u_source_level, ivec2(nextSourceTexel.x, sourceTexel.y)).r),
+            max(imageLoad(u_source_level, ivec2(sourceTexel.x, nextSourceTexel.y)).r, imageLoad(u_source_level, nextSourceTexel).r));
+    }
+
+    imageStore(u_destination_level, texel, vec4(farthestDepth));
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#version 460 core
+
+layout(local_size_x = 64) in;
+
+#include "GpuConstants.include.glsl"
+#include "GpuMeshlet.include.glsl"
+#include "GpuModelMeshInstance.include.glsl"
+#include "GpuClusterDraw.include.glsl"
+
+struct DrawElementsIndirectCommand {
+    uint IndexCount;
+    uint InstanceCount;
+    uint FirstIndex;
+    int BaseVertex;
+    uint BaseInstance;
+};
+
+layout(binding = 5, std430) writeonly buffer DrawCommandBuffer {
+    DrawElementsIndirectCommand DrawCommands[];
+} drawCommandBuffer;
+
+// one count per phase and index type for the whole scene, each geometry pass draws exactly that many commands,
+// the late phase is dispatched indirectly with one work group per 64 meshlets the early phase rejected
+layout(binding = 6, std430) buffer DrawCountBuffer {
+    uint EarlyDrawCount;
+    uint LateDrawCount;
+    uint EarlyShortDrawCount;
+    uint LateShortDrawCount;
+    uint RejectedMeshletCount;
+    uint LateWorkGroupCountX;
+    uint LateWorkGroupCountY;
+    uint LateWorkGroupCountZ;
+} drawCountBuffer;
+
+struct CullWorkItem {
+    uint ClusterDrawIndex;
+    uint FirstMeshlet;
+};
+
+// one per work group, each covers up to 64 meshlets of one cluster draw
+layout(binding = 7, std430) readonly buffer CullWorkItemBuffer {
+    CullWorkItem WorkItems[];
+} cullWorkItemBuffer;
+
+struct RejectedMeshlet {
+    uint ClusterDrawIndex;
+    uint MeshletIndex;
+};
+
+// meshlets the early phase found occluded by last frame's depth, tested again once this frame's occluders are drawn
+layout(binding = 9, std430) buffer RejectedMeshletBuffer {
+    RejectedMeshlet RejectedMeshlets[];
+} rejectedMeshletBuffer;
+
+// farthest depth per texel, a mip chain down to 1x1
+layout(binding = 0) uniform sampler2D u_depth_pyramid;
+
+layout(location = 2) uniform uint u_work_item_count;
+// 0 culls the work items against last frame's depth pyramid, 1 the rejected meshlets against this frame's
+layout(location = 3) uniform uint u_phase;
+// commands of meshes with 16 bit indices start here, behind the room for the 32 bit ones
+layout(location = 4) uniform uint u_first_short_draw_command;
+
+const uint IndexElementTypeUnsignedShort = 0;
+
+// beyond this many rejected meshlets the late dispatch would not fit into x, the rest is drawn early instead
+const uint MaxRejectedMeshletCount = 65535 * 64;
+
+bool IsOutsideFrustum(vec3 center, float radius)
+{
+    for (int planeIndex = 0; planeIndex < 6; ++planeIndex) {
+        if (dot(FrustumPlanes[planeIndex].xyz, center) + FrustumPlanes[planeIndex].w < -radius) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// the cone contains all triangle normals, the meshlet is backfacing when the camera sees it from within the cone
+bool IsBackfacing(vec3 center, float radius, vec3 coneAxis, float coneCutoff)
+{
+    vec3 cameraToCenter = center - CameraPosition.xyz;
+    return dot(cameraToCenter, coneAxis) >= coneCutoff * length(cameraToCenter) + radius;
+}
+
+// projects the corners of the box around the sphere, which holds for any projection, a sphere crossing
+// the near plane covers too much of the screen to be worth testing and counts as visible
+bool IsOccluded(vec3 center, float radius)
+{
+    mat4 viewProjectionMatrix = ProjectionMatrix * ViewMatrix;
+    vec4 rectangle = vec4(1.0, 1.0, -1.0, -1.0);
+    float nearestDepth = 1.0;
+    for (int corner = 0; corner < 8; ++corner) {
+        vec3 offset = vec3((corner & 1) != 0 ? radius : -radius, (corner & 2) != 0 ? radius : -radius, (corner & 4) != 0 ? radius : -radius);
+        vec4 clipPosition = viewProjectionMatrix * vec4(center + offset, 1.0);
+        if (clipPosition.w <= 0.0) {
+            return false;
+        }
+
+        vec3 ndcPosition = clipPosition.xyz / clipPosition.w;
+        rectangle.xy = min(rectangle.xy, ndcPosition.xy);
+        rectangle.zw = max(rectangle.zw, ndcPosition.xy);
+        nearestDepth = min(nearestDepth, ndcPosition.z * 0.5 + 0.5);
+    }
+
+    // the level on which the rectangle covers at most 2x2 texels
+    vec4 uvRectangle = clamp(rectangle * 0.5 + 0.5, 0.0, 1.0);
+    vec2 sizeInTexels = (uvRectangle.zw - uvRectangle.xy) * vec2(textureSize(u_depth_pyramid, 0));
+    int level = min(int(ceil(log2(max(max(sizeInTexels.x, sizeInTexels.y), 1.0)))), textureQueryLevels(u_depth_pyramid) - 1);
+
+    ivec2 levelSize = textureSize(u_depth_pyramid, level);
+    ivec2 firstTexel = min(ivec2(uvRectangle.xy * vec2(levelSize)), levelSize - 1);
+    ivec2 lastTexel = min(ivec2(uvRectangle.zw * vec2(levelSize)), levelSize - 1);
+    float farthestDepth = 0.0;
+    for (int y = firstTexel.y; y <= lastTexel.y; ++y) {
+        for (int x = firstTexel.x; x <= lastTexel.x; ++x) {
+            farthestDepth = max(farthestDepth, texelFetch(u_depth_pyramid, ivec2(x, y), level).r);
+        }
+    }
+
+    return nearestDepth > farthestDepth;
+}
+
+// meshlet index offsets are relative to the mesh, the mesh is relative to its ranges in the mega buffers,
+// both phases write to their own command buffer, bound to the same binding
+void EmitDrawCommand(uint drawCommandIndex, uint clusterDrawIndex, GpuClusterDraw clusterDraw, GpuMeshlet meshlet)
+{
+    drawCommandBuffer.DrawCommands[drawCommandIndex] = DrawElementsIndirectCommand(
+        meshlet.IndexCount,
+        clusterDraw.InstanceCount,
+        clusterDraw.FirstIndex + meshlet.IndexOffset,
+        int(clusterDraw.BaseVertex),
+        clusterDraw.FirstInstance);
+    commandClusterDrawIndexBuffer.ClusterDrawIndices[drawCommandIndex] = clusterDrawIndex;
+}
+
+// each index type is drawn by its own call, its commands are counted apart and written to its own range,
+// the atomics hand out slots in whichever order the invocations get to them, the order of the cluster draws is not kept
+uint AllocateDrawCommand(GpuClusterDraw clusterDraw, uint phase)
+{
+    if (clusterDraw.IndexElementType == IndexElementTypeUnsignedShort) {
+        return u_first_short_draw_command + (phase == 0
+            ? atomicAdd(drawCountBuffer.EarlyShortDrawCount, 1)
+            : atomicAdd(drawCountBuffer.LateShortDrawCount, 1));
+    }
+
+    return phase == 0
+        ? atomicAdd(drawCountBuffer.EarlyDrawCount, 1)
+        : atomicAdd(drawCountBuffer.LateDrawCount, 1);
+}
+
+void main()
+{
+    uint clusterDrawIndex = 0;
+    uint meshletIndex = 0;
+    if (u_phase == 0) {
+
+        // the dispatch wraps into y once there are more work items than work groups fit into x
+        uint workItemIndex = gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x;
+        if (workItemIndex >= u_work_item_count) {
+            return;
+        }
+
+        CullWorkItem workItem = cullWorkItemBuffer.WorkItems[workItemIndex];
+        clusterDrawIndex = workItem.ClusterDrawIndex;
+        meshletIndex = workItem.FirstMeshlet + gl_LocalInvocationID.x;
+    } else {
+
+        uint rejectedMeshletIndex = gl_GlobalInvocationID.x;
+        if (rejectedMeshletIndex >= min(drawCountBuffer.RejectedMeshletCount, MaxRejectedMeshletCount)) {
+            return;
+        }
+
+        RejectedMeshlet rejectedMeshlet = rejectedMeshletBuffer.RejectedMeshlets[rejectedMeshletIndex];
+        clusterDrawIndex = rejectedMeshlet.ClusterDrawIndex;
+        meshletIndex = rejectedMeshlet.MeshletIndex;
+    }
+
+    GpuClusterDraw clusterDraw = clusterDrawBuffer.ClusterDraws[clusterDrawIndex];
+    if (meshletIndex >= clusterDraw.MeshletCount) {
+        return;
+    }
+
+    GpuMeshlet meshlet = meshletBuffer.Meshlets[clusterDraw.FirstMeshlet + meshletIndex];
+
+    // one command draws the meshlet for every instance, it is kept as soon as a single instance sees it,
+    // it is rejected for now when instances are in the frustum and facing the camera but hidden behind the depth pyramid
+    bool isVisible = false;
+    bool isOccluded = false;
+    uint lastInstance = clusterDraw.FirstInstance + clusterDraw.InstanceCount;
+    for (uint instanceIndex = clusterDraw.FirstInstance; instanceIndex < lastInstance && !isVisible; ++instanceIndex) {
+
+        mat4 worldMatrix = modelMeshInstanceBuffer.Instances[instanceIndex].WorldMatrix;
+
+        // the largest axis scale keeps the sphere conservative under non uniform scale
+        vec3 worldScale = vec3(length(worldMatrix[0].xyz), length(worldMatrix[1].xyz), length(worldMatrix[2].xyz));
+        vec3 center = (worldMatrix * vec4(meshlet.BoundingSphere.xyz, 1.0)).xyz;
+        float radius = meshlet.BoundingSphere.w * max(worldScale.x, max(worldScale.y, worldScale.z));
+        vec3 coneAxis = normalize(mat3(worldMatrix) * meshlet.ConeAxisCutoff.xyz);
+
+        if (IsOutsideFrustum(center, radius) || IsBackfacing(center, radius, coneAxis, meshlet.ConeAxisCutoff.w)) {
+            continue;
+        }
+
+        isVisible = !IsOccluded(center, radius);
+        isOccluded = !isVisible;
+    }
+
+    if (isVisible) {
+        EmitDrawCommand(AllocateDrawCommand(clusterDraw, u_phase), clusterDrawIndex, clusterDraw, meshlet);
+        return;
+    }
+
+    // the late phase drops what is still occluded, the early phase hands it over
+    if (!isOccluded || u_phase != 0) {
+        return;
+    }
+
+    uint rejectedMeshletIndex = atomicAdd(drawCountBuffer.RejectedMeshletCount, 1);
+    if (rejectedMeshletIndex >= MaxRejectedMeshletCount) {
+        EmitDrawCommand(AllocateDrawCommand(clusterDraw, 0), clusterDrawIndex, clusterDraw, meshlet);
+        return;
+    }
+
+    rejectedMeshletBuffer.RejectedMeshlets[rejectedMeshletIndex] = RejectedMeshlet(clusterDrawIndex, meshletIndex);
+    if (rejectedMeshletIndex % 64 == 0) {
+        atomicAdd(drawCountBuffer.LateWorkGroupCountX, 1);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+// one per entity and frame, written by the renderer, the draw commands of its visible meshlets point back to it
+struct GpuClusterDraw {
+    // maps the stored positions to mesh space
+    mat4 PositionDequantization;
+    uint FirstInstance;
+    uint InstanceCount;
+    uint FirstMeshlet;
+    uint MeshletCount;
+    uint BaseVertex;
+    uint FirstIndex;
+    uint FirstPositionWord;
+    uint VertexPositionFormat;
+    uint MaterialIndex;
+    // matches TIndexElementType, 0 for 16 bit indices, 1 for 32 bit ones
+    uint IndexElementType;
+    uint _padding1;
+    uint _padding2;
+};
+
+layout(binding = 3, std430) readonly buffer GpuClusterDrawBuffer {
+    GpuClusterDraw ClusterDraws[];
+} clusterDrawBuffer;
+
+// the cluster draw of every draw command, indexed by gl_DrawID
+layout(binding = 8, std430) buffer CommandClusterDrawIndexBuffer {
+    uint ClusterDrawIndices[];
+} commandClusterDrawIndexBuffer;
\ No newline at end of file
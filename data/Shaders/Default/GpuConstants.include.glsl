@@ -1,4 +1,6 @@
 layout(binding = 0, std140) uniform GpuConstants {
     mat4 ProjectionMatrix;
     mat4 ViewMatrix;
+    vec4 FrustumPlanes[6];
+    vec4 CameraPosition;
 };
\ No newline at end of file
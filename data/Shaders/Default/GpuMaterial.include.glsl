@@ -1,10 +1,14 @@
+// matches TGpuMaterial, texture handles are resident bindless handles, 0 when the material has no such texture
 struct GpuMaterial {
-    vec4 BaseColorFactor;
+    vec4 BaseColor;
+    vec4 Factors;
     uint64_t BaseColorTexture;
-    uint64_t _padding1;
+    uint64_t NormalTexture;
+    uint64_t ArmTexture;
+    uint64_t EmissiveTexture;
 };
 
-layout(binding = 2, std140) buffer MaterialBuffer
+layout(binding = 2, std430) readonly buffer MaterialBuffer
 {
     GpuMaterial[] Materials;
 } materialBuffer;
\ No newline at end of file
@@ -0,0 +1,16 @@
+struct GpuMeshlet {
+    uint VertexOffset;
+    uint TriangleOffset;
+    uint VertexCount;
+    uint TriangleCount;
+    uint IndexOffset;
+    uint IndexCount;
+    uint _padding1;
+    uint _padding2;
+    vec4 BoundingSphere;
+    vec4 ConeAxisCutoff;
+};
+
+layout(binding = 4, std430) readonly buffer GpuMeshletBuffer {
+    GpuMeshlet Meshlets[];
+} meshletBuffer;
\ No newline at end of file
@@ -6,18 +6,19 @@
 layout(location = 0) in vec3 v_position;
 layout(location = 1) in vec3 v_normal;
 layout(location = 2) in vec2 v_uv;
+layout(location = 3) flat in uint v_material_index;
 
 layout(location = 0) out vec4 o_color;
 
-layout(location = 5) uniform uint u_material_index;
-
 #include "GpuMaterial.include.glsl"
 
 void main()
 {
-    GpuMaterial material = materialBuffer.Materials[u_material_index];
-    vec4 color = material.BaseColorFactor.rgba;
-    color *= texture(sampler2D(material.BaseColorTexture), v_uv).rgba;
+    GpuMaterial material = materialBuffer.Materials[v_material_index];
+    vec4 color = material.BaseColor.rgba;
+    if (material.BaseColorTexture != 0) {
+        color *= texture(sampler2D(material.BaseColorTexture), v_uv).rgba;
+    }
 
-    o_color = vec4(color.rgb, u_material_index);
+    o_color = vec4(color.rgb, v_material_index);
 }
\ No newline at end of file
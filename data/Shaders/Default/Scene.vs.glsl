@@ -1,22 +1,62 @@
 #version 460 core
 
-layout(location = 0) in vec3 i_position;
-layout(location = 1) in vec3 i_normal;
-layout(location = 2) in vec2 i_uv;
-layout(location = 3) in vec4 i_tangent;
+layout(location = 1) in uint i_normal;
+layout(location = 2) in uint i_tangent;
+layout(location = 3) in vec2 i_uv;
 
 layout(location = 0) out vec3 v_position;
 layout(location = 1) out vec3 v_normal;
 layout(location = 2) out vec2 v_uv;
+layout(location = 3) flat out uint v_material_index;
 
 #include "GpuConstants.include.glsl"
+#include "GpuModelMeshInstance.include.glsl"
+#include "GpuClusterDraw.include.glsl"
+#include "../BasicFunctions.include.glsl"
 
-layout(location = 0) uniform mat4 u_world_matrix;
+// matches TVertexPositionFormat
+const uint VertexPositionFormatSnorm16x4 = 0;
+const uint VertexPositionFormatFloat32x3 = 1;
+const uint VertexPositionFormatSnorm8x4 = 2;
+
+// 0 for the draw of meshes with 32 bit indices, the first 16 bit command for the draw of the others
+layout(location = 0) uniform uint u_first_draw_command;
+
+// snorm 16 bit positions take two words per vertex, snorm 8 bit ones one, float positions three
+layout(binding = 10, std430) readonly buffer VertexPositionBuffer {
+    uint Words[];
+} vertexPositionBuffer;
+
+vec3 GetVertexPosition(in GpuClusterDraw clusterDraw)
+{
+    // the index buffer is relative to the base vertex, so is the vertex of the mesh
+    uint vertexIndex = uint(gl_VertexID - gl_BaseVertex);
+    if (clusterDraw.VertexPositionFormat == VertexPositionFormatSnorm16x4) {
+        uint firstWord = clusterDraw.FirstPositionWord + vertexIndex * 2;
+        return vec3(unpackSnorm2x16(vertexPositionBuffer.Words[firstWord]), unpackSnorm2x16(vertexPositionBuffer.Words[firstWord + 1]).x);
+    }
+
+    if (clusterDraw.VertexPositionFormat == VertexPositionFormatSnorm8x4) {
+        return unpackSnorm4x8(vertexPositionBuffer.Words[clusterDraw.FirstPositionWord + vertexIndex]).xyz;
+    }
+
+    uint firstWord = clusterDraw.FirstPositionWord + vertexIndex * 3;
+    return uintBitsToFloat(uvec3(vertexPositionBuffer.Words[firstWord], vertexPositionBuffer.Words[firstWord + 1], vertexPositionBuffer.Words[firstWord + 2]));
+}
 
 void main()
 {
-    v_position = (u_world_matrix * vec4(i_position, 1.0)).xyz;
-    v_normal = normalize(inverse(transpose(mat3(u_world_matrix))) * i_normal) + 0.00001 * vec3(i_tangent.xyz);
+    // all entities are drawn in one call per index type, the draw id finds the entity the command belongs to
+    GpuClusterDraw clusterDraw = clusterDrawBuffer.ClusterDraws[commandClusterDrawIndexBuffer.ClusterDrawIndices[u_first_draw_command + gl_DrawID]];
+
+    // the culling pass writes the instance range of the entity into the base instance of every command
+    mat4 worldMatrix = modelMeshInstanceBuffer.Instances[gl_BaseInstance + gl_InstanceID].WorldMatrix;
+
+    v_position = (worldMatrix * (clusterDraw.PositionDequantization * vec4(GetVertexPosition(clusterDraw), 1.0))).xyz;
+    vec3 normal = DecodeNormal(i_normal);
+    vec4 tangent = DecodeTangent(i_tangent);
+    v_normal = normalize(inverse(transpose(mat3(worldMatrix))) * normal) + 0.00001 * tangent.xyz;
     v_uv = i_uv;
+    v_material_index = clusterDraw.MaterialIndex;
     gl_Position = ProjectionMatrix * ViewMatrix * vec4(v_position, 1.0);
 }
\ No newline at end of file
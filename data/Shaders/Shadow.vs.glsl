@@ -36,5 +36,5 @@ void main()
     //SGpuGlobalLight global_light = u_global_lights[0];
     gl_Position = (u_global_lights[0].ProjectionMatrix *
                   (u_global_lights[0].ViewMatrix *
-                  (Objects[gl_DrawID].WorldMatrix * vec4(PackedToVec3(vertex_position.Position), 1.0))));
+                  (Objects[gl_DrawID].WorldMatrix * vec4(DecodePosition(vertex_position), 1.0))));
 }
\ No newline at end of file
@@ -41,11 +41,9 @@ void main()
     SVertexNormalUvTangent vertex_normal_uv_tangent = VertexNormalUvTangents[gl_VertexID];
     //SObject object = Objects[gl_InstanceID];
 
-    v_normal = DecodeNormal(unpackSnorm2x16(vertex_normal_uv_tangent.Normal));
-    vec3 tangent = DecodeNormal(unpackSnorm2x16(vertex_normal_uv_tangent.Tangent));
-    vec3 uv_and_tangent_sign = PackedToVec3(vertex_normal_uv_tangent.UvAndTangentSign);
-    v_uv = uv_and_tangent_sign.xy;
-    v_tangent = vec4(tangent, uv_and_tangent_sign.z);
+    v_normal = DecodeNormal(vertex_normal_uv_tangent.Normal);
+    v_uv = unpackHalf2x16(vertex_normal_uv_tangent.Uv);
+    v_tangent = DecodeTangent(vertex_normal_uv_tangent.Tangent);
     //v_material_id = object.InstanceParameter.x;
     v_material_id = u_object_parameters.x;
 
@@ -55,5 +53,5 @@ void main()
                   u_camera_information.ViewMatrix *
 //                  object.WorldMatrix * 
                   u_object_world_matrix *
-                  vec4(PackedToVec3(vertex_position.Position), 1.0);
+                  vec4(DecodePosition(vertex_position), 1.0);
 }
\ No newline at end of file
@@ -3,16 +3,23 @@
 
 #include "BasicTypes.include.glsl"
 
+// snorm 4x16, still needs the dequantization of its mesh to end up in mesh space
 struct SVertexPosition
 {
-    SPackedVec3 Position;
+    uint PositionXY;
+    uint PositionZW;
 };
 
+vec3 DecodePosition(in SVertexPosition vertexPosition)
+{
+    return vec3(unpackSnorm2x16(vertexPosition.PositionXY), unpackSnorm2x16(vertexPosition.PositionZW).x);
+}
+
 struct SVertexNormalUvTangent
 {
     uint Normal;
     uint Tangent;
-    SPackedVec3 UvAndTangentSign;
+    uint Uv;
 };
 
 #endif // VERTEXTYPES_INCLUDE_GLSL
\ No newline at end of file
@@ -43,6 +43,14 @@ auto main(
             .WindowStyle = TWindowStyle::Windowed,
             .IsDebug = true,
             .IsVSyncEnabled = true,
+            .LodBias = 0.0f,
+            .AssetMemoryBudgetInBytes = 512 * 1024 * 1024,
+            .Streaming = {
+                .CellSize = 64.0f,
+                .LoadDistance = 256.0f,
+                .UnloadDistance = 320.0f,
+                .BudgetInMilliseconds = 4.0f,
+            },
         },
         //.Renderer = myRenderer.release(),
     });
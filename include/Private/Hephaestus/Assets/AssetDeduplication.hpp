@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Hephaestus/Assets/Assets.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// hashes and compares only the payload, names and material references are not part of a mesh's or an image's content
+auto HashAssetMeshContent(const TAssetMesh& assetMesh) -> uint64_t;
+auto HashAssetImageContent(const TAssetImage& assetImage) -> uint64_t;
+auto IsSameAssetMeshContent(const TAssetMesh& assetMesh,
+                            const TAssetMesh& otherAssetMesh) -> bool;
+auto IsSameAssetImageContent(const TAssetImage& assetImage,
+                             const TAssetImage& otherAssetImage) -> bool;
+auto GetAssetMeshContentSize(const TAssetMesh& assetMesh) -> std::size_t;
+auto GetAssetImageContentSize(const TAssetImage& assetImage) -> std::size_t;
\ No newline at end of file
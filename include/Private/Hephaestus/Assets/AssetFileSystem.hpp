@@ -0,0 +1,14 @@
+#pragma once
+
+#include <Hephaestus/Assets/AssetArchive.hpp>
+#include <Hephaestus/Assets/MappedFile.hpp>
+
+#include <cstddef>
+#include <optional>
+
+// looks the file up in the mounted archives only, the bytes point straight into the archive mapping
+// and stay valid for as long as the application runs
+auto FindArchivedAssetFile(const std::filesystem::path& filePath) -> std::optional<std::span<const std::byte>>;
+auto HasAssetFile(const std::filesystem::path& filePath) -> bool;
+// an archived file is a view into the mapping of its archive, anything else is mapped from disk
+auto MapAssetFile(const std::filesystem::path& filePath) -> std::expected<std::shared_ptr<const TMappedFile>, std::string>;
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Hephaestus/Assets/Assets.hpp>
+#include <Hephaestus/Assets/VertexQuantization.hpp>
+#include <Hephaestus/RHI/VertexTypes.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// owns the vertex and index data of an imported primitive while the import stages work on it
+struct TAssetMeshData {
+    // mesh space, the stages need float positions, float positions with a quantization are quantized into
+    // QuantizedVertexPositions once all of them ran, float positions without one stay here
+    std::vector<glm::vec3> VertexPositions;
+    // integer positions of KHR_mesh_quantization are read into these as they are, by the size of their components,
+    // the stages remap them along with the float copy
+    std::vector<TGpuVertexPosition> QuantizedVertexPositions;
+    std::vector<TGpuVertexPositionSnorm8> QuantizedByteVertexPositions;
+    TVertexPositionFormat VertexPositionFormat = TVertexPositionFormat::Float32x3;
+    std::optional<TPositionQuantization> PositionQuantization;
+    std::vector<TGpuVertexNormalUvTangent> VertexNormalUvTangents;
+    std::vector<uint32_t> Indices;
+    std::vector<uint16_t> ShortIndices;
+    std::vector<TAssetMeshLod> Lods;
+    std::vector<TGpuMeshlet> Meshlets;
+    std::vector<uint32_t> MeshletVertices;
+    std::vector<uint8_t> MeshletTriangles;
+};
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
+
+// names are hashed once when they are interned, everything after that is a plain vector index,
+// ids are handed out before the asset behind them is published, so entities can reference assets which are still loading
+//
+// payloads are content addressed, publishing one which equals an already published payload only adds a reference to it,
+// every id sharing a payload resolves to the same canonical id, the one which published it first
+template<class TId, class TAsset>
+class TAssetRegistry {
+public:
+    auto Intern(const std::string& name) -> TId {
+
+        if (auto id = _ids.find(name); id != _ids.end()) {
+            return id->second;
+        }
+
+        const auto id = TId(_names.size());
+        _ids.emplace(name, id);
+        _names.push_back(name);
+        _contentIndices.push_back(InvalidContentIndex);
+        return id;
+    }
+
+    // returns true when the payload was a duplicate and has been dropped in favour of the published one
+    template<class TIsSameContent>
+    auto Publish(const std::string& name,
+                 TAsset&& asset,
+                 uint64_t contentHash,
+                 TIsSameContent&& isSameContent) -> bool {
+
+        const auto id = Intern(name);
+        Release(id);
+
+        if (auto contentIndex = _contentIndicesByHash.find(contentHash); contentIndex != _contentIndicesByHash.end()) {
+            auto& content = _contents[contentIndex->second];
+            if (isSameContent(*content.Asset, asset)) {
+                content.ReferenceCount++;
+                _contentIndices[std::size_t(id)] = contentIndex->second;
+                return true;
+            }
+        }
+
+        // content slots are never reused, their canonical id stays unique for as long as the registry lives
+        const auto contentIndex = _contents.size();
+        _contents.push_back(TContent{
+            .Asset = std::move(asset),
+            .Hash = contentHash,
+            .CanonicalId = id,
+            .ReferenceCount = 1,
+        });
+        _contentIndicesByHash.insert_or_assign(contentHash, contentIndex);
+        _contentIndices[std::size_t(id)] = contentIndex;
+        return false;
+    }
+
+    // drops the payload once the last id referencing it is released
+    auto Release(TId id) -> void {
+
+        auto& contentIndex = _contentIndices[std::size_t(id)];
+        if (contentIndex == InvalidContentIndex) {
+            return;
+        }
+
+        auto& content = _contents[contentIndex];
+        const auto releasedContentIndex = contentIndex;
+        contentIndex = InvalidContentIndex;
+
+        if (--content.ReferenceCount == 0) {
+            if (auto hashedContentIndex = _contentIndicesByHash.find(content.Hash);
+                hashedContentIndex != _contentIndicesByHash.end() && hashedContentIndex->second == releasedContentIndex) {
+                _contentIndicesByHash.erase(hashedContentIndex);
+            }
+            content.Asset.reset();
+            return;
+        }
+
+        // the payload outlives the id which published it, hand it to one of the ids still referencing it,
+        // so the released id can publish a different payload under its own canonical id, releases are rare enough to scan
+        if (content.CanonicalId == id) {
+            const auto referencingIndex = std::ranges::find(_contentIndices, releasedContentIndex) - _contentIndices.begin();
+            content.CanonicalId = TId(referencingIndex);
+        }
+    }
+
+    [[nodiscard]] auto Contains(TId id) const -> bool {
+
+        return std::size_t(id) < _contentIndices.size() && _contentIndices[std::size_t(id)] != InvalidContentIndex;
+    }
+
+    [[nodiscard]] auto Contains(const std::string& name) const -> bool {
+
+        auto id = _ids.find(name);
+        return id != _ids.end() && Contains(id->second);
+    }
+
+    auto Get(TId id) -> TAsset& {
+
+        assert(Contains(id));
+        return *_contents[_contentIndices[std::size_t(id)]].Asset;
+    }
+
+    [[nodiscard]] auto GetCanonicalId(TId id) const -> TId {
+
+        assert(Contains(id));
+        return _contents[_contentIndices[std::size_t(id)]].CanonicalId;
+    }
+
+    [[nodiscard]] auto GetContentHash(TId id) const -> uint64_t {
+
+        assert(Contains(id));
+        return _contents[_contentIndices[std::size_t(id)]].Hash;
+    }
+
+    [[nodiscard]] auto GetReferenceCount(TId id) const -> uint32_t {
+
+        return Contains(id)
+            ? _contents[_contentIndices[std::size_t(id)]].ReferenceCount
+            : 0;
+    }
+
+    [[nodiscard]] auto GetName(TId id) const -> const std::string& {
+
+        assert(std::size_t(id) < _names.size());
+        return _names[std::size_t(id)];
+    }
+
+    // content indices identify a payload for as long as it lives, independent of which ids reference it
+    [[nodiscard]] auto GetContentIndex(TId id) const -> std::optional<std::size_t> {
+
+        return Contains(id)
+            ? std::optional(_contentIndices[std::size_t(id)])
+            : std::nullopt;
+    }
+
+    [[nodiscard]] auto FindContentIndex(uint64_t contentHash) const -> std::optional<std::size_t> {
+
+        auto contentIndex = _contentIndicesByHash.find(contentHash);
+        return contentIndex != _contentIndicesByHash.end()
+            ? std::optional(contentIndex->second)
+            : std::nullopt;
+    }
+
+    [[nodiscard]] auto HasContent(std::size_t contentIndex) const -> bool {
+
+        return contentIndex < _contents.size() && _contents[contentIndex].Asset.has_value();
+    }
+
+    auto GetContent(std::size_t contentIndex) -> TAsset& {
+
+        assert(HasContent(contentIndex));
+        return *_contents[contentIndex].Asset;
+    }
+
+private:
+    static constexpr auto InvalidContentIndex = SIZE_MAX;
+
+    struct TContent {
+        std::optional<TAsset> Asset;
+        uint64_t Hash;
+        TId CanonicalId;
+        uint32_t ReferenceCount;
+    };
+
+    phmap::flat_hash_map<std::string, TId> _ids;
+    std::vector<std::string> _names;
+    std::vector<std::size_t> _contentIndices;
+    std::vector<TContent> _contents;
+    phmap::flat_hash_map<uint64_t, std::size_t> _contentIndicesByHash;
+};
\ No newline at end of file
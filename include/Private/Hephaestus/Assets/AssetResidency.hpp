@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Hephaestus/Assets/Assets.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <parallel_hashmap/phmap.h>
+
+enum class TAssetResidencyKind : uint32_t {
+    Mesh,
+    Image
+};
+
+struct TAssetResidencyKey {
+    TAssetResidencyKind Kind;
+    // of the payload in its registry, see TAssetRegistry::GetContentIndex
+    std::size_t ContentIndex;
+};
+
+// where an evicted payload is read back from, the asset which published it and the settings it was imported with
+struct TAssetResidencySource {
+    std::string AssetName;
+    TAssetImportSettings ImportSettings;
+};
+
+// tracks the CPU bytes of published mesh and image payloads, a payload is pinned until the renderer has uploaded it,
+// afterwards it may be evicted, least recently used first, whenever the resident bytes exceed the budget,
+// a payload whose GPU copy the renderer dropped again is evicted right away
+class TAssetResidency {
+public:
+    auto Track(const TAssetResidencyKey& key,
+               std::size_t sizeInBytes,
+               TAssetResidencySource&& source) -> void;
+    auto Untrack(const TAssetResidencyKey& key) -> void;
+
+    auto MarkUploaded(const TAssetResidencyKey& key) -> void;
+    auto MarkUnloaded(const TAssetResidencyKey& key) -> void;
+    auto MarkReloaded(const TAssetResidencyKey& key,
+                      std::size_t sizeInBytes) -> void;
+    auto Touch(const TAssetResidencyKey& key) -> void;
+
+    [[nodiscard]] auto IsEvicted(const TAssetResidencyKey& key) const -> bool;
+    [[nodiscard]] auto GetSource(const TAssetResidencyKey& key) const -> const TAssetResidencySource&;
+
+    // a budget of 0 evicts unloaded payloads only
+    auto SetBudget(std::size_t budgetInBytes) -> void;
+    // marks unloaded payloads and then payloads as evicted until the resident bytes fit the budget, the caller drops their bytes
+    [[nodiscard]] auto CollectEvictions() -> std::vector<TAssetResidencyKey>;
+    [[nodiscard]] auto GetStatistics() const -> const TAssetMemoryStatistics&;
+
+private:
+    struct TEntry {
+        std::size_t SizeInBytes;
+        TAssetResidencySource Source;
+        bool IsUploaded;
+        bool IsEvicted;
+        // uploaded once, but without a GPU copy now, until it is evicted or used again
+        bool IsUnloaded;
+        // only uploaded and resident payloads are in the list, unloaded ones at the front
+        std::list<uint64_t>::iterator LeastRecentlyUsedPosition;
+    };
+
+    static auto GetEntryKey(const TAssetResidencyKey& key) -> uint64_t;
+
+    phmap::flat_hash_map<uint64_t, TEntry> _entries;
+    // front is the least recently used payload
+    std::list<uint64_t> _leastRecentlyUsed;
+    TAssetMemoryStatistics _statistics = {};
+};
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+auto HashBytes(std::span<const std::byte> bytes) -> uint64_t;
+auto HashCombine(uint64_t hash,
+                 uint64_t value) -> uint64_t;
+auto HashFile(const std::filesystem::path& filePath) -> std::optional<uint64_t>;
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+// watches the directory of every file instead of the file itself, editors and exporters tend to replace files
+// by renaming a temporary one over them, which would end a watch on the file, inotify only, a no-op elsewhere
+auto WatchFile(const std::filesystem::path& filePath) -> void;
+// non blocking, every changed file is reported once no matter how many events it produced since the last call
+auto PollChangedFiles() -> std::vector<std::filesystem::path>;
+// drops every watch and closes the inotify descriptor
+auto StopWatchingFiles() -> void;
\ No newline at end of file
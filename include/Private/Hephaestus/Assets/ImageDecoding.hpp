@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Hephaestus/Assets/Assets.hpp>
+
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string>
+
+// decides the format an image ends up in, color images are sRGB, everything else is linear
+enum class TAssetImageUsage {
+    Color,
+    Normal,
+};
+
+// decodes KTX2 images, transcoding BasisU to BC7/BC5/BC4, and everything else stb_image understands to RGBA8
+// with a full mip chain
+auto DecodeImage(std::span<const std::byte> imageBytes,
+                 TAssetImageUsage imageUsage,
+                 TAssetImage& assetImage) -> std::expected<void, std::string>;
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+
+class TMappedFile {
+public:
+    TMappedFile() = default;
+    TMappedFile(const TMappedFile&) = delete;
+    auto operator=(const TMappedFile&) -> TMappedFile& = delete;
+    ~TMappedFile();
+
+    std::span<const std::byte> Bytes;
+
+private:
+    friend auto MapFile(const std::filesystem::path& filePath) -> std::expected<std::shared_ptr<const TMappedFile>, std::string>;
+    friend auto ViewMappedFile(std::shared_ptr<const TMappedFile> mappedFile,
+                               std::span<const std::byte> bytes) -> std::shared_ptr<const TMappedFile>;
+
+    void* _mapping = nullptr;
+    void* _fileHandle = nullptr;
+    // set for views, which keep the mapping they point into alive instead of owning one
+    std::shared_ptr<const TMappedFile> _viewedMappedFile;
+};
+
+auto MapFile(const std::filesystem::path& filePath) -> std::expected<std::shared_ptr<const TMappedFile>, std::string>;
+// bytes must lie within the mapped file
+auto ViewMappedFile(std::shared_ptr<const TMappedFile> mappedFile,
+                    std::span<const std::byte> bytes) -> std::shared_ptr<const TMappedFile>;
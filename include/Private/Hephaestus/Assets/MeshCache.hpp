@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Hephaestus/Assets/Assets.hpp>
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct TCookedAsset {
+    std::vector<TAssetMesh> Meshes;
+    // hashes of the glTF data each mesh was cooked from, aligned with Meshes, a hot reload compares against them
+    std::vector<uint64_t> MeshSourceHashes;
+    std::vector<std::pair<std::string, TAssetMaterial>> Materials;
+    std::vector<TAssetMeshInstance> MeshInstances;
+};
+
+auto GetMeshCacheFilePath(const std::filesystem::path& sourceFilePath,
+                          uint64_t sourceHash) -> std::filesystem::path;
+
+// every entry cooked from the source, whatever hash it was cooked from
+auto RemoveMeshCacheEntries(const std::filesystem::path& sourceFilePath) -> void;
+
+auto ReadMeshCache(const std::filesystem::path& cacheFilePath,
+                   uint64_t sourceHash) -> std::expected<TCookedAsset, std::string>;
+
+auto WriteMeshCache(const std::filesystem::path& cacheFilePath,
+                    uint64_t sourceHash,
+                    std::span<const TAssetMesh> assetMeshes,
+                    std::span<const uint64_t> meshSourceHashes,
+                    std::span<const std::pair<std::string, TAssetMaterial>> assetMaterials,
+                    std::span<const TAssetMeshInstance> assetMeshInstances) -> std::expected<void, std::string>;
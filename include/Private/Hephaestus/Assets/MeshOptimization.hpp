@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Hephaestus/Assets/AssetMeshData.hpp>
+
+struct TMeshOptimizationStatistics {
+    std::size_t VertexCountBefore;
+    std::size_t VertexCountAfter;
+    std::size_t TriangleCount;
+    // average cache miss ratio, transformed vertices per triangle
+    float AcmrBefore;
+    float AcmrAfter;
+    // average transformed vertex ratio, transformed vertices per vertex
+    float AtvrBefore;
+    float AtvrAfter;
+};
+
+auto OptimizeMesh(TAssetMeshData& assetMeshData) -> TMeshOptimizationStatistics;
+// appends simplified index ranges to the indices, one per level of detail
+auto BuildLods(TAssetMeshData& assetMeshData,
+               bool generateLods) -> void;
+// splits every level of detail into meshlets and rewrites its indices in meshlet order
+auto BuildMeshlets(TAssetMeshData& assetMeshData) -> void;
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string>
+
+#include <fastgltf/types.hpp>
+
+// decodes one EXT_meshopt_compression buffer view, vertex attributes, triangle lists and index sequences,
+// with its octahedral, quaternion or exponential filter applied, bufferBytes are those of the buffer it is compressed into
+auto DecodeMeshoptBufferView(std::span<const std::byte> bufferBytes,
+                             const fastgltf::CompressedBufferView& compressedBufferView) -> std::expected<fastgltf::sources::Vector, std::string>;
\ No newline at end of file
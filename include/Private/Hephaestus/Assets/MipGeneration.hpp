@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Hephaestus/Assets/Assets.hpp>
+
+#include <expected>
+#include <string>
+
+// completes the mip chain of an R8G8B8A8 image below its first level with a 2x2 box filter, down to 1x1,
+// sRGB images are filtered in linear space, alpha is always linear
+auto GenerateMipChain(TAssetImage& assetImage) -> std::expected<void, std::string>;
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Hephaestus/VectorMath.hpp>
+
+#include <cstdint>
+
+#include <glm/ext/vector_int4_sized.hpp>
+
+/*
+ * Encodings used by TGpuVertexPosition and TGpuVertexNormalUvTangent, see VertexTypes.include.glsl for the matching decoders
+ *
+ * Position: snorm 4x16, or snorm 4x8 for byte positions of KHR_mesh_quantization, mesh space = Scale * position + Offset, w is unused
+ * Normal:  octahedral encoded unit vector, snorm 2x16
+ * Tangent: octahedral encoded unit vector, snorm 2x16, the lowest bit of .y carries the bitangent sign
+ * Uv:      half 2x16
+ */
+
+struct TPositionQuantization {
+    glm::vec3 Scale;
+    glm::vec3 Offset;
+};
+
+// spreads the bounds over the whole snorm range of every axis
+auto GetPositionQuantization(const glm::vec3& boundsMin,
+                             const glm::vec3& boundsMax) -> TPositionQuantization;
+auto GetPositionDequantizationMatrix(const TPositionQuantization& positionQuantization) -> glm::mat4;
+auto EncodePosition(const glm::vec3& position,
+                    const TPositionQuantization& positionQuantization) -> glm::i16vec4;
+auto DecodePosition(const glm::i16vec4& encodedPosition,
+                    const TPositionQuantization& positionQuantization) -> glm::vec3;
+auto EncodeNormal(const glm::vec3& normal) -> uint32_t;
+auto DecodeNormal(uint32_t encodedNormal) -> glm::vec3;
+auto EncodeTangent(const glm::vec4& tangent) -> uint32_t;
+auto DecodeTangent(uint32_t encodedTangent) -> glm::vec4;
+auto EncodeUv(const glm::vec2& uv) -> uint32_t;
+auto DecodeUv(uint32_t encodedUv) -> glm::vec2;
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <string>
+#include <Hephaestus/Assets/Assets.hpp>
 
 struct TGpuMaterialComponent {
-    std::string MaterialName;
+    TAssetMaterialId MaterialId;
 };
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <string>
+#include <Hephaestus/Assets/Assets.hpp>
 
 struct TGpuMeshComponent {
-    std::string MeshName;
+    TAssetMeshId MeshId;
 };
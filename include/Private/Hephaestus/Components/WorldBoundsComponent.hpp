@@ -0,0 +1,12 @@
+#pragma once
+
+#include <Hephaestus/VectorMath.hpp>
+
+// bounds of the mesh of an entity under its TTransformComponent, of all of its instances when it has any,
+// refreshed by the renderer every frame before the visibility pass
+struct TWorldBoundsComponent {
+    glm::vec3 BoxMin;
+    glm::vec3 BoxMax;
+    // xyz = center, w = radius
+    glm::vec4 Sphere;
+};
\ No newline at end of file
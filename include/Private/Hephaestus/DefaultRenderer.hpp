@@ -1,16 +1,23 @@
 #pragma once
 
 #include <Hephaestus/ApplicationSettings.hpp>
+#include <Hephaestus/Assets/Assets.hpp>
 #include <Hephaestus/Renderer.hpp>
 
 #include <Hephaestus/RHI/Pipelines.hpp>
 #include <Hephaestus/RHI/Framebuffer.hpp>
 
+#include <Hephaestus/FrustumCulling.hpp>
+#include <Hephaestus/GpuMegaBuffer.hpp>
 #include <Hephaestus/GpuMesh.hpp>
 #include <Hephaestus/GpuMaterial.hpp>
+#include <Hephaestus/RenderQueue.hpp>
 
+#include <cstdint>
 #include <memory>
 
+#include <entt/entt.hpp>
+
 class TDefaultRenderer : public TRenderer {
 public:
     TDefaultRenderer(const TApplicationSettings& applicationSettings,
@@ -28,15 +35,73 @@ private:
     auto DestroyFramebuffers() -> void;
     auto CreateFramebuffers(const glm::ivec2& framebufferSize) -> void;
     auto ResizeIfNecessary(const TRenderContext& renderContext) -> void;
+    auto EnsureClusterDrawBuffers(std::size_t clusterDrawCount,
+                                  std::size_t cullWorkItemCount,
+                                  std::size_t commandCount) -> void;
+
+    auto ApplyAssetReloads(entt::registry& registry) -> void;
+    auto ApplyAssetReleases(entt::registry& registry) -> void;
+    auto EnsureInstanceBuffer(std::size_t instanceCount) -> void;
+    auto DrawClusters(uint32_t drawCommandBuffer,
+                      uint32_t commandClusterDrawIndexBuffer,
+                      std::size_t drawCountOffset,
+                      std::size_t shortDrawCountOffset,
+                      std::size_t maxDrawCount,
+                      std::size_t maxShortDrawCount) -> void;
+    auto BuildDepthPyramid() -> void;
 
-    auto CreateGpuMesh(const std::string& meshName) -> void;
-    auto CreateGpuMaterial(const std::string& materialName) -> void;
+    auto CreateGpuMesh(TAssetMeshId assetMeshId) -> void;
+    auto CreateGpuMaterial(TAssetMaterialId assetMaterialId) -> void;
+    auto CreateGpuTexture(TAssetImageId assetImageId) -> uint64_t;
+    auto MarkGpuMaterialDirty(TAssetMaterialId assetMaterialId) -> void;
+    auto UploadDirtyGpuMaterials() -> void;
+    auto DeleteGpuMesh(TAssetMeshId assetMeshId) -> void;
+    auto DeleteGpuTexture(TAssetImageId assetImageId) -> void;
 
-    auto GetGpuMesh(const std::string& meshName) -> TGpuMesh&;
-    auto GetGpuMaterial(const std::string& materialName) -> TGpuMaterial&;
+    auto GetGpuMesh(TAssetMeshId assetMeshId) -> TGpuMesh&;
+    auto GetGpuMaterial(TAssetMaterialId assetMaterialId) -> TGpuMaterial&;
 
     TFramebuffer _geometryPassFramebuffer; //TODO(deccer) hide TFramebuffer, expose TFramebufferId instead
     TGraphicsPipelineId _geometryPassPipelineId = TGraphicsPipelineId::Invalid;
     TGraphicsPipelineId _fullscreenPassPipelineId = TGraphicsPipelineId::Invalid;
+    TComputePipelineId _cullClustersPipelineId = TComputePipelineId::Invalid;
+    TComputePipelineId _buildDepthPyramidPipelineId = TComputePipelineId::Invalid;
+    // farthest depth of the early geometry pass, read by the culling of the late phase and of the next frame's early phase
+    TTextureId _depthPyramidTexture = TTextureId::Invalid;
+    int32_t _depthPyramidLevelCount = 0;
     uint32_t _gpuConstantsBuffer = 0;
+    uint32_t _clusterDrawBuffer = 0;
+    std::size_t _clusterDrawCapacity = 0;
+    uint32_t _cullWorkItemBuffer = 0;
+    std::size_t _cullWorkItemCapacity = 0;
+    uint32_t _clusterDrawCommandBuffer = 0;
+    uint32_t _commandClusterDrawIndexBuffer = 0;
+    uint32_t _lateClusterDrawCommandBuffer = 0;
+    uint32_t _lateCommandClusterDrawIndexBuffer = 0;
+    uint32_t _rejectedMeshletBuffer = 0;
+    std::size_t _clusterDrawCommandCapacity = 0;
+    uint32_t _clusterDrawCountBuffer = 0;
+    uint32_t _instanceBuffer = 0;
+    std::size_t _instanceCapacity = 0;
+
+    // every created material, indexed by its id, only the range touched since the last frame is uploaded
+    uint32_t _gpuMaterialBuffer = 0;
+    std::size_t _gpuMaterialCapacity = 0;
+    std::size_t _dirtyGpuMaterialsBegin = SIZE_MAX;
+    std::size_t _dirtyGpuMaterialsEnd = 0;
+
+    // kept across frames so the visibility pass does not allocate
+    TFrustumCullingBounds _frustumCullingBounds;
+    std::vector<entt::entity> _frustumCullingEntities;
+    std::vector<uint8_t> _frustumCullingVisibility;
+    TRenderQueue _renderQueue;
+
+    // vertex attributes, positions are in their own buffer since snorm and float positions differ in size
+    TGpuMegaBuffer _vertexMegaBuffer;
+    // words, read by the vertex shader through the cluster draw of the mesh
+    TGpuMegaBuffer _positionMegaBuffer;
+    // one per index type, a multi draw has a single index type, meshes with 16 bit indices are drawn by a second call
+    TGpuMegaBuffer _indexMegaBuffer;
+    TGpuMegaBuffer _shortIndexMegaBuffer;
+    TGpuMegaBuffer _meshletMegaBuffer;
 };
\ No newline at end of file
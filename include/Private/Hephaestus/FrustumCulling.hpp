@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Hephaestus/VectorMath.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// world bounds in structure of arrays layout, so the visibility pass tests several of them per instruction,
+// every bounds is a sphere for the cheap test and a box for the tight one
+struct TFrustumCullingBounds {
+    std::vector<float> SphereCenterX;
+    std::vector<float> SphereCenterY;
+    std::vector<float> SphereCenterZ;
+    std::vector<float> SphereRadius;
+    std::vector<float> BoxCenterX;
+    std::vector<float> BoxCenterY;
+    std::vector<float> BoxCenterZ;
+    std::vector<float> BoxExtentX;
+    std::vector<float> BoxExtentY;
+    std::vector<float> BoxExtentZ;
+
+    auto Clear() -> void;
+    auto Add(const glm::vec4& sphere,
+             const glm::vec3& boxMin,
+             const glm::vec3& boxMax) -> void;
+    [[nodiscard]] auto GetCount() const -> std::size_t;
+};
+
+struct TFrustumCullingView {
+    // normalized, pointing inwards, as extracted from the view projection matrix
+    glm::vec4 FrustumPlanes[6];
+    glm::vec3 CameraPosition;
+    // pixels per world unit at a distance of one
+    float ProjectionScale;
+    // bounds whose projected radius stays below this many pixels do not contribute to the image, 0 keeps them all
+    float MinimumProjectedRadius;
+};
+
+// writes 1 into visibility for every bounds which intersects the frustum and is large enough on screen, 0 otherwise,
+// visibility has to hold one entry per bounds, large batches are split across cores
+auto CullFrustum(const TFrustumCullingView& view,
+                 const TFrustumCullingBounds& bounds,
+                 std::span<uint8_t> visibility) -> void;
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+// immutable GL buffers which many meshes are sub-allocated from, so that a single draw can reach all of them,
+// every stream shares the element offsets, positions and attributes of a vertex sit at the same index in their streams
+//
+// ranges are handed out first fit, freed ranges merge with their neighbours, a full buffer is reallocated
+// with twice the capacity and its content copied over, buffer names change then, bind them every frame
+class TGpuMegaBuffer {
+public:
+    auto AddStream(const std::string& label,
+                   uint32_t elementSize) -> void;
+    auto Delete() -> void;
+
+    auto Allocate(uint32_t elementCount) -> uint32_t;
+    auto Free(uint32_t elementOffset,
+              uint32_t elementCount) -> void;
+    auto Upload(std::size_t streamIndex,
+                uint32_t elementOffset,
+                std::span<const std::byte> bytes) -> void;
+
+    [[nodiscard]] auto GetBuffer(std::size_t streamIndex) const -> uint32_t;
+    [[nodiscard]] auto GetCapacity() const -> uint32_t;
+
+private:
+    struct TStream {
+        std::string Label;
+        uint32_t ElementSize;
+        uint32_t Buffer;
+    };
+
+    auto Grow(uint32_t minimumCapacity) -> void;
+
+    std::vector<TStream> _streams;
+    // element offset to element count
+    std::map<uint32_t, uint32_t> _freeRanges;
+    uint32_t _capacity = 0;
+};
\ No newline at end of file
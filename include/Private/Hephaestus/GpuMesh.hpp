@@ -1,17 +1,41 @@
 #pragma once
 
 #include <Hephaestus/VectorMath.hpp>
+#include <Hephaestus/RHI/VertexTypes.hpp>
 
 #include <cstdint>
+#include <vector>
 
+struct TGpuMeshLod {
+    uint32_t MeshletOffset;
+    uint32_t MeshletCount;
+    // in mesh space units
+    float Error;
+};
+
+// ranges of the renderer's mega buffers, FirstIndex is into the index mega buffer of IndexElementType, indices are relative to BaseVertex
 struct TGpuMesh {
-    uint32_t VertexPositionBuffer;
-    uint32_t VertexNormalUvTangentBuffer;
-    uint32_t IndexBuffer;
+    uint32_t BaseVertex;
+    uint32_t FirstIndex;
+    uint32_t FirstMeshlet;
+    uint32_t FirstPositionWord;
 
     std::size_t VertexCount;
     std::size_t IndexCount;
+    std::size_t MeshletCount;
+    std::size_t PositionWordCount;
+
+    std::vector<TGpuMeshLod> Lods;
+    // in mesh space
+    glm::vec3 BoundingBoxMin;
+    glm::vec3 BoundingBoxMax;
+    // xyz = center, w = radius, in mesh space
+    glm::vec4 BoundingSphere;
 
     glm::mat4 InitialTransform;
+    // stored vertex positions to mesh space, identity for float positions
+    glm::mat4 PositionDequantization;
+    TVertexPositionFormat VertexPositionFormat;
+    TIndexElementType IndexElementType;
 };
 
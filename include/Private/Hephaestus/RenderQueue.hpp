@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// a 64 bit key per draw, most significant first: pass (2 bits), pipeline (6), material (20), mesh (20),
+// view depth (16), draws sorted by it switch state as rarely as possible and go front to back within the same state
+auto MakeDrawSortKey(uint32_t pass,
+                     uint32_t pipeline,
+                     uint32_t material,
+                     uint32_t mesh,
+                     float viewDepth) -> uint64_t;
+
+// collects the visible draws of a frame, sorts them by their keys with an LSD radix sort and hands out
+// the indices of the draws in sorted order, storage is kept across frames
+class TRenderQueue {
+public:
+    auto Clear() -> void;
+    auto Add(uint64_t sortKey,
+             uint32_t drawIndex) -> void;
+    auto Sort() -> void;
+
+    [[nodiscard]] auto GetDrawIndices() const -> std::span<const uint32_t>;
+
+private:
+    std::vector<uint64_t> _sortKeys;
+    std::vector<uint32_t> _drawIndices;
+    std::vector<uint64_t> _scratchSortKeys;
+    std::vector<uint32_t> _scratchDrawIndices;
+};
\ No newline at end of file
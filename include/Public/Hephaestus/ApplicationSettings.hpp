@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -14,6 +15,17 @@ enum class TResolutionStartup {
     UseApplicationSettings
 };
 
+struct TSceneStreamingSettings {
+    // world cells are squares of this size on the xz plane, 0 disables streaming, entities are created right away then
+    float CellSize;
+    // cells closer to the viewer than the load distance are loaded, cells farther away than the unload distance are unloaded,
+    // the gap keeps cells on the border from flipping every frame
+    float LoadDistance;
+    float UnloadDistance;
+    // main thread time per frame for creating streamed entities and their GPU resources, 0 does not limit it
+    float BudgetInMilliseconds;
+};
+
 struct TApplicationSettings {
     int32_t ResolutionWidth;
     int32_t ResolutionHeight;
@@ -22,5 +34,10 @@ struct TApplicationSettings {
     TWindowStyle WindowStyle;
     bool IsDebug;
     bool IsVSyncEnabled;
+    // scales the screen space error a level of detail may have, positive values pick coarser levels earlier
+    float LodBias;
+    // CPU copies of uploaded meshes and images above this are evicted, 0 keeps all of them, see SetAssetMemoryBudget
+    std::size_t AssetMemoryBudgetInBytes;
+    TSceneStreamingSettings Streaming;
     std::string Title;
 };
\ No newline at end of file
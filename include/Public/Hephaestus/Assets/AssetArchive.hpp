@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+
+enum class TAssetArchiveCompression : uint32_t {
+    None,
+};
+
+struct TAssetArchiveSourceFile {
+    // the path the asset loader asks for, see GetAssetFileName
+    std::string Name;
+    std::filesystem::path FilePath;
+};
+
+// packs the files into a single archive, payloads are stored uncompressed and aligned to the page size
+auto WriteAssetArchive(const std::filesystem::path& archiveFilePath,
+                       std::span<const TAssetArchiveSourceFile> sourceFiles) -> std::expected<void, std::string>;
+// files in mounted archives shadow loose files of the same name, archives mounted later shadow earlier ones,
+// main thread only and before anything is scanned, lookups from the import threads are not synchronized with it
+auto MountAssetArchive(const std::filesystem::path& archiveFilePath) -> std::expected<void, std::string>;
+// lexically normal and with forward slashes, the key both the archive and the asset loader use for a path
+auto GetAssetFileName(const std::filesystem::path& filePath) -> std::string;
\ No newline at end of file
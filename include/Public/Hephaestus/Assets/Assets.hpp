@@ -1,10 +1,20 @@
 #pragma once
 
+#include <Hephaestus/Id.hpp>
 #include <Hephaestus/VectorMath.hpp>
+#include <Hephaestus/RHI/Format.hpp>
 
+#include <cstdint>
+#include <cstdlib>
 #include <expected>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 struct TScannedAsset {
     std::string Name;
@@ -23,20 +33,107 @@ struct TScannedAsset {
     std::vector<std::string> Skins;
 };
 
+using TAssetMeshId = SId<struct TTagAssetMeshId>;
+using TAssetMaterialId = SId<struct TTagAssetMaterialId>;
+using TAssetImageId = SId<struct TTagAssetImageId>;
+
 struct TGpuVertexPosition;
 struct TGpuVertexNormalUvTangent;
+struct TGpuMeshlet;
+enum class TIndexElementType : uint32_t;
+enum class TVertexPositionFormat : uint32_t;
+
+// one level of detail, all levels of a mesh share its vertex streams
+struct TAssetMeshLod {
+    uint32_t IndexOffset;
+    uint32_t IndexCount;
+    uint32_t MeshletOffset;
+    uint32_t MeshletCount;
+    // simplification error in mesh space units, 0 for the full detail level
+    float Error;
+};
 
 struct TAssetMesh {
-    std::string_view Name;
+    std::string Name;
     glm::mat4 InitialTransform;
-    std::vector<TGpuVertexPosition> VertexPositions;
-    std::vector<TGpuVertexNormalUvTangent> VertexNormalUvTangents;
-    std::vector<uint32_t> Indices;
+    // maps the vertex positions to mesh space, folded into the world matrix of the vertex shader, identity for float positions
+    glm::mat4 PositionDequantization;
+    std::span<const std::byte> VertexPositions;
+    TVertexPositionFormat VertexPositionFormat;
+    std::span<const TGpuVertexNormalUvTangent> VertexNormalUvTangents;
+    // ordered from full detail to coarsest
+    std::span<const TAssetMeshLod> Lods;
+    std::span<const TGpuMeshlet> Meshlets;
+    std::span<const uint32_t> MeshletVertices;
+    std::span<const uint8_t> MeshletTriangles;
+    std::span<const std::byte> Indices;
+    TIndexElementType IndexElementType;
     std::string MaterialName;
+    // keeps the memory behind the streams alive, either the imported vertex data or a mapped mesh cache file
+    std::shared_ptr<const void> Storage;
 };
 
 struct TAssetMaterial {
     glm::vec4 BaseColor;
+    std::optional<std::string> BaseColorImageName;
+    std::optional<std::string> NormalImageName;
+};
+
+struct TAssetImageLevel {
+    int32_t Width;
+    int32_t Height;
+    // into TAssetImage::Pixels
+    std::size_t Offset;
+    std::size_t Size;
+};
+
+struct TAssetImage {
+    std::string Name;
+    int32_t Width;
+    int32_t Height;
+    int32_t Components;
+    // block compressed when the source was a KTX2 image
+    TFormat Format;
+    // mip levels present in Pixels, missing levels are generated on upload
+    std::vector<TAssetImageLevel> Levels;
+    std::unique_ptr<std::byte[], decltype([](std::byte* pixels) { free(pixels); })> Pixels;
+};
+
+struct TAssetMeshInstance {
+    std::string MeshName;
+    std::string MaterialName;
+    glm::mat4 WorldMatrix;
+    // EXT_mesh_gpu_instancing transforms relative to WorldMatrix, empty for nodes without instancing
+    std::vector<glm::mat4> InstanceMatrices;
+};
+
+// payloads which were dropped because an equal one had been published before, across all assets
+struct TAssetDeduplicationReport {
+    std::size_t DeduplicatedMeshCount;
+    std::size_t DeduplicatedImageCount;
+    std::size_t DeduplicatedMaterialCount;
+    std::size_t SavedMeshBytes;
+    std::size_t SavedImageBytes;
+};
+
+// CPU copies of mesh and image payloads, resident is what is held right now, evicted and reloaded accumulate
+struct TAssetMemoryStatistics {
+    std::size_t BudgetBytes;
+    std::size_t ResidentBytes;
+    std::size_t EvictedBytes;
+    std::size_t ReloadedBytes;
+};
+
+struct TAssetImportSettings {
+    // reorders and deduplicates vertices and indices for post-transform cache, overdraw and vertex fetch
+    bool OptimizeMeshes = true;
+    // simplifies every mesh into a chain of coarser levels of detail
+    bool GenerateLods = true;
+    // spreads float positions over the bounds of their mesh as snorm 16 bit, lossy, halves the position stream,
+    // integer positions of KHR_mesh_quantization keep their own grid either way, shorts as snorm 16 bit, bytes as snorm 8 bit
+    bool QuantizePositions = false;
+
+    bool operator==(const TAssetImportSettings&) const noexcept = default;
 };
 
 auto GetSafeResourceName(
@@ -46,5 +143,77 @@ auto GetSafeResourceName(
     std::size_t resourceIndex) -> std::string;
 auto ScanAsset(const std::string& baseName,
                const std::filesystem::path& assetFilePath) -> std::expected<TScannedAsset, std::string>;
-auto GetAssetMesh(const std::string& assetMeshName) -> TAssetMesh&;
-auto GetAssetMaterial(const std::string& assetMaterialName) -> TAssetMaterial&;
\ No newline at end of file
+auto CreateAssetMesh(const std::string& assetName,
+                     const TAssetImportSettings& importSettings) -> bool;
+// create single resources of a scanned asset by their index in TScannedAsset, together with the materials and
+// images they reference, from the glTF parsed by ScanAsset, only the buffers and images they read are mapped, main thread only
+auto CreateAssetImage(const std::string& assetName,
+                      std::size_t imageIndex) -> bool;
+auto CreateAssetMaterial(const std::string& assetName,
+                         std::size_t materialIndex) -> bool;
+auto CreateAssetMesh(const std::string& assetName,
+                     std::size_t meshIndex,
+                     const TAssetImportSettings& importSettings) -> bool;
+// imports on a worker thread and publishes the asset on the main thread, see DrainMainThreadQueue,
+// onLoaded runs on the main thread right after publishing, the future reports whether the import succeeded
+auto LoadAssetAsync(const std::string& assetName,
+                    const TAssetImportSettings& importSettings,
+                    std::function<void()> onLoaded) -> std::shared_future<bool>;
+// the mesh instances of the default scene of a scanned asset, read from the glTF parsed by ScanAsset,
+// only the buffers of EXT_mesh_gpu_instancing are mapped, nothing is imported, main thread only
+auto LoadAssetMeshInstances(const std::string& assetName) -> std::expected<std::vector<TAssetMeshInstance>, std::string>;
+// imports the named meshes of a scanned asset on a worker thread, together with the materials and images they reference,
+// and publishes them on the main thread, resources which are published or being imported already are left out,
+// the future reports whether the import succeeded, main thread only
+auto LoadAssetMeshesAsync(const std::string& assetName,
+                          std::span<const std::string> assetMeshNames,
+                          const TAssetImportSettings& importSettings) -> std::shared_future<bool>;
+auto WaitForAssetLoads() -> void;
+// threads the images, materials and primitives of an import fan out over, 0 uses every core, waits for running loads
+auto SetAssetThreadCount(std::size_t threadCount) -> void;
+// re-imports scanned assets whose files changed on disk, with the settings of their last import, main thread only, once per frame
+auto PollAssetFileChanges() -> void;
+// ids whose payload a reload replaced since the last call, the renderer swaps their GPU resources
+auto TakeReloadedAssetMeshIds() -> std::vector<TAssetMeshId>;
+auto TakeReloadedAssetMaterialIds() -> std::vector<TAssetMaterialId>;
+auto TakeReloadedAssetImageIds() -> std::vector<TAssetImageId>;
+// nothing of the scene references the id anymore, the payload stays published, the renderer drops the GPU resources
+// no entity uses and the CPU copies behind them go with them, main thread only
+auto ReleaseAssetMesh(TAssetMeshId assetMeshId) -> void;
+auto ReleaseAssetMaterial(TAssetMaterialId assetMaterialId) -> void;
+// ids released since the last call, an id requested again through LoadAssetMeshesAsync before is left out
+auto TakeReleasedAssetMeshIds() -> std::vector<TAssetMeshId>;
+auto TakeReleasedAssetMaterialIds() -> std::vector<TAssetMaterialId>;
+// interns the name into a dense id, the asset behind it may not be published yet, main thread only
+auto GetAssetMeshId(const std::string& assetMeshName) -> TAssetMeshId;
+auto GetAssetMaterialId(const std::string& assetMaterialName) -> TAssetMaterialId;
+auto GetAssetImageId(const std::string& assetImageName) -> TAssetImageId;
+auto GetAssetMeshName(TAssetMeshId assetMeshId) -> const std::string&;
+auto GetAssetMaterialName(TAssetMaterialId assetMaterialId) -> const std::string&;
+auto GetAssetImageName(TAssetImageId assetImageId) -> const std::string&;
+// ids sharing a payload resolve to the id which published it first, GPU resources are created once per canonical id
+auto GetCanonicalAssetMeshId(TAssetMeshId assetMeshId) -> TAssetMeshId;
+auto GetCanonicalAssetMaterialId(TAssetMaterialId assetMaterialId) -> TAssetMaterialId;
+auto GetCanonicalAssetImageId(TAssetImageId assetImageId) -> TAssetImageId;
+auto GetAssetDeduplicationReport() -> const TAssetDeduplicationReport&;
+// uploaded payloads beyond the budget drop their CPU copy, least recently used first, a budget of 0 keeps every copy
+// the renderer still uses, main thread only
+auto SetAssetMemoryBudget(std::size_t budgetInBytes) -> void;
+auto GetAssetMemoryStatistics() -> const TAssetMemoryStatistics&;
+// the renderer holds a GPU copy of the payload now, its CPU copy may be evicted
+auto MarkAssetMeshUploaded(TAssetMeshId assetMeshId) -> void;
+auto MarkAssetImageUploaded(TAssetImageId assetImageId) -> void;
+// the renderer dropped the GPU copy of the payload again, its CPU copy is evicted right away, whatever the budget
+auto MarkAssetMeshUnloaded(TAssetMeshId assetMeshId) -> void;
+auto MarkAssetImageUnloaded(TAssetImageId assetImageId) -> void;
+// whether the payload is resident, without blocking, an evicted mesh is mapped back from the mesh cache right away,
+// anything else is read back from its source file on the load thread and resident on a later frame, main thread only
+auto MakeAssetMeshResident(TAssetMeshId assetMeshId) -> bool;
+auto MakeAssetImageResident(TAssetImageId assetImageId) -> bool;
+auto HasAssetMesh(TAssetMeshId assetMeshId) -> bool;
+auto HasAssetMaterial(TAssetMaterialId assetMaterialId) -> bool;
+auto HasAssetImage(TAssetImageId assetImageId) -> bool;
+auto GetAssetMesh(TAssetMeshId assetMeshId) -> TAssetMesh&;
+auto GetAssetMaterial(TAssetMaterialId assetMaterialId) -> TAssetMaterial&;
+auto GetAssetImage(TAssetImageId assetImageId) -> TAssetImage&;
+auto GetAssetMeshInstances(const std::string& assetName) -> std::vector<TAssetMeshInstance>&;
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Hephaestus/VectorMath.hpp>
+
+#include <vector>
+
+// EXT_mesh_gpu_instancing, every instance is drawn with the mesh of its entity, relative to TTransformComponent
+struct TInstancesComponent {
+    std::vector<glm::mat4> InstanceMatrices;
+};
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <string>
+#include <Hephaestus/Assets/Assets.hpp>
 
 struct TMaterialComponent {
-    std::string MaterialName;
+    TAssetMaterialId MaterialId;
 };
\ No newline at end of file
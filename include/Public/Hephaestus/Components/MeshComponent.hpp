@@ -1,7 +1,7 @@
 #pragma once
 
-#include <string>
+#include <Hephaestus/Assets/Assets.hpp>
 
 struct TMeshComponent {
-    std::string MeshName;
+    TAssetMeshId MeshId;
 };
\ No newline at end of file
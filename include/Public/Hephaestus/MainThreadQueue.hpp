@@ -0,0 +1,8 @@
+#pragma once
+
+#include <functional>
+
+// work which has to happen on the thread owning the GL context and the scene, like publishing loaded assets
+auto EnqueueOnMainThread(std::function<void()> task) -> void;
+// runs everything enqueued so far, called once per frame by TApplication::Run
+auto DrainMainThreadQueue() -> void;
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Hephaestus/RHI/Format.hpp>
+#include <Hephaestus/RHI/VertexTypes.hpp>
 #include <Hephaestus/VectorMath.hpp>
 #include <Hephaestus/Id.hpp>
 
@@ -69,6 +70,12 @@ public:
                                uint32_t texture,
                                uint32_t sampler) -> void;
 
+    // a single level for image loads and stores, the shader decides whether it reads or writes
+    auto BindTextureAsImage(int32_t bindingIndex,
+                            uint32_t texture,
+                            int32_t level,
+                            TFormat format) -> void;
+
     auto SetUniform(int32_t location,
                     float value) -> void;
 
@@ -121,12 +128,23 @@ public:
                     int32_t vertexCount) -> void;
 
     auto DrawElements(uint32_t indexBuffer,
-                      int32_t elementCount) -> void;
+                      int32_t elementCount,
+                      TIndexElementType indexElementType) -> void;
 
     auto DrawElementsInstanced(uint32_t indexBuffer,
                                int32_t elementCount,
+                               TIndexElementType indexElementType,
                                int32_t instanceCount) -> void;
 
+    // commandBuffer holds DrawElementsIndirectCommands, countBuffer the number of commands to execute
+    auto MultiDrawElementsIndirectCount(uint32_t indexBuffer,
+                                        TIndexElementType indexElementType,
+                                        uint32_t commandBuffer,
+                                        int64_t commandBufferOffset,
+                                        uint32_t countBuffer,
+                                        int64_t countBufferOffset,
+                                        int32_t maxDrawCount) -> void;
+
     std::optional<uint32_t> InputLayout;
     uint32_t PrimitiveTopology;
     bool IsPrimitiveRestartEnabled;
@@ -134,6 +152,13 @@ public:
 
 class TComputePipeline : public TPipeline {
 public:
+    auto Dispatch(uint32_t workGroupCountX,
+                  uint32_t workGroupCountY,
+                  uint32_t workGroupCountZ) -> void;
+
+    // the work group counts are three uints at commandBufferOffset, written by an earlier dispatch
+    auto DispatchIndirect(uint32_t commandBuffer,
+                          int64_t commandBufferOffset) -> void;
 private:
 };
 
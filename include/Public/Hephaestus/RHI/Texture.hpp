@@ -127,6 +127,8 @@ struct TUploadTextureDescriptor {
     TUploadFormat UploadFormat = TUploadFormat::Auto;
     TUploadType UploadType = TUploadType::Auto;
     const void* PixelData = nullptr;
+    // only read for block compressed formats
+    int32_t PixelDataSize = 0;
 };
 
 struct TTexture {
@@ -136,6 +138,8 @@ struct TTexture {
     TTextureType TextureType = {};
 };
 
+auto FormatToGL(TFormat format) -> uint32_t;
+auto IsFormatCompressed(TFormat format) -> bool;
 auto FormatToBaseTypeClass(TFormat format) -> TBaseTypeClass;
 auto FormatToUnderlyingOpenGLType(TFormat format) -> uint32_t;
 auto FormatToComponentCount(TFormat format) -> int32_t;
@@ -147,4 +151,5 @@ auto CreateTexture(const TCreateTextureDescriptor& createTextureDescriptor) -> T
 auto UploadTexture(const TTextureId& textureId,
                    const TUploadTextureDescriptor& updateTextureDescriptor) -> void;
 auto MakeTextureResident(const TTextureId& textureId) -> uint64_t;
+auto DeleteTexture(const TTextureId& textureId) -> void;
 auto GenerateMipmaps(const TTextureId& textureId) -> void;
\ No newline at end of file
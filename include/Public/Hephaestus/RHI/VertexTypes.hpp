@@ -2,14 +2,25 @@
 
 #include <Hephaestus/VectorMath.hpp>
 
+#include <cstdint>
+
+#include <glm/ext/vector_int4_sized.hpp>
+
+// matches SVertexPosition in VertexTypes.include.glsl, snorm 4x16, TAssetMesh::PositionDequantization maps it to mesh space
 struct TGpuVertexPosition {
-    glm::vec3 Position;
+    glm::i16vec4 Position;
+};
+
+// snorm 4x8, KHR_mesh_quantization byte positions are kept at their size
+struct TGpuVertexPositionSnorm8 {
+    glm::i8vec4 Position;
 };
 
+// matches SVertexNormalUvTangent in VertexTypes.include.glsl, encodings are described in VertexQuantization.hpp
 struct TGpuVertexNormalUvTangent {
-    glm::vec3 Normal;
-    glm::vec2 Uv;
-    glm::vec4 Tangent;
+    uint32_t Normal;
+    uint32_t Tangent;
+    uint32_t Uv;
 };
 
 struct TGpuVertexPositionNormalUvTangent {
@@ -17,4 +28,56 @@ struct TGpuVertexPositionNormalUvTangent {
     glm::vec3 Normal;
     glm::vec2 Uv;
     glm::vec4 Tangent;
-};
\ No newline at end of file
+};
+
+// matches GpuMeshlet in GpuMeshlet.include.glsl, bounds are in mesh space
+struct TGpuMeshlet {
+    // into TAssetMesh::MeshletVertices and TAssetMesh::MeshletTriangles
+    uint32_t VertexOffset;
+    uint32_t TriangleOffset;
+    uint32_t VertexCount;
+    uint32_t TriangleCount;
+    // indices are stored in meshlet order, every meshlet is one contiguous range of the index buffer
+    uint32_t IndexOffset;
+    uint32_t IndexCount;
+    uint32_t Reserved[2];
+    // xyz = center, w = radius
+    glm::vec4 BoundingSphere;
+    // xyz = axis, w = cutoff, the meshlet is backfacing when seen from within the cone
+    glm::vec4 ConeAxisCutoff;
+};
+
+enum class TIndexElementType : uint32_t {
+    UnsignedShort,
+    UnsignedInteger
+};
+
+constexpr auto GetIndexElementSize(TIndexElementType indexElementType) -> uint32_t {
+    return indexElementType == TIndexElementType::UnsignedShort
+        ? sizeof(uint16_t)
+        : sizeof(uint32_t);
+}
+
+// float positions are kept as they are unless the import asks to quantize them
+enum class TVertexPositionFormat : uint32_t {
+    // TGpuVertexPosition
+    Snorm16x4,
+    // glm::vec3 in mesh space
+    Float32x3,
+    // TGpuVertexPositionSnorm8
+    Snorm8x4
+};
+
+constexpr auto GetVertexPositionSize(TVertexPositionFormat vertexPositionFormat) -> uint32_t {
+    switch (vertexPositionFormat) {
+        case TVertexPositionFormat::Snorm16x4: return sizeof(TGpuVertexPosition);
+        case TVertexPositionFormat::Snorm8x4: return sizeof(TGpuVertexPositionSnorm8);
+        default: return sizeof(glm::vec3);
+    }
+}
+
+static_assert(sizeof(TGpuVertexPosition) == 8);
+static_assert(sizeof(TGpuVertexPositionSnorm8) == 4);
+static_assert(sizeof(glm::vec3) == 12);
+static_assert(sizeof(TGpuVertexNormalUvTangent) == 12);
+static_assert(sizeof(TGpuMeshlet) == 64);
\ No newline at end of file
@@ -3,12 +3,18 @@
 #include <Hephaestus/ApplicationSettings.hpp>
 #include <Hephaestus/ApplicationContext.hpp>
 
+#include <chrono>
+
 struct TScene;
 
 struct TRenderContext {
     float DeltaTime;
     bool IsSrgbDisabled;
     uint64_t FrameCounter;
+    // of the last rendered frame, the scene streams its cells around it
+    glm::vec3 ViewerPosition;
+    // streamed entities and GPU resources are created until then, whatever is left continues next frame
+    std::chrono::steady_clock::time_point StreamingDeadline;
 };
 
 class TRenderer {
@@ -1,11 +1,30 @@
 #pragma once
 
+#include <Hephaestus/ApplicationSettings.hpp>
 #include <Hephaestus/VectorMath.hpp>
+#include <Hephaestus/Assets/Assets.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <future>
 #include <optional>
+#include <span>
 #include <string>
+#include <vector>
 
 #include <entt/entt.hpp>
+#include <parallel_hashmap/phmap.h>
+
+struct TStreamedEntity {
+    // if it was registered with AddStreamedAsset, the mesh and material of the entity are imported when the first cell
+    // referencing them comes into range and released when the last one unloads, otherwise they are expected to be
+    // loaded by the scene itself, the entity is skipped when its mesh fails to import
+    std::string AssetName;
+    glm::mat4 InitialTransform;
+    std::string AssetMeshName;
+    std::string AssetMaterialName;
+    std::vector<glm::mat4> InstanceMatrices;
+};
 
 class TScene {
 public:
@@ -16,13 +35,69 @@ public:
 
     auto GetRegistry() -> entt::registry&;
 
+    auto SetStreamingSettings(const TSceneStreamingSettings& streamingSettings) -> void;
+    // loads cells coming into range and unloads the ones which left it, creates entities of loaded cells, nearest cell first,
+    // until the deadline has passed, main thread only, once per frame
+    auto Stream(const glm::vec3& viewerPosition,
+                std::chrono::steady_clock::time_point deadline) -> void;
+
 protected:
     auto AddEntity(std::optional<entt::entity> parent,
                    glm::mat4x4 initialTransform,
                    const std::string &assetMeshName,
-                   const std::string &assetMaterialName) -> entt::entity;
+                   const std::string &assetMaterialName,
+                   std::span<const glm::mat4> instanceMatrices = {}) -> entt::entity;
+    // the entity lives in the cell its translation falls into and exists only while that cell is loaded
+    auto AddStreamedEntity(TStreamedEntity&& streamedEntity) -> void;
+    auto AddStreamedAsset(const std::string& assetName,
+                          const TAssetImportSettings& importSettings) -> void;
 
 private:
+    enum class TSceneCellState {
+        Unloaded,
+        // waits for the imports of the assets its entities reference
+        Loading,
+        // creates its entities within the frame budget
+        Creating,
+        Loaded
+    };
+
+    struct TSceneCell {
+        glm::ivec2 Coordinate;
+        TSceneCellState State;
+        std::vector<TStreamedEntity> StreamedEntities;
+        std::vector<entt::entity> Entities;
+        // meshes and materials of streamed assets the cell holds a reference on, each once
+        std::vector<std::string> AssetMeshNames;
+        std::vector<std::string> AssetMaterialNames;
+        std::vector<std::shared_future<bool>> AssetLoads;
+    };
+
+    struct TStreamedAsset {
+        TAssetImportSettings ImportSettings;
+    };
+
+    // mesh names of the batch to import, by asset name
+    using TAssetMeshNamesToLoad = phmap::flat_hash_map<std::string, std::vector<std::string>>;
+
+    auto LoadCell(TSceneCell& cell) -> void;
+    auto UnloadCell(TSceneCell& cell) -> void;
+    // takes the references of the cell on the mesh and material of the entity, a mesh nothing imports yet joins the batch
+    auto AcquireStreamedEntityAssets(TSceneCell& cell,
+                                     const TStreamedEntity& streamedEntity,
+                                     TAssetMeshNamesToLoad& assetMeshNamesToLoad) -> void;
+    auto LoadStreamedAssetMeshes(TSceneCell& cell,
+                                 const TAssetMeshNamesToLoad& assetMeshNamesToLoad) -> void;
+
     entt::registry _registry;
+
+    TSceneStreamingSettings _streamingSettings = {};
+    phmap::flat_hash_map<uint64_t, TSceneCell> _cells;
+    phmap::flat_hash_map<std::string, TStreamedAsset> _streamedAssets;
+    // by mesh name, cells sharing a mesh wait on the same import
+    phmap::flat_hash_map<std::string, std::shared_future<bool>> _assetMeshLoads;
+    // how many loaded cells reference a mesh or material of a streamed asset, by name
+    phmap::flat_hash_map<std::string, uint32_t> _assetMeshReferenceCounts;
+    phmap::flat_hash_map<std::string, uint32_t> _assetMaterialReferenceCounts;
 };
 
@@ -1,4 +1,8 @@
 #include <Hephaestus/Application.hpp>
+#include <Hephaestus/MainThreadQueue.hpp>
+#include <Hephaestus/Assets/Assets.hpp>
+#include <Hephaestus/Assets/AssetArchive.hpp>
+#include <Hephaestus/Assets/FileWatcher.hpp>
 #include <Hephaestus/Input/Keyboard.hpp>
 #include <Hephaestus/Input/Mouse.hpp>
 
@@ -220,6 +224,7 @@ TApplication::TApplication(const TApplicationCreateInfo& applicationCreateInfo)
     } else {
         _scene.reset(applicationCreateInfo.Scene);
     }
+    _scene->SetStreamingSettings(_applicationSettings.Streaming);
 
     if (applicationCreateInfo.Renderer == nullptr) {
         _renderer = std::make_unique<TDefaultRenderer>(_applicationSettings, _applicationContext);
@@ -241,6 +246,7 @@ auto TApplication::Run() -> void {
     TRenderContext renderContext = {
         .IsSrgbDisabled = true,
         .FrameCounter = 0,
+        .ViewerPosition = glm::vec3(0.0f),
     };
 
     auto currentTimeInSeconds = glfwGetTime();
@@ -261,6 +267,15 @@ auto TApplication::Run() -> void {
             renderContext.IsSrgbDisabled = false;
         }
 
+        PollAssetFileChanges();
+        DrainMainThreadQueue();
+
+        renderContext.StreamingDeadline = _applicationSettings.Streaming.BudgetInMilliseconds > 0.0f
+            ? std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float, std::milli>(_applicationSettings.Streaming.BudgetInMilliseconds))
+            : std::chrono::steady_clock::time_point::max();
+        _scene->Stream(renderContext.ViewerPosition, renderContext.StreamingDeadline);
+
         _renderer->Render(renderContext, *_scene);
 
         {
@@ -421,6 +436,15 @@ auto TApplication::Load() -> bool {
         return false;
     }
 
+    SetAssetMemoryBudget(_applicationSettings.AssetMemoryBudgetInBytes);
+
+    // shipped builds pack their assets, development builds read loose files
+    if (std::filesystem::exists("data.pak")) {
+        if (auto mountResult = MountAssetArchive("data.pak"); !mountResult) {
+            spdlog::error(mountResult.error());
+        }
+    }
+
     if (!_scene->Load()) {
         return false;
     }
@@ -430,6 +454,11 @@ auto TApplication::Load() -> bool {
 
 auto TApplication::Unload() -> void {
 
+    // imports still running would publish into a torn down application
+    WaitForAssetLoads();
+    DrainMainThreadQueue();
+    StopWatchingFiles();
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext(_guiContext);
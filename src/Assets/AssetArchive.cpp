@@ -0,0 +1,303 @@
+#include <Hephaestus/Assets/AssetArchive.hpp>
+#include <Hephaestus/Assets/AssetFileSystem.hpp>
+#include <Hephaestus/Assets/ContentHash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+constexpr uint32_t AssetArchiveMagic = 0x4B415048; // "HPAK"
+constexpr uint32_t AssetArchiveFormatVersion = 1;
+// payloads start on page boundaries, so the mapping of an archive hands them out with the alignment of a mapped file
+constexpr uint64_t AssetArchivePayloadAlignment = 4096;
+
+/*
+ * File layout, all offsets are relative to the start of the file
+ *
+ * TAssetArchiveHeader
+ * TAssetArchiveEntry[EntryCount], sorted by NameHash
+ * char[NamesSize]
+ * payloads, each aligned to AssetArchivePayloadAlignment
+ */
+
+struct TAssetArchiveHeader {
+    uint32_t Magic;
+    uint32_t FormatVersion;
+    uint64_t EntryCount;
+    uint64_t EntriesOffset;
+    uint64_t NamesOffset;
+    uint64_t NamesSize;
+};
+
+struct TAssetArchiveEntry {
+    uint64_t NameHash;
+    uint64_t NameOffset;
+    uint64_t NameLength;
+    uint64_t Offset;
+    uint64_t Size;
+    uint64_t UncompressedSize;
+    TAssetArchiveCompression Compression;
+    uint32_t Reserved;
+};
+
+struct TMountedAssetArchive {
+    std::filesystem::path FilePath;
+    std::shared_ptr<const TMappedFile> MappedFile;
+    std::span<const TAssetArchiveEntry> Entries;
+    std::string_view Names;
+};
+
+std::vector<TMountedAssetArchive> g_mountedAssetArchives = {};
+
+constexpr auto AlignUp(uint64_t value,
+                       uint64_t alignment) -> uint64_t {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+auto HashAssetFileName(std::string_view name) -> uint64_t {
+
+    return HashBytes(std::as_bytes(std::span(name)));
+}
+
+auto GetAssetFileName(const std::filesystem::path& filePath) -> std::string {
+
+    return filePath.lexically_normal().generic_string();
+}
+
+auto WriteAssetArchive(const std::filesystem::path& archiveFilePath,
+                       std::span<const TAssetArchiveSourceFile> sourceFiles) -> std::expected<void, std::string> {
+
+    std::vector<TAssetArchiveEntry> entries;
+    entries.reserve(sourceFiles.size());
+    std::string names;
+    for (const auto& sourceFile : sourceFiles) {
+
+        std::error_code errorCode;
+        const auto fileSize = std::filesystem::file_size(sourceFile.FilePath, errorCode);
+        if (errorCode) {
+            return std::unexpected(std::format("AssetArchive: Unable to read {}", sourceFile.FilePath.string()));
+        }
+
+        const auto name = GetAssetFileName(sourceFile.Name);
+        entries.push_back(TAssetArchiveEntry{
+            .NameHash = HashAssetFileName(name),
+            .NameOffset = names.size(),
+            .NameLength = name.size(),
+            .Size = fileSize,
+            .UncompressedSize = fileSize,
+            .Compression = TAssetArchiveCompression::None,
+        });
+        names += name;
+    }
+
+    // sorting after the names were laid out keeps every entry pointing at its own name, the source file follows through the permutation
+    std::vector<std::size_t> sourceFileIndices(entries.size());
+    for (std::size_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex) {
+        sourceFileIndices[entryIndex] = entryIndex;
+    }
+    std::ranges::sort(sourceFileIndices, [&](std::size_t left, std::size_t right) {
+        return entries[left].NameHash < entries[right].NameHash;
+    });
+
+    std::vector<TAssetArchiveEntry> sortedEntries;
+    sortedEntries.reserve(entries.size());
+    for (auto sourceFileIndex : sourceFileIndices) {
+        sortedEntries.push_back(entries[sourceFileIndex]);
+    }
+
+    for (std::size_t entryIndex = 1; entryIndex < sortedEntries.size(); ++entryIndex) {
+        const auto& entry = sortedEntries[entryIndex];
+        const auto& previousEntry = sortedEntries[entryIndex - 1];
+        if (entry.NameHash == previousEntry.NameHash &&
+            std::string_view(names).substr(entry.NameOffset, entry.NameLength) == std::string_view(names).substr(previousEntry.NameOffset, previousEntry.NameLength)) {
+            return std::unexpected(std::format("AssetArchive: {} is added twice", std::string_view(names).substr(entry.NameOffset, entry.NameLength)));
+        }
+    }
+
+    auto header = TAssetArchiveHeader{
+        .Magic = AssetArchiveMagic,
+        .FormatVersion = AssetArchiveFormatVersion,
+        .EntryCount = sortedEntries.size(),
+        .EntriesOffset = sizeof(TAssetArchiveHeader),
+        .NamesOffset = sizeof(TAssetArchiveHeader) + sortedEntries.size() * sizeof(TAssetArchiveEntry),
+        .NamesSize = names.size(),
+    };
+
+    auto payloadOffset = header.NamesOffset + header.NamesSize;
+    for (auto& entry : sortedEntries) {
+        payloadOffset = AlignUp(payloadOffset, AssetArchivePayloadAlignment);
+        entry.Offset = payloadOffset;
+        payloadOffset += entry.Size;
+    }
+
+    // write to a temporary file first, a crash halfway through must not leave a valid looking archive behind
+    auto temporaryFilePath = archiveFilePath;
+    temporaryFilePath += ".tmp";
+
+    // the stream is closed once this returns, a failed archive can be removed then on every platform
+    auto writeTemporaryFile = [&]() -> std::expected<void, std::string> {
+
+        std::ofstream archiveFile(temporaryFilePath, std::ios::binary | std::ios::trunc);
+        if (!archiveFile) {
+            return std::unexpected(std::format("AssetArchive: Unable to create {}", temporaryFilePath.string()));
+        }
+
+        uint64_t writtenBytes = 0;
+        auto write = [&](const void* data, uint64_t sizeInBytes) {
+            archiveFile.write(static_cast<const char*>(data), static_cast<std::streamsize>(sizeInBytes));
+            writtenBytes += sizeInBytes;
+        };
+
+        write(&header, sizeof(TAssetArchiveHeader));
+        write(sortedEntries.data(), sortedEntries.size() * sizeof(TAssetArchiveEntry));
+        write(names.data(), names.size());
+
+        for (std::size_t entryIndex = 0; entryIndex < sortedEntries.size(); ++entryIndex) {
+
+            const auto& entry = sortedEntries[entryIndex];
+            const auto& sourceFile = sourceFiles[sourceFileIndices[entryIndex]];
+
+            static constexpr std::array<char, AssetArchivePayloadAlignment> padding = {};
+            write(padding.data(), entry.Offset - writtenBytes);
+
+            auto mappedFileResult = MapFile(sourceFile.FilePath);
+            if (!mappedFileResult) {
+                return std::unexpected(std::format("AssetArchive: {}", mappedFileResult.error()));
+            }
+
+            const auto& bytes = (*mappedFileResult)->Bytes;
+            if (bytes.size() != entry.Size) {
+                return std::unexpected(std::format("AssetArchive: {} changed while it was being archived", sourceFile.FilePath.string()));
+            }
+            write(bytes.data(), bytes.size());
+        }
+
+        if (!archiveFile) {
+            return std::unexpected(std::format("AssetArchive: Unable to write {}", temporaryFilePath.string()));
+        }
+
+        return {};
+    };
+
+    std::error_code errorCode;
+    if (auto writeResult = writeTemporaryFile(); !writeResult) {
+        std::filesystem::remove(temporaryFilePath, errorCode);
+        return writeResult;
+    }
+
+    std::filesystem::rename(temporaryFilePath, archiveFilePath, errorCode);
+    if (errorCode) {
+        std::filesystem::remove(temporaryFilePath, errorCode);
+        return std::unexpected(std::format("AssetArchive: Unable to move {} into place", archiveFilePath.string()));
+    }
+
+    return {};
+}
+
+auto MountAssetArchive(const std::filesystem::path& archiveFilePath) -> std::expected<void, std::string> {
+
+    auto mappedFileResult = MapFile(archiveFilePath);
+    if (!mappedFileResult) {
+        return std::unexpected(std::format("AssetArchive: {}", mappedFileResult.error()));
+    }
+
+    auto mappedFile = *mappedFileResult;
+    const auto bytes = mappedFile->Bytes;
+
+    TAssetArchiveHeader header = {};
+    if (bytes.size() < sizeof(TAssetArchiveHeader)) {
+        return std::unexpected(std::format("AssetArchive: {} is truncated", archiveFilePath.string()));
+    }
+    std::memcpy(&header, bytes.data(), sizeof(TAssetArchiveHeader));
+
+    if (header.Magic != AssetArchiveMagic || header.FormatVersion != AssetArchiveFormatVersion) {
+        return std::unexpected(std::format("AssetArchive: {} is not an archive of this format version", archiveFilePath.string()));
+    }
+
+    auto isInRange = [&](uint64_t offset, uint64_t size) {
+        return offset <= bytes.size() && size <= bytes.size() - offset;
+    };
+
+    if (header.EntryCount > bytes.size() / sizeof(TAssetArchiveEntry) ||
+        header.EntriesOffset % alignof(TAssetArchiveEntry) != 0 ||
+        !isInRange(header.EntriesOffset, header.EntryCount * sizeof(TAssetArchiveEntry)) ||
+        !isInRange(header.NamesOffset, header.NamesSize)) {
+        return std::unexpected(std::format("AssetArchive: {} has a corrupt header", archiveFilePath.string()));
+    }
+
+    // the table of contents is used in place, the mapping is page aligned
+    const auto entries = std::span(reinterpret_cast<const TAssetArchiveEntry*>(bytes.data() + header.EntriesOffset), header.EntryCount);
+    const auto areEntriesValid = std::ranges::all_of(entries, [&](const TAssetArchiveEntry& entry) {
+        return entry.NameOffset <= header.NamesSize && entry.NameLength <= header.NamesSize - entry.NameOffset &&
+               isInRange(entry.Offset, entry.Size);
+    });
+    if (!areEntriesValid || !std::ranges::is_sorted(entries, {}, &TAssetArchiveEntry::NameHash)) {
+        return std::unexpected(std::format("AssetArchive: {} has a corrupt table of contents", archiveFilePath.string()));
+    }
+
+    g_mountedAssetArchives.push_back(TMountedAssetArchive{
+        .FilePath = archiveFilePath,
+        .MappedFile = std::move(mappedFile),
+        .Entries = entries,
+        .Names = std::string_view(reinterpret_cast<const char*>(bytes.data() + header.NamesOffset), header.NamesSize),
+    });
+
+    return {};
+}
+
+auto FindArchivedAssetFileEntry(const std::filesystem::path& filePath) -> std::pair<const TMountedAssetArchive*, const TAssetArchiveEntry*> {
+
+    if (g_mountedAssetArchives.empty()) {
+        return {nullptr, nullptr};
+    }
+
+    const auto name = GetAssetFileName(filePath);
+    const auto nameHash = HashAssetFileName(name);
+    for (auto mountedAssetArchive = g_mountedAssetArchives.rbegin(); mountedAssetArchive != g_mountedAssetArchives.rend(); ++mountedAssetArchive) {
+
+        const auto [first, last] = std::ranges::equal_range(mountedAssetArchive->Entries, nameHash, {}, &TAssetArchiveEntry::NameHash);
+        for (const auto& entry : std::span(first, last)) {
+            if (mountedAssetArchive->Names.substr(entry.NameOffset, entry.NameLength) == name) {
+                return {&*mountedAssetArchive, &entry};
+            }
+        }
+    }
+
+    return {nullptr, nullptr};
+}
+
+auto FindArchivedAssetFile(const std::filesystem::path& filePath) -> std::optional<std::span<const std::byte>> {
+
+    const auto [mountedAssetArchive, entry] = FindArchivedAssetFileEntry(filePath);
+    if (entry == nullptr || entry->Compression != TAssetArchiveCompression::None) {
+        return std::nullopt;
+    }
+
+    return mountedAssetArchive->MappedFile->Bytes.subspan(entry->Offset, entry->Size);
+}
+
+auto HasAssetFile(const std::filesystem::path& filePath) -> bool {
+
+    return FindArchivedAssetFile(filePath).has_value() || std::filesystem::exists(filePath);
+}
+
+auto MapAssetFile(const std::filesystem::path& filePath) -> std::expected<std::shared_ptr<const TMappedFile>, std::string> {
+
+    const auto [mountedAssetArchive, entry] = FindArchivedAssetFileEntry(filePath);
+    if (entry == nullptr) {
+        return MapFile(filePath);
+    }
+
+    if (entry->Compression != TAssetArchiveCompression::None) {
+        return std::unexpected(std::format("{} in {} uses an unsupported compression", filePath.string(), mountedAssetArchive->FilePath.string()));
+    }
+
+    return ViewMappedFile(mountedAssetArchive->MappedFile, mountedAssetArchive->MappedFile->Bytes.subspan(entry->Offset, entry->Size));
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <Hephaestus/Assets/AssetDeduplication.hpp>
+#include <Hephaestus/Assets/ContentHash.hpp>
+#include <Hephaestus/RHI/VertexTypes.hpp>
+
+#include <algorithm>
+#include <span>
+
+auto GetAssetImagePixels(const TAssetImage& assetImage) -> std::span<const std::byte> {
+
+    if (assetImage.Pixels == nullptr) {
+        return {};
+    }
+
+    std::size_t pixelsSize = 0;
+    for (const auto& assetImageLevel : assetImage.Levels) {
+        pixelsSize = std::max(pixelsSize, assetImageLevel.Offset + assetImageLevel.Size);
+    }
+
+    return {assetImage.Pixels.get(), pixelsSize};
+}
+
+auto IsSameBytes(std::span<const std::byte> bytes,
+                 std::span<const std::byte> otherBytes) -> bool {
+
+    return std::ranges::equal(bytes, otherBytes);
+}
+
+auto HashAssetMeshContent(const TAssetMesh& assetMesh) -> uint64_t {
+
+    auto hash = HashBytes(assetMesh.VertexPositions);
+    hash = HashCombine(hash, static_cast<uint64_t>(assetMesh.VertexPositionFormat));
+    hash = HashCombine(hash, HashBytes(std::as_bytes(std::span(&assetMesh.PositionDequantization, 1))));
+    hash = HashCombine(hash, HashBytes(std::as_bytes(assetMesh.VertexNormalUvTangents)));
+    hash = HashCombine(hash, HashBytes(assetMesh.Indices));
+    return HashCombine(hash, static_cast<uint64_t>(assetMesh.IndexElementType));
+}
+
+auto HashAssetImageContent(const TAssetImage& assetImage) -> uint64_t {
+
+    auto hash = HashBytes(GetAssetImagePixels(assetImage));
+    hash = HashCombine(hash, static_cast<uint64_t>(assetImage.Width));
+    hash = HashCombine(hash, static_cast<uint64_t>(assetImage.Height));
+    hash = HashCombine(hash, static_cast<uint64_t>(assetImage.Levels.size()));
+    return HashCombine(hash, static_cast<uint64_t>(assetImage.Format));
+}
+
+// levels of detail and meshlets are derived from the streams, equal streams built with the same settings give equal ones,
+// they are compared anyway since meshes from differently configured imports can meet in the registry
+auto IsSameAssetMeshContent(const TAssetMesh& assetMesh,
+                            const TAssetMesh& otherAssetMesh) -> bool {
+
+    return assetMesh.IndexElementType == otherAssetMesh.IndexElementType &&
+           assetMesh.VertexPositionFormat == otherAssetMesh.VertexPositionFormat &&
+           assetMesh.PositionDequantization == otherAssetMesh.PositionDequantization &&
+           IsSameBytes(assetMesh.VertexPositions, otherAssetMesh.VertexPositions) &&
+           IsSameBytes(std::as_bytes(assetMesh.VertexNormalUvTangents), std::as_bytes(otherAssetMesh.VertexNormalUvTangents)) &&
+           IsSameBytes(assetMesh.Indices, otherAssetMesh.Indices) &&
+           IsSameBytes(std::as_bytes(assetMesh.Lods), std::as_bytes(otherAssetMesh.Lods)) &&
+           IsSameBytes(std::as_bytes(assetMesh.Meshlets), std::as_bytes(otherAssetMesh.Meshlets)) &&
+           IsSameBytes(std::as_bytes(assetMesh.MeshletVertices), std::as_bytes(otherAssetMesh.MeshletVertices)) &&
+           IsSameBytes(std::as_bytes(assetMesh.MeshletTriangles), std::as_bytes(otherAssetMesh.MeshletTriangles));
+}
+
+auto IsSameAssetImageContent(const TAssetImage& assetImage,
+                             const TAssetImage& otherAssetImage) -> bool {
+
+    return assetImage.Width == otherAssetImage.Width &&
+           assetImage.Height == otherAssetImage.Height &&
+           assetImage.Format == otherAssetImage.Format &&
+           assetImage.Levels.size() == otherAssetImage.Levels.size() &&
+           IsSameBytes(GetAssetImagePixels(assetImage), GetAssetImagePixels(otherAssetImage));
+}
+
+auto GetAssetMeshContentSize(const TAssetMesh& assetMesh) -> std::size_t {
+
+    return assetMesh.VertexPositions.size_bytes() +
+           assetMesh.VertexNormalUvTangents.size_bytes() +
+           assetMesh.Indices.size_bytes() +
+           assetMesh.Lods.size_bytes() +
+           assetMesh.Meshlets.size_bytes() +
+           assetMesh.MeshletVertices.size_bytes() +
+           assetMesh.MeshletTriangles.size_bytes();
+}
+
+auto GetAssetImageContentSize(const TAssetImage& assetImage) -> std::size_t {
+
+    return GetAssetImagePixels(assetImage).size();
+}
\ No newline at end of file
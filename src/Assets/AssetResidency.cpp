@@ -0,0 +1,144 @@
+#include <Hephaestus/Assets/AssetResidency.hpp>
+
+#include <cassert>
+#include <utility>
+
+auto TAssetResidency::GetEntryKey(const TAssetResidencyKey& key) -> uint64_t {
+
+    return (static_cast<uint64_t>(key.ContentIndex) << 1) | static_cast<uint64_t>(key.Kind);
+}
+
+auto TAssetResidency::Track(const TAssetResidencyKey& key,
+                            std::size_t sizeInBytes,
+                            TAssetResidencySource&& source) -> void {
+
+    Untrack(key);
+
+    _entries.emplace(GetEntryKey(key), TEntry{
+        .SizeInBytes = sizeInBytes,
+        .Source = std::move(source),
+        .IsUploaded = false,
+        .IsEvicted = false,
+        .IsUnloaded = false,
+        .LeastRecentlyUsedPosition = _leastRecentlyUsed.end(),
+    });
+    _statistics.ResidentBytes += sizeInBytes;
+}
+
+auto TAssetResidency::Untrack(const TAssetResidencyKey& key) -> void {
+
+    auto entry = _entries.find(GetEntryKey(key));
+    if (entry == _entries.end()) {
+        return;
+    }
+
+    if (!entry->second.IsEvicted) {
+        _statistics.ResidentBytes -= entry->second.SizeInBytes;
+    }
+    if (entry->second.LeastRecentlyUsedPosition != _leastRecentlyUsed.end()) {
+        _leastRecentlyUsed.erase(entry->second.LeastRecentlyUsedPosition);
+    }
+    _entries.erase(entry);
+}
+
+auto TAssetResidency::MarkUploaded(const TAssetResidencyKey& key) -> void {
+
+    auto entry = _entries.find(GetEntryKey(key));
+    if (entry == _entries.end() || entry->second.IsUploaded) {
+        return;
+    }
+
+    entry->second.IsUploaded = true;
+    if (!entry->second.IsEvicted) {
+        entry->second.LeastRecentlyUsedPosition = _leastRecentlyUsed.insert(_leastRecentlyUsed.end(), entry->first);
+    }
+}
+
+auto TAssetResidency::MarkUnloaded(const TAssetResidencyKey& key) -> void {
+
+    auto entry = _entries.find(GetEntryKey(key));
+    if (entry == _entries.end() || entry->second.LeastRecentlyUsedPosition == _leastRecentlyUsed.end()) {
+        return;
+    }
+
+    entry->second.IsUnloaded = true;
+    _leastRecentlyUsed.splice(_leastRecentlyUsed.begin(), _leastRecentlyUsed, entry->second.LeastRecentlyUsedPosition);
+}
+
+auto TAssetResidency::MarkReloaded(const TAssetResidencyKey& key,
+                                   std::size_t sizeInBytes) -> void {
+
+    auto entry = _entries.find(GetEntryKey(key));
+    assert(entry != _entries.end() && entry->second.IsEvicted);
+
+    entry->second.SizeInBytes = sizeInBytes;
+    entry->second.IsEvicted = false;
+    entry->second.LeastRecentlyUsedPosition = _leastRecentlyUsed.insert(_leastRecentlyUsed.end(), entry->first);
+    _statistics.ResidentBytes += sizeInBytes;
+    _statistics.ReloadedBytes += sizeInBytes;
+}
+
+auto TAssetResidency::Touch(const TAssetResidencyKey& key) -> void {
+
+    auto entry = _entries.find(GetEntryKey(key));
+    if (entry == _entries.end() || entry->second.LeastRecentlyUsedPosition == _leastRecentlyUsed.end()) {
+        return;
+    }
+
+    // the payload is in use again, it goes back to the budget like any other
+    entry->second.IsUnloaded = false;
+    _leastRecentlyUsed.splice(_leastRecentlyUsed.end(), _leastRecentlyUsed, entry->second.LeastRecentlyUsedPosition);
+}
+
+auto TAssetResidency::IsEvicted(const TAssetResidencyKey& key) const -> bool {
+
+    auto entry = _entries.find(GetEntryKey(key));
+    return entry != _entries.end() && entry->second.IsEvicted;
+}
+
+auto TAssetResidency::GetSource(const TAssetResidencyKey& key) const -> const TAssetResidencySource& {
+
+    assert(_entries.contains(GetEntryKey(key)));
+    return _entries.at(GetEntryKey(key)).Source;
+}
+
+auto TAssetResidency::SetBudget(std::size_t budgetInBytes) -> void {
+
+    _statistics.BudgetBytes = budgetInBytes;
+}
+
+auto TAssetResidency::CollectEvictions() -> std::vector<TAssetResidencyKey> {
+
+    std::vector<TAssetResidencyKey> evictions;
+
+    // unloaded payloads lead the list and go whatever the budget, payloads which are not uploaded yet are pinned,
+    // the resident bytes may stay above the budget because of them
+    while (!_leastRecentlyUsed.empty()) {
+
+        const auto entryKey = _leastRecentlyUsed.front();
+        auto& entry = _entries.at(entryKey);
+        const auto isOverBudget = _statistics.BudgetBytes > 0 && _statistics.ResidentBytes > _statistics.BudgetBytes;
+        if (!entry.IsUnloaded && !isOverBudget) {
+            break;
+        }
+
+        _leastRecentlyUsed.pop_front();
+        entry.IsEvicted = true;
+        entry.IsUnloaded = false;
+        entry.LeastRecentlyUsedPosition = _leastRecentlyUsed.end();
+        _statistics.ResidentBytes -= entry.SizeInBytes;
+        _statistics.EvictedBytes += entry.SizeInBytes;
+
+        evictions.push_back(TAssetResidencyKey{
+            .Kind = static_cast<TAssetResidencyKind>(entryKey & 1),
+            .ContentIndex = static_cast<std::size_t>(entryKey >> 1),
+        });
+    }
+
+    return evictions;
+}
+
+auto TAssetResidency::GetStatistics() const -> const TAssetMemoryStatistics& {
+
+    return _statistics;
+}
\ No newline at end of file
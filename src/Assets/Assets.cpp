@@ -1,16 +1,118 @@
 #include <Hephaestus/Assets/Assets.hpp>
+#include <Hephaestus/Assets/AssetDeduplication.hpp>
+#include <Hephaestus/Assets/AssetFileSystem.hpp>
+#include <Hephaestus/Assets/AssetMeshData.hpp>
+#include <Hephaestus/Assets/AssetRegistry.hpp>
+#include <Hephaestus/Assets/AssetResidency.hpp>
+#include <Hephaestus/Assets/ContentHash.hpp>
+#include <Hephaestus/Assets/FileWatcher.hpp>
+#include <Hephaestus/Assets/ImageDecoding.hpp>
+#include <Hephaestus/Assets/MeshCache.hpp>
+#include <Hephaestus/Assets/MeshOptimization.hpp>
+#include <Hephaestus/Assets/MeshoptDecompression.hpp>
+#include <Hephaestus/Assets/VertexQuantization.hpp>
 #include <Hephaestus/RHI/VertexTypes.hpp>
+#include <Hephaestus/MainThreadQueue.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <format>
+#include <future>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <variant>
+
+#include <glm/common.hpp>
+#include <glm/ext/vector_int3_sized.hpp>
+#include <glm/ext/vector_uint3_sized.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include <parallel_hashmap/phmap.h>
 
 #include <fastgltf/core.hpp>
+#include <fastgltf/glm_element_traits.hpp>
 #include <fastgltf/tools.hpp>
 
+#include <poolstl/poolstl.hpp>
+
 #include <spdlog/spdlog.h>
 
-phmap::flat_hash_map<std::string, std::filesystem::path> g_scannedAssets = {};
-phmap::flat_hash_map<std::string, TAssetMesh> g_assetMeshes = {};
-phmap::flat_hash_map<std::string, TAssetMaterial> g_assetMaterials = {};
+// hashes of the glTF data each resource is cooked from, by resource name
+struct TAssetSourceHashes {
+    phmap::flat_hash_map<std::string, uint64_t> Images;
+    phmap::flat_hash_map<std::string, uint64_t> Meshes;
+};
+
+struct TScannedAssetSource {
+    std::filesystem::path FilePath;
+    // the json parsed by ScanAsset, or again by a reload, every import and lazy creation reads from it,
+    // buffers and images are not part of it, see LoadAssetBufferData
+    std::shared_ptr<const fastgltf::Asset> Asset;
+    // covers the asset file and every external buffer it references, hashed by the last published import
+    uint64_t ContentHash;
+    // of the last published import, a reload re-cooks only the resources whose source hash changed
+    TAssetImportSettings ImportSettings;
+    TAssetSourceHashes SourceHashes;
+};
+
+phmap::flat_hash_map<std::string, TScannedAssetSource> g_scannedAssets = {};
+TAssetRegistry<TAssetMeshId, TAssetMesh> g_assetMeshes = {};
+TAssetRegistry<TAssetMaterialId, TAssetMaterial> g_assetMaterials = {};
+TAssetRegistry<TAssetImageId, TAssetImage> g_assetImages = {};
+TAssetDeduplicationReport g_assetDeduplicationReport = {};
+TAssetResidency g_assetResidency = {};
+// ids whose payload a reload replaced, until the renderer takes them
+std::vector<TAssetMeshId> g_reloadedAssetMeshIds = {};
+std::vector<TAssetMaterialId> g_reloadedAssetMaterialIds = {};
+std::vector<TAssetImageId> g_reloadedAssetImageIds = {};
+// ids the scene stopped referencing, until the renderer takes them
+std::vector<TAssetMeshId> g_releasedAssetMeshIds = {};
+std::vector<TAssetMaterialId> g_releasedAssetMaterialIds = {};
+phmap::flat_hash_map<std::string, std::vector<TAssetMeshInstance>> g_assetMeshInstances = {};
+// scanned assets by the absolute path of every file they are read from, see PollAssetFileChanges
+phmap::flat_hash_map<std::string, std::vector<std::string>> g_assetNamesByWatchedFile = {};
+
+// replaced as a whole by SetAssetThreadCount, the pool cannot be resized in place
+std::unique_ptr<task_thread_pool::task_thread_pool> g_assetThreadPool = std::make_unique<task_thread_pool::task_thread_pool>();
+// runs whole imports, which fan out over g_assetThreadPool, a single thread keeps them from competing for it
+task_thread_pool::task_thread_pool g_assetLoadThreadPool{1};
+// content indices of evicted payloads being read back on g_assetLoadThreadPool
+phmap::flat_hash_set<std::size_t> g_pendingAssetMeshReloads = {};
+phmap::flat_hash_set<std::size_t> g_pendingAssetImageReloads = {};
+// materials and images an import of LoadAssetMeshesAsync brings, later imports leave them out
+phmap::flat_hash_set<std::string> g_importingAssetMaterialNames = {};
+phmap::flat_hash_set<std::string> g_importingAssetImageNames = {};
+
+constexpr auto DefaultAssetMaterialName = "Default";
+
+constexpr auto AssetParserExtensions =
+    fastgltf::Extensions::EXT_mesh_gpu_instancing |
+    fastgltf::Extensions::KHR_mesh_quantization |
+    fastgltf::Extensions::EXT_meshopt_compression |
+    fastgltf::Extensions::KHR_lights_punctual |
+    fastgltf::Extensions::EXT_texture_webp |
+    fastgltf::Extensions::KHR_texture_transform |
+    fastgltf::Extensions::KHR_texture_basisu |
+    fastgltf::Extensions::MSFT_texture_dds |
+    fastgltf::Extensions::KHR_materials_specular |
+    fastgltf::Extensions::KHR_materials_ior |
+    fastgltf::Extensions::KHR_materials_iridescence |
+    fastgltf::Extensions::KHR_materials_volume |
+    fastgltf::Extensions::KHR_materials_transmission |
+    fastgltf::Extensions::KHR_materials_clearcoat |
+    fastgltf::Extensions::KHR_materials_emissive_strength |
+    fastgltf::Extensions::KHR_materials_sheen |
+    fastgltf::Extensions::KHR_materials_unlit;
+
+// names and uris only, external buffers and images are neither read nor decoded
+constexpr auto AssetDescriptionLoadOptions =
+    fastgltf::Options::DontRequireValidAssetMember |
+    fastgltf::Options::AllowDouble;
 
 auto GetSafeResourceName(
     const char* const text,
@@ -22,28 +124,366 @@ auto GetSafeResourceName(
            : std::format("{}", text);
 }
 
-auto ScanAsset(const std::string& baseName,
-               const std::filesystem::path& filePath) -> std::expected<TScannedAsset, std::string> {
+auto GetSafeResourceName(
+    const char* const baseName,
+    const char* const text,
+    const char* const resourceType,
+    std::size_t resourceIndex) -> std::string {
+
+    return (text == nullptr) || strlen(text) == 0
+           ? std::format("{}.{}-{}", baseName, resourceType, resourceIndex)
+           : std::format("{}.{}-{}", baseName, text, resourceIndex);
+}
+
+// the BIN chunk follows the 12 byte header and the JSON chunk, empty for .gltf files and for GLBs without one
+auto GetGlbBinaryChunk(std::span<const std::byte> fileBytes) -> std::span<const std::byte> {
+
+    constexpr uint32_t GlbMagic = 0x46546C67;
+    constexpr uint32_t GlbBinaryChunkType = 0x004E4942;
+    const auto readUint32 = [&](std::size_t byteOffset) {
+        uint32_t value = 0;
+        std::memcpy(&value, fileBytes.data() + byteOffset, sizeof(value));
+        return value;
+    };
+
+    if (fileBytes.size() < 20 || readUint32(0) != GlbMagic) {
+        return {};
+    }
+
+    const auto binaryChunkOffset = 20 + static_cast<std::size_t>(readUint32(12));
+    if (binaryChunkOffset + 8 > fileBytes.size() || readUint32(binaryChunkOffset + 4) != GlbBinaryChunkType) {
+        return {};
+    }
+
+    const auto binaryChunkLength = std::min<std::size_t>(readUint32(binaryChunkOffset), fileBytes.size() - binaryChunkOffset - 8);
+    return fileBytes.subspan(binaryChunkOffset + 8, binaryChunkLength);
+}
+
+// the json only, cheap enough for the main thread, the names and uris of every resource are there,
+// the BIN chunk of a .glb is dropped again, LoadAssetBufferData maps it from the file whenever it is read
+auto ParseAssetDescription(const std::filesystem::path& filePath) -> std::expected<std::shared_ptr<const fastgltf::Asset>, std::string> {
 
-    fastgltf::Parser parser;
+    auto mappedFileResult = MapAssetFile(filePath);
+    if (!mappedFileResult) {
+        return std::unexpected(mappedFileResult.error());
+    }
 
-    auto fgFile = fastgltf::MappedGltfFile::FromPath(filePath);
-    if (fgFile.error() != fastgltf::Error::None) {
-        return std::unexpected(std::format("fastgltf: Failed to load glTF data: {}", fastgltf::getErrorMessage(fgFile.error())));
+    // the parser wants padded input, that costs one copy of the json/glb here
+    const auto fileBytes = (*mappedFileResult)->Bytes;
+    auto dataResult = fastgltf::GltfDataBuffer::FromBytes(fileBytes.data(), fileBytes.size());
+    if (dataResult.error() != fastgltf::Error::None) {
+        return std::unexpected(std::format("fastgltf: Failed to load glTF data: {}", fastgltf::getErrorMessage(dataResult.error())));
     }
 
-    auto parentPath = filePath.parent_path();
-    auto loadResult = parser.loadGltf(fgFile.get(), parentPath, fastgltf::Options::None);
+    fastgltf::Parser parser(AssetParserExtensions);
+    auto loadResult = parser.loadGltf(dataResult.get(), filePath.parent_path(), AssetDescriptionLoadOptions);
     if (loadResult.error() != fastgltf::Error::None)
     {
         return std::unexpected(std::format("fastgltf: Failed to parse glTF: {}", fastgltf::getErrorMessage(loadResult.error())));
     }
 
+    auto asset = std::make_shared<fastgltf::Asset>(std::move(loadResult.get()));
+    if (!asset->buffers.empty() &&
+        !std::holds_alternative<fastgltf::sources::URI>(asset->buffers[0].data) &&
+        !GetGlbBinaryChunk(fileBytes).empty()) {
+        asset->buffers[0].data = fastgltf::sources::Fallback{};
+    }
+
+    return asset;
+}
+
+// the asset file and every external buffer and image it references, taken from the uris, nothing is read
+auto GetAssetSourceFilePaths(const std::filesystem::path& filePath,
+                             const fastgltf::Asset& asset) -> std::vector<std::filesystem::path> {
+
+    std::vector<std::filesystem::path> sourceFilePaths = {filePath};
+    const auto addSourceFilePath = [&](const fastgltf::DataSource& data) {
+        const auto* uri = std::get_if<fastgltf::sources::URI>(&data);
+        if (uri != nullptr && uri->uri.isLocalPath()) {
+            sourceFilePaths.push_back(filePath.parent_path() / uri->uri.fspath());
+        }
+    };
+
+    for (const auto& buffer : asset.buffers) {
+        addSourceFilePath(buffer.data);
+    }
+
+    for (const auto& image : asset.images) {
+        addSourceFilePath(image.data);
+    }
+
+    return sourceFilePaths;
+}
+
+// a change to any of the files changes the hash, their bytes are read through the mappings, nothing is parsed
+auto HashAssetSource(const std::filesystem::path& filePath,
+                     const fastgltf::Asset& asset) -> std::optional<uint64_t> {
+
+    uint64_t contentHash = 0;
+    for (const auto& sourceFilePath : GetAssetSourceFilePaths(filePath, asset)) {
+        const auto fileHash = HashFile(sourceFilePath);
+        if (!fileHash.has_value()) {
+            return std::nullopt;
+        }
+
+        contentHash = HashCombine(contentHash, *fileHash);
+    }
+
+    return contentHash;
+}
+
+// the bytes of the buffers and images one import reads, only the files of the resources it processes are mapped
+struct TAssetBufferData {
+    // by buffer index, empty for buffers nothing reads
+    std::vector<std::span<const std::byte>> Buffers;
+    // meshopt compressed buffer views, by buffer view index
+    phmap::flat_hash_map<std::size_t, fastgltf::sources::Vector> DecodedBufferViews;
+    // by image index, for images with an uri or data of their own, the others are read through their buffer view
+    std::vector<std::span<const std::byte>> Images;
+    // keep the files behind Buffers and Images mapped
+    std::vector<std::shared_ptr<const TMappedFile>> MappedFiles;
+};
+
+// hands the accessor tools of fastgltf the mapped and decoded bytes, the buffers of the asset itself hold nothing
+struct TAssetBufferDataAdapter {
+    const TAssetBufferData& BufferData;
+
+    auto operator()(const fastgltf::Asset& asset,
+                    std::size_t bufferViewIndex) const -> fastgltf::span<const std::byte> {
+
+        if (auto decodedBufferView = BufferData.DecodedBufferViews.find(bufferViewIndex); decodedBufferView != BufferData.DecodedBufferViews.end()) {
+            const auto& bytes = decodedBufferView->second.bytes;
+            return fastgltf::span<const std::byte>(reinterpret_cast<const std::byte*>(bytes.data()), bytes.size());
+        }
+
+        const auto& bufferView = asset.bufferViews[bufferViewIndex];
+        return fastgltf::span<const std::byte>(BufferData.Buffers[bufferView.bufferIndex].data() + bufferView.byteOffset, bufferView.byteLength);
+    }
+};
+
+// the buffer views an accessor reads from, sparse accessors read their indices and values from views of their own
+auto AddAccessorBufferViewIndices(const fastgltf::Accessor& accessor,
+                                  std::vector<std::size_t>& bufferViewIndices) -> void {
+
+    if (accessor.bufferViewIndex.has_value()) {
+        bufferViewIndices.push_back(accessor.bufferViewIndex.value());
+    }
+
+    if (accessor.sparse.has_value()) {
+        bufferViewIndices.push_back(accessor.sparse->indicesBufferView);
+        bufferViewIndices.push_back(accessor.sparse->valuesBufferView);
+    }
+}
+
+auto AddPrimitiveBufferViewIndices(const fastgltf::Asset& asset,
+                                   const fastgltf::Primitive& primitive,
+                                   std::vector<std::size_t>& bufferViewIndices) -> void {
+
+    for (const auto& attribute : primitive.attributes) {
+        AddAccessorBufferViewIndices(asset.accessors[attribute.accessorIndex], bufferViewIndices);
+    }
+
+    if (primitive.indicesAccessor.has_value()) {
+        AddAccessorBufferViewIndices(asset.accessors[primitive.indicesAccessor.value()], bufferViewIndices);
+    }
+}
+
+// EXT_mesh_gpu_instancing accessors of every node, see GetInstanceMatrices
+auto AddInstancingBufferViewIndices(const fastgltf::Asset& asset,
+                                    std::vector<std::size_t>& bufferViewIndices) -> void {
+
+    for (const auto& node : asset.nodes) {
+        for (const auto& instancingAttribute : node.instancingAttributes) {
+            AddAccessorBufferViewIndices(asset.accessors[instancingAttribute.accessorIndex], bufferViewIndices);
+        }
+    }
+}
+
+// maps the files behind the given buffer views and images, archived or not, and decodes the meshopt compressed
+// buffer views among them on the pool, the rest of the asset is never touched
+auto LoadAssetBufferData(const std::filesystem::path& filePath,
+                         const fastgltf::Asset& asset,
+                         std::span<const std::size_t> bufferViewIndices,
+                         std::span<const std::size_t> imageIndices) -> std::expected<TAssetBufferData, std::string> {
+
+    TAssetBufferData bufferData;
+    bufferData.Buffers.resize(asset.buffers.size());
+    bufferData.Images.resize(asset.images.size());
+
+    // several buffers and images can live in one file, it is mapped once
+    phmap::flat_hash_map<std::string, std::span<const std::byte>> mappedFileBytes;
+    const auto mapFile = [&](const std::filesystem::path& mappedFilePath) -> std::expected<std::span<const std::byte>, std::string> {
+
+        auto mappedBytes = mappedFileBytes.find(mappedFilePath.string());
+        if (mappedBytes == mappedFileBytes.end()) {
+            auto mappedFileResult = MapAssetFile(mappedFilePath);
+            if (!mappedFileResult) {
+                return std::unexpected(mappedFileResult.error());
+            }
+
+            mappedBytes = mappedFileBytes.emplace(mappedFilePath.string(), (*mappedFileResult)->Bytes).first;
+            bufferData.MappedFiles.push_back(std::move(*mappedFileResult));
+        }
+
+        return mappedBytes->second;
+    };
+
+    const auto loadSource = [&](const fastgltf::DataSource& data) -> std::expected<std::span<const std::byte>, std::string> {
+
+        return std::visit(fastgltf::visitor {
+            [&](const fastgltf::sources::URI& uri) -> std::expected<std::span<const std::byte>, std::string> {
+                if (!uri.uri.isLocalPath()) {
+                    return std::unexpected(std::format("Assets: {} is not a local file", uri.uri.string()));
+                }
+
+                auto bytes = mapFile(filePath.parent_path() / uri.uri.fspath());
+                if (!bytes) {
+                    return bytes;
+                }
+
+                if (uri.fileByteOffset > bytes->size()) {
+                    return std::unexpected(std::format("Assets: {} is shorter than its byte offset {}", uri.uri.string(), uri.fileByteOffset));
+                }
+
+                return bytes->subspan(uri.fileByteOffset);
+            },
+            // the BIN chunk, which ParseAssetDescription dropped
+            [&](const fastgltf::sources::Fallback&) -> std::expected<std::span<const std::byte>, std::string> {
+                auto bytes = mapFile(filePath);
+                if (!bytes) {
+                    return bytes;
+                }
+
+                return GetGlbBinaryChunk(*bytes);
+            },
+            [](const auto& source) -> std::expected<std::span<const std::byte>, std::string> {
+                if constexpr (requires { source.bytes.data(); }) {
+                    return std::span<const std::byte>(reinterpret_cast<const std::byte*>(source.bytes.data()), source.bytes.size());
+                } else {
+                    return std::span<const std::byte>();
+                }
+            }
+        }, data);
+    };
+
+    const auto loadBuffer = [&](std::size_t bufferIndex) -> std::expected<void, std::string> {
+
+        if (bufferIndex >= asset.buffers.size()) {
+            return std::unexpected(std::format("Assets: Buffer {} of {} does not exist", bufferIndex, filePath.string()));
+        }
+
+        const auto& buffer = asset.buffers[bufferIndex];
+        if (!bufferData.Buffers[bufferIndex].empty() || buffer.byteLength == 0) {
+            return {};
+        }
+
+        auto bytes = loadSource(buffer.data);
+        if (!bytes) {
+            return std::unexpected(bytes.error());
+        }
+
+        if (bytes->size() < buffer.byteLength) {
+            return std::unexpected(std::format("Assets: Buffer {} of {} is truncated", bufferIndex, filePath.string()));
+        }
+
+        bufferData.Buffers[bufferIndex] = bytes->first(buffer.byteLength);
+        return {};
+    };
+
+    std::vector<std::size_t> loadedBufferViewIndices(bufferViewIndices.begin(), bufferViewIndices.end());
+    for (const auto imageIndex : imageIndices) {
+        const auto& image = asset.images[imageIndex];
+        if (const auto* bufferView = std::get_if<fastgltf::sources::BufferView>(&image.data); bufferView != nullptr) {
+            loadedBufferViewIndices.push_back(bufferView->bufferViewIndex);
+            continue;
+        }
+
+        auto bytes = loadSource(image.data);
+        if (!bytes) {
+            return std::unexpected(bytes.error());
+        }
+
+        bufferData.Images[imageIndex] = *bytes;
+    }
+
+    std::ranges::sort(loadedBufferViewIndices);
+    loadedBufferViewIndices.erase(std::unique(loadedBufferViewIndices.begin(), loadedBufferViewIndices.end()), loadedBufferViewIndices.end());
+
+    std::vector<std::size_t> compressedBufferViewIndices;
+    for (const auto bufferViewIndex : loadedBufferViewIndices) {
+        if (bufferViewIndex >= asset.bufferViews.size()) {
+            return std::unexpected(std::format("Assets: Buffer view {} of {} does not exist", bufferViewIndex, filePath.string()));
+        }
+
+        const auto& bufferView = asset.bufferViews[bufferViewIndex];
+        if (bufferView.meshoptCompression != nullptr) {
+            if (auto loadResult = loadBuffer(bufferView.meshoptCompression->bufferIndex); !loadResult) {
+                return std::unexpected(loadResult.error());
+            }
+
+            compressedBufferViewIndices.push_back(bufferViewIndex);
+            continue;
+        }
+
+        if (auto loadResult = loadBuffer(bufferView.bufferIndex); !loadResult) {
+            return std::unexpected(loadResult.error());
+        }
+
+        if (bufferView.byteOffset + bufferView.byteLength > bufferData.Buffers[bufferView.bufferIndex].size()) {
+            return std::unexpected(std::format("Assets: Buffer view {} of {} is outside of its buffer", bufferViewIndex, filePath.string()));
+        }
+    }
+
+    std::vector<std::expected<fastgltf::sources::Vector, std::string>> decodedBufferViews(compressedBufferViewIndices.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), decodedBufferViews.begin(), decodedBufferViews.end(), [&](auto& decodedBufferView) {
+
+        const auto& meshoptCompression = *asset.bufferViews[compressedBufferViewIndices[&decodedBufferView - decodedBufferViews.data()]].meshoptCompression;
+        decodedBufferView = DecodeMeshoptBufferView(bufferData.Buffers[meshoptCompression.bufferIndex], meshoptCompression);
+    });
+
+    for (std::size_t i = 0; i < compressedBufferViewIndices.size(); ++i) {
+        if (!decodedBufferViews[i]) {
+            return std::unexpected(std::format("Buffer view {}: {}", compressedBufferViewIndices[i], decodedBufferViews[i].error()));
+        }
+
+        bufferData.DecodedBufferViews.emplace(compressedBufferViewIndices[i], std::move(*decodedBufferViews[i]));
+    }
+
+    return bufferData;
+}
+
+// images and buffers can be shared by several assets, every one of them is reloaded when the file changes
+auto WatchAssetSourceFile(const std::string& assetName,
+                          const std::filesystem::path& sourceFilePath) -> void {
+
+    std::error_code errorCode;
+    const auto absoluteSourceFilePath = std::filesystem::weakly_canonical(sourceFilePath, errorCode);
+    if (errorCode) {
+        spdlog::warn("Assets: Unable to resolve {}: {}", sourceFilePath.string(), errorCode.message());
+        return;
+    }
+
+    auto& assetNames = g_assetNamesByWatchedFile[absoluteSourceFilePath.string()];
+    if (std::ranges::find(assetNames, assetName) == assetNames.end()) {
+        assetNames.push_back(assetName);
+        WatchFile(absoluteSourceFilePath);
+    }
+}
+
+auto ScanAsset(const std::string& baseName,
+               const std::filesystem::path& filePath) -> std::expected<TScannedAsset, std::string> {
+
+    // parsed once here, imports and lazy creation map the buffers and images they need from the description
+    auto parseResult = ParseAssetDescription(filePath);
+    if (!parseResult) {
+        return std::unexpected(parseResult.error());
+    }
+
     TScannedAsset assetScan = {
         .Name = baseName
     };
 
-    auto& fgAsset = loadResult.get();
+    const auto& fgAsset = **parseResult;
     assetScan.Images.resize(fgAsset.images.size());
     for (std::size_t i = 0, end = fgAsset.images.size(); i < end; ++i) {
         assetScan.Images[i] = GetSafeResourceName(fgAsset.images[i].name.data(), "image", i);
@@ -94,72 +534,1890 @@ auto ScanAsset(const std::string& baseName,
         assetScan.Scenes[i] = GetSafeResourceName(fgAsset.scenes[i].name.data(), "scene", i);
     }
 
-    g_scannedAssets[baseName] = filePath;
+    g_scannedAssets[baseName] = TScannedAssetSource{
+        .FilePath = filePath,
+        .Asset = std::move(*parseResult),
+        .ContentHash = 0,
+    };
+
+    // archives are immutable while mounted, only loose files can change underneath
+    if (!FindArchivedAssetFile(filePath).has_value()) {
+        for (const auto& sourceFilePath : GetAssetSourceFilePaths(filePath, fgAsset)) {
+            WatchAssetSourceFile(baseName, sourceFilePath);
+        }
+    }
 
     return assetScan;
 }
 
-auto CreateAssetMesh(std::string_view assetMeshName) -> void {
-
-    const auto& filePath = g_scannedAssets.at(assetMeshName);
-
-    constexpr auto parserOptions =
-        fastgltf::Extensions::EXT_mesh_gpu_instancing |
-        fastgltf::Extensions::KHR_mesh_quantization |
-        fastgltf::Extensions::EXT_meshopt_compression |
-        fastgltf::Extensions::KHR_lights_punctual |
-        fastgltf::Extensions::EXT_texture_webp |
-        fastgltf::Extensions::KHR_texture_transform |
-        fastgltf::Extensions::KHR_texture_basisu |
-        fastgltf::Extensions::MSFT_texture_dds |
-        fastgltf::Extensions::KHR_materials_specular |
-        fastgltf::Extensions::KHR_materials_ior |
-        fastgltf::Extensions::KHR_materials_iridescence |
-        fastgltf::Extensions::KHR_materials_volume |
-        fastgltf::Extensions::KHR_materials_transmission |
-        fastgltf::Extensions::KHR_materials_clearcoat |
-        fastgltf::Extensions::KHR_materials_emissive_strength |
-        fastgltf::Extensions::KHR_materials_sheen |
-        fastgltf::Extensions::KHR_materials_unlit;
-    fastgltf::Parser parser(parserOptions);
-
-    auto dataResult = fastgltf::GltfDataBuffer::FromPath(filePath);
-    if (dataResult.error() != fastgltf::Error::None) {
-        spdlog::error("fastgltf: Failed to load glTF data: {}", fastgltf::getErrorMessage(dataResult.error()));
+auto GetImageBytes(const fastgltf::Asset& asset,
+                   const TAssetBufferData& bufferData,
+                   std::size_t imageIndex) -> std::span<const std::byte> {
+
+    const auto* bufferView = std::get_if<fastgltf::sources::BufferView>(&asset.images[imageIndex].data);
+    if (bufferView != nullptr) {
+        return TAssetBufferDataAdapter{bufferData}(asset, bufferView->bufferViewIndex);
+    }
+
+    return bufferData.Images[imageIndex];
+}
+
+// KHR_texture_basisu images take precedence, the plain image is the fallback for loaders without the extension
+auto GetTextureImageIndex(const fastgltf::Texture& texture) -> std::optional<std::size_t> {
+
+    if (texture.basisuImageIndex.has_value()) {
+        return texture.basisuImageIndex.value();
+    }
+
+    if (texture.imageIndex.has_value()) {
+        return texture.imageIndex.value();
+    }
+
+    return std::nullopt;
+}
+
+auto GetImageUsages(const fastgltf::Asset& asset) -> std::vector<TAssetImageUsage> {
+
+    std::vector<TAssetImageUsage> imageUsages(asset.images.size(), TAssetImageUsage::Color);
+    for (const auto& material : asset.materials) {
+        if (!material.normalTexture.has_value()) {
+            continue;
+        }
+
+        const auto imageIndex = GetTextureImageIndex(asset.textures[material.normalTexture->textureIndex]);
+        if (imageIndex.has_value()) {
+            imageUsages[imageIndex.value()] = TAssetImageUsage::Normal;
+        }
+    }
+
+    return imageUsages;
+}
+
+auto ProcessImage(const std::string& assetName,
+                  const fastgltf::Asset& asset,
+                  const TAssetBufferData& bufferData,
+                  std::size_t imageIndex,
+                  TAssetImageUsage imageUsage,
+                  TAssetImage& assetImage) -> void {
+
+    const auto& image = asset.images[imageIndex];
+
+    assetImage.Name = GetSafeResourceName(assetName.data(), image.name.data(), "image", imageIndex);
+
+    auto imageBytes = GetImageBytes(asset, bufferData, imageIndex);
+    if (imageBytes.empty()) {
+        spdlog::warn("Assets: Image {} has no embedded or loaded data", assetImage.Name);
         return;
     }
 
-    constexpr auto gltfOptions =
-        fastgltf::Options::DontRequireValidAssetMember |
-        fastgltf::Options::AllowDouble |
-        fastgltf::Options::LoadExternalBuffers |
-        fastgltf::Options::LoadExternalImages;
-    const auto parentPath = filePath.parent_path();
-    auto loadResult = parser.loadGltf(dataResult.get(), parentPath, gltfOptions);
-    if (loadResult.error() != fastgltf::Error::None)
-    {
-        spdlog::error("fastgltf: Failed to parse glTF: {}", fastgltf::getErrorMessage(loadResult.error()));
+    auto decodeResult = DecodeImage(imageBytes, imageUsage, assetImage);
+    if (!decodeResult) {
+        spdlog::warn("Assets: Image {}: {}", assetImage.Name, decodeResult.error());
+    }
+}
+
+auto IsSourceUnchanged(const phmap::flat_hash_map<std::string, uint64_t>& previousSourceHashes,
+                       const phmap::flat_hash_map<std::string, uint64_t>& sourceHashes,
+                       const std::string& resourceName) -> bool {
+
+    auto previousSourceHash = previousSourceHashes.find(resourceName);
+    auto sourceHash = sourceHashes.find(resourceName);
+    return previousSourceHash != previousSourceHashes.end() &&
+           sourceHash != sourceHashes.end() &&
+           previousSourceHash->second == sourceHash->second;
+}
+
+// images which are unchanged since the previous import are left out
+auto ProcessImages(const std::string& assetName,
+                   const fastgltf::Asset& asset,
+                   const TAssetBufferData& bufferData,
+                   const TAssetSourceHashes& previousSourceHashes,
+                   const TAssetSourceHashes& sourceHashes) -> std::vector<TAssetImage> {
+
+    const auto imageUsages = GetImageUsages(asset);
+
+    std::vector<TAssetImage> assetImages(asset.images.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), assetImages.begin(), assetImages.end(), [&](TAssetImage& assetImage) {
+
+        const auto imageIndex = static_cast<std::size_t>(&assetImage - assetImages.data());
+        const auto assetImageName = GetSafeResourceName(assetName.data(), asset.images[imageIndex].name.data(), "image", imageIndex);
+        if (IsSourceUnchanged(previousSourceHashes.Images, sourceHashes.Images, assetImageName)) {
+            return;
+        }
+
+        ProcessImage(assetName, asset, bufferData, imageIndex, imageUsages[imageIndex], assetImage);
+    });
+
+    std::erase_if(assetImages, [](const TAssetImage& assetImage) { return assetImage.Name.empty(); });
+    return assetImages;
+}
+
+auto GetMaterialImageIndex(const fastgltf::Asset& asset,
+                           const auto& textureInfo) -> std::optional<std::size_t> {
+
+    if (!textureInfo.has_value()) {
+        return std::nullopt;
+    }
+
+    return GetTextureImageIndex(asset.textures[textureInfo->textureIndex]);
+}
+
+auto ProcessMaterial(const std::string& assetName,
+                     const fastgltf::Asset& asset,
+                     std::size_t materialIndex) -> std::pair<std::string, TAssetMaterial> {
+
+    auto getImageName = [&](const auto& textureInfo) -> std::optional<std::string> {
+        const auto imageIndexResult = GetMaterialImageIndex(asset, textureInfo);
+        if (!imageIndexResult.has_value()) {
+            return std::nullopt;
+        }
+
+        const auto imageIndex = imageIndexResult.value();
+        return GetSafeResourceName(assetName.data(), asset.images[imageIndex].name.data(), "image", imageIndex);
+    };
+
+    const auto& material = asset.materials[materialIndex];
+    return {
+        GetSafeResourceName(assetName.data(), material.name.data(), "material", materialIndex),
+        TAssetMaterial{
+            .BaseColor = glm::vec4{
+                material.pbrData.baseColorFactor[0],
+                material.pbrData.baseColorFactor[1],
+                material.pbrData.baseColorFactor[2],
+                material.pbrData.baseColorFactor[3]},
+            .BaseColorImageName = getImageName(material.pbrData.baseColorTexture),
+            .NormalImageName = getImageName(material.normalTexture),
+        }
+    };
+}
+
+auto ProcessMaterials(const std::string& assetName,
+                      const fastgltf::Asset& asset) -> std::vector<std::pair<std::string, TAssetMaterial>> {
+
+    std::vector<std::pair<std::string, TAssetMaterial>> assetMaterials(asset.materials.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), assetMaterials.begin(), assetMaterials.end(), [&](auto& assetMaterial) {
+
+        const auto materialIndex = static_cast<std::size_t>(&assetMaterial - assetMaterials.data());
+        assetMaterial = ProcessMaterial(assetName, asset, materialIndex);
+    });
+
+    return assetMaterials;
+}
+
+// KHR_mesh_quantization integer positions are kept on the grid of their component type, bytes as snorm 8 bit and shorts
+// as snorm 16 bit, unsigned ones are shifted into the signed range by Bias, float positions have no grid
+struct TAccessorPositionGrid {
+    TVertexPositionFormat Format;
+    int32_t Bias;
+    int32_t SnormMax;
+    // one step of the grid in mesh space
+    float Unit;
+};
+
+auto GetAccessorPositionGrid(const fastgltf::Accessor& positionAccessor) -> std::optional<TAccessorPositionGrid> {
+
+    const auto isNormalized = positionAccessor.normalized;
+    switch (positionAccessor.componentType) {
+        case fastgltf::ComponentType::Byte:
+            return TAccessorPositionGrid{TVertexPositionFormat::Snorm8x4, 0, 127, isNormalized ? 1.0f / 127.0f : 1.0f};
+        case fastgltf::ComponentType::UnsignedByte:
+            return TAccessorPositionGrid{TVertexPositionFormat::Snorm8x4, 128, 127, isNormalized ? 1.0f / 255.0f : 1.0f};
+        case fastgltf::ComponentType::Short:
+            return TAccessorPositionGrid{TVertexPositionFormat::Snorm16x4, 0, 32767, isNormalized ? 1.0f / 32767.0f : 1.0f};
+        case fastgltf::ComponentType::UnsignedShort:
+            return TAccessorPositionGrid{TVertexPositionFormat::Snorm16x4, 32768, 32767, isNormalized ? 1.0f / 65535.0f : 1.0f};
+        default:
+            return std::nullopt;
+    }
+}
+
+// the integers are copied as they are, no float round trip, only the lowest value of a range collapses onto its neighbour,
+// snorm decodes both alike, the float copy for the import stages is taken from the very same integers
+template<typename TComponents, typename TQuantizedPosition>
+auto CopyGridPositions(const fastgltf::Asset& asset,
+                       const fastgltf::Accessor& positionAccessor,
+                       const TAssetBufferDataAdapter& bufferDataAdapter,
+                       const TAccessorPositionGrid& positionGrid,
+                       std::vector<glm::vec3>& vertexPositions,
+                       std::vector<TQuantizedPosition>& quantizedVertexPositions) -> void {
+
+    quantizedVertexPositions.resize(positionAccessor.count);
+    fastgltf::iterateAccessorWithIndex<TComponents>(asset, positionAccessor, [&](TComponents position, std::size_t index) {
+        const auto encodedPosition = glm::clamp(glm::ivec3(position) - positionGrid.Bias, -positionGrid.SnormMax, positionGrid.SnormMax);
+        quantizedVertexPositions[index].Position = decltype(TQuantizedPosition::Position)(encodedPosition, 0);
+        vertexPositions[index] = (glm::vec3(encodedPosition) + static_cast<float>(positionGrid.Bias)) * positionGrid.Unit;
+    }, bufferDataAdapter);
+}
+
+// lossy, float positions are spread over their bounds, only with TAssetImportSettings::QuantizePositions
+auto GetBoundsPositionQuantization(std::span<const glm::vec3> vertexPositions) -> TPositionQuantization {
+
+    auto boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    auto boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const auto& vertexPosition : vertexPositions) {
+        boundsMin = glm::min(boundsMin, vertexPosition);
+        boundsMax = glm::max(boundsMax, vertexPosition);
+    }
+
+    return vertexPositions.empty()
+        ? GetPositionQuantization(glm::vec3(0.0f), glm::vec3(0.0f))
+        : GetPositionQuantization(boundsMin, boundsMax);
+}
+
+auto GetVertices(const fastgltf::Asset& asset,
+                 const TAssetBufferData& bufferData,
+                 const fastgltf::Primitive& primitive,
+                 TAssetMeshData& assetMeshData) -> void {
+
+    auto positionAttribute = primitive.findAttribute("POSITION");
+    if (positionAttribute == primitive.attributes.end()) {
+        return;
+    }
+
+    const auto& positionAccessor = asset.accessors[positionAttribute->accessorIndex];
+    auto& vertexPositions = assetMeshData.VertexPositions;
+    auto& vertexNormalUvTangents = assetMeshData.VertexNormalUvTangents;
+    vertexPositions.resize(positionAccessor.count);
+    vertexNormalUvTangents.resize(positionAccessor.count, TGpuVertexNormalUvTangent{
+        .Normal = EncodeNormal(glm::vec3{0.0f, 0.0f, 1.0f}),
+        .Tangent = EncodeTangent(glm::vec4{1.0f, 0.0f, 0.0f, 1.0f}),
+        .Uv = EncodeUv(glm::vec2{0.0f}),
+    });
+
+    const auto bufferDataAdapter = TAssetBufferDataAdapter{bufferData};
+    const auto positionGrid = GetAccessorPositionGrid(positionAccessor);
+    switch (positionAccessor.componentType) {
+        case fastgltf::ComponentType::Byte:
+            CopyGridPositions<glm::i8vec3>(asset, positionAccessor, bufferDataAdapter, *positionGrid, vertexPositions, assetMeshData.QuantizedByteVertexPositions);
+            break;
+        case fastgltf::ComponentType::UnsignedByte:
+            CopyGridPositions<glm::u8vec3>(asset, positionAccessor, bufferDataAdapter, *positionGrid, vertexPositions, assetMeshData.QuantizedByteVertexPositions);
+            break;
+        case fastgltf::ComponentType::Short:
+            CopyGridPositions<glm::i16vec3>(asset, positionAccessor, bufferDataAdapter, *positionGrid, vertexPositions, assetMeshData.QuantizedVertexPositions);
+            break;
+        case fastgltf::ComponentType::UnsignedShort:
+            CopyGridPositions<glm::u16vec3>(asset, positionAccessor, bufferDataAdapter, *positionGrid, vertexPositions, assetMeshData.QuantizedVertexPositions);
+            break;
+        default:
+            fastgltf::iterateAccessorWithIndex<glm::vec3>(asset, positionAccessor, [&](glm::vec3 position, std::size_t index) {
+                vertexPositions[index] = position;
+            }, bufferDataAdapter);
+            break;
+    }
+
+    if (positionGrid.has_value()) {
+        assetMeshData.VertexPositionFormat = positionGrid->Format;
+        assetMeshData.PositionQuantization = TPositionQuantization{
+            .Scale = glm::vec3(static_cast<float>(positionGrid->SnormMax) * positionGrid->Unit),
+            .Offset = glm::vec3(static_cast<float>(positionGrid->Bias) * positionGrid->Unit),
+        };
+    }
+
+    // attributes are quantized as they are read, see VertexQuantization.hpp for the encodings
+    auto normalAttribute = primitive.findAttribute("NORMAL");
+    if (normalAttribute != primitive.attributes.end()) {
+        fastgltf::iterateAccessorWithIndex<glm::vec3>(asset, asset.accessors[normalAttribute->accessorIndex], [&](glm::vec3 normal, std::size_t index) {
+            vertexNormalUvTangents[index].Normal = EncodeNormal(normal);
+        }, bufferDataAdapter);
+    }
+
+    auto uvAttribute = primitive.findAttribute("TEXCOORD_0");
+    if (uvAttribute != primitive.attributes.end()) {
+        fastgltf::iterateAccessorWithIndex<glm::vec2>(asset, asset.accessors[uvAttribute->accessorIndex], [&](glm::vec2 uv, std::size_t index) {
+            vertexNormalUvTangents[index].Uv = EncodeUv(uv);
+        }, bufferDataAdapter);
+    }
+
+    auto tangentAttribute = primitive.findAttribute("TANGENT");
+    if (tangentAttribute != primitive.attributes.end()) {
+        fastgltf::iterateAccessorWithIndex<glm::vec4>(asset, asset.accessors[tangentAttribute->accessorIndex], [&](glm::vec4 tangent, std::size_t index) {
+            vertexNormalUvTangents[index].Tangent = EncodeTangent(tangent);
+        }, bufferDataAdapter);
+    }
+}
+
+auto GetIndices(const fastgltf::Asset& asset,
+                const TAssetBufferData& bufferData,
+                const fastgltf::Primitive& primitive,
+                std::size_t vertexCount) -> std::vector<uint32_t> {
+
+    std::vector<uint32_t> indices;
+    if (primitive.indicesAccessor.has_value()) {
+        const auto& indexAccessor = asset.accessors[primitive.indicesAccessor.value()];
+        indices.resize(indexAccessor.count);
+        fastgltf::copyFromAccessor<uint32_t>(asset, indexAccessor, indices.data(), TAssetBufferDataAdapter{bufferData});
+    } else {
+        indices.resize(vertexCount);
+        std::iota(indices.begin(), indices.end(), 0u);
+    }
+
+    return indices;
+}
+
+auto GetPrimitiveMeshName(const std::string& assetName,
+                          const fastgltf::Asset& asset,
+                          std::size_t meshIndex,
+                          std::size_t primitiveIndex) -> std::string {
+
+    return std::format("{}-{}", GetSafeResourceName(assetName.data(), asset.meshes[meshIndex].name.data(), "mesh", meshIndex), primitiveIndex);
+}
+
+auto LogMeshOptimizationStatistics(const std::string& assetName,
+                                   std::span<const TAssetMesh> assetMeshes,
+                                   std::span<const TMeshOptimizationStatistics> meshOptimizationStatistics) -> void {
+
+    // weigh by triangle count, otherwise a few tiny primitives dominate the aggregate
+    std::size_t triangleCount = 0;
+    std::size_t vertexCountBefore = 0;
+    std::size_t vertexCountAfter = 0;
+    double acmrBefore = 0.0;
+    double acmrAfter = 0.0;
+    double atvrBefore = 0.0;
+    double atvrAfter = 0.0;
+    for (std::size_t meshIndex = 0; meshIndex < meshOptimizationStatistics.size(); ++meshIndex) {
+        const auto& statistics = meshOptimizationStatistics[meshIndex];
+        spdlog::debug("Assets: {} ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, vertices {} -> {}",
+                      assetMeshes[meshIndex].Name,
+                      statistics.AcmrBefore,
+                      statistics.AcmrAfter,
+                      statistics.AtvrBefore,
+                      statistics.AtvrAfter,
+                      statistics.VertexCountBefore,
+                      statistics.VertexCountAfter);
+
+        triangleCount += statistics.TriangleCount;
+        vertexCountBefore += statistics.VertexCountBefore;
+        vertexCountAfter += statistics.VertexCountAfter;
+        acmrBefore += statistics.AcmrBefore * statistics.TriangleCount;
+        acmrAfter += statistics.AcmrAfter * statistics.TriangleCount;
+        atvrBefore += statistics.AtvrBefore * statistics.TriangleCount;
+        atvrAfter += statistics.AtvrAfter * statistics.TriangleCount;
+    }
+
+    if (triangleCount == 0) {
         return;
     }
 
+    spdlog::info("Assets: Optimized {} triangles of {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, vertices {} -> {}",
+                 triangleCount,
+                 assetName,
+                 acmrBefore / triangleCount,
+                 acmrAfter / triangleCount,
+                 atvrBefore / triangleCount,
+                 atvrAfter / triangleCount,
+                 vertexCountBefore,
+                 vertexCountAfter);
+}
+
+auto ProcessPrimitive(const std::string& assetName,
+                      const fastgltf::Asset& asset,
+                      const TAssetBufferData& bufferData,
+                      std::size_t meshIndex,
+                      std::size_t primitiveIndex,
+                      const TAssetImportSettings& importSettings,
+                      TMeshOptimizationStatistics& meshOptimizationStatistics) -> TAssetMesh {
+
+    const auto& primitive = asset.meshes[meshIndex].primitives[primitiveIndex];
+
+    auto assetMeshData = std::make_shared<TAssetMeshData>();
+    GetVertices(asset, bufferData, primitive, *assetMeshData);
+    assetMeshData->Indices = GetIndices(asset, bufferData, primitive, assetMeshData->VertexPositions.size());
+    if (importSettings.OptimizeMeshes) {
+        // runs on 32 bit indices, deduplication can bring the vertex count below the 16 bit limit below
+        meshOptimizationStatistics = OptimizeMesh(*assetMeshData);
+    }
+
+    BuildLods(*assetMeshData, importSettings.GenerateLods);
+    BuildMeshlets(*assetMeshData);
+
+    if (!assetMeshData->PositionQuantization.has_value() && importSettings.QuantizePositions) {
+        assetMeshData->PositionQuantization = GetBoundsPositionQuantization(assetMeshData->VertexPositions);
+    }
+
     TAssetMesh assetMesh;
 
-    auto& fgAsset = loadResult.get();
+    assetMesh.Name = GetPrimitiveMeshName(assetName, asset, meshIndex, primitiveIndex);
+    assetMesh.InitialTransform = glm::mat4(1.0f);
+    // integer positions were read onto their grid by GetVertices already, float ones are quantized here when asked to
+    if (assetMeshData->PositionQuantization.has_value() && assetMeshData->VertexPositionFormat == TVertexPositionFormat::Float32x3) {
+        assetMeshData->QuantizedVertexPositions.reserve(assetMeshData->VertexPositions.size());
+        for (const auto& vertexPosition : assetMeshData->VertexPositions) {
+            assetMeshData->QuantizedVertexPositions.push_back(TGpuVertexPosition{
+                .Position = EncodePosition(vertexPosition, *assetMeshData->PositionQuantization),
+            });
+        }
+        assetMeshData->VertexPositionFormat = TVertexPositionFormat::Snorm16x4;
+    }
+
+    assetMesh.VertexPositionFormat = assetMeshData->VertexPositionFormat;
+    switch (assetMeshData->VertexPositionFormat) {
+        case TVertexPositionFormat::Snorm16x4:
+            assetMesh.VertexPositions = std::as_bytes(std::span(assetMeshData->QuantizedVertexPositions));
+            break;
+        case TVertexPositionFormat::Snorm8x4:
+            assetMesh.VertexPositions = std::as_bytes(std::span(assetMeshData->QuantizedByteVertexPositions));
+            break;
+        default:
+            assetMesh.VertexPositions = std::as_bytes(std::span(assetMeshData->VertexPositions));
+            break;
+    }
+
+    if (assetMeshData->PositionQuantization.has_value()) {
+        assetMeshData->VertexPositions = {};
+        assetMesh.PositionDequantization = GetPositionDequantizationMatrix(*assetMeshData->PositionQuantization);
+    } else {
+        assetMesh.PositionDequantization = glm::mat4(1.0f);
+    }
+    assetMesh.VertexNormalUvTangents = assetMeshData->VertexNormalUvTangents;
+    assetMesh.Lods = assetMeshData->Lods;
+    assetMesh.Meshlets = assetMeshData->Meshlets;
+    assetMesh.MeshletVertices = assetMeshData->MeshletVertices;
+    assetMesh.MeshletTriangles = assetMeshData->MeshletTriangles;
+
+    // 16 bit indices halve the index stream whenever every vertex is addressable with them,
+    // the renderer keeps them in a mega buffer of their own
+    if (assetMeshData->VertexNormalUvTangents.size() <= std::numeric_limits<uint16_t>::max() + 1) {
+        assetMeshData->ShortIndices.assign(assetMeshData->Indices.begin(), assetMeshData->Indices.end());
+        assetMeshData->Indices = {};
+        assetMesh.Indices = std::as_bytes(std::span(assetMeshData->ShortIndices));
+        assetMesh.IndexElementType = TIndexElementType::UnsignedShort;
+    } else {
+        assetMesh.Indices = std::as_bytes(std::span(assetMeshData->Indices));
+        assetMesh.IndexElementType = TIndexElementType::UnsignedInteger;
+    }
+
+    assetMesh.MaterialName = primitive.materialIndex.has_value()
+        ? GetSafeResourceName(assetName.data(), asset.materials[primitive.materialIndex.value()].name.data(), "material", primitive.materialIndex.value())
+        : DefaultAssetMaterialName;
+    assetMesh.Storage = std::move(assetMeshData);
+
+    return assetMesh;
+}
+
+// glTF requires it, but not every exporter writes it, there is nothing to index, optimize or draw without it
+auto HasPositionAttribute(const fastgltf::Primitive& primitive) -> bool {
 
-    ProcessTextures();
-    ProcessMaterials();
-    ProcessMeshes();
-    ProcessNodes();
+    return primitive.findAttribute("POSITION") != primitive.attributes.end();
 }
 
-auto GetAssetMesh(const std::string& assetMeshName) -> TAssetMesh& {
+// every primitive is an independent task, flatten them first so that large meshes don't serialize the pool,
+// primitives without positions are left out here, so that neither hashing nor processing ever sees them
+auto GetPrimitiveIndices(const std::string& assetName,
+                         const fastgltf::Asset& asset) -> std::vector<std::pair<std::size_t, std::size_t>> {
+
+    std::vector<std::pair<std::size_t, std::size_t>> primitiveIndices;
+    for (std::size_t meshIndex = 0; meshIndex < asset.meshes.size(); ++meshIndex) {
+        for (std::size_t primitiveIndex = 0; primitiveIndex < asset.meshes[meshIndex].primitives.size(); ++primitiveIndex) {
+            if (!HasPositionAttribute(asset.meshes[meshIndex].primitives[primitiveIndex])) {
+                spdlog::warn("Assets: Skipping {}, it has no POSITION attribute", GetPrimitiveMeshName(assetName, asset, meshIndex, primitiveIndex));
+                continue;
+            }
+
+            primitiveIndices.emplace_back(meshIndex, primitiveIndex);
+        }
+    }
+
+    return primitiveIndices;
+}
+
+// primitives which are unchanged since the previous import are left out
+auto ProcessMeshes(const std::string& assetName,
+                   const fastgltf::Asset& asset,
+                   const TAssetBufferData& bufferData,
+                   std::span<const std::pair<std::size_t, std::size_t>> primitiveIndices,
+                   const TAssetImportSettings& importSettings,
+                   const TAssetSourceHashes& previousSourceHashes,
+                   const TAssetSourceHashes& sourceHashes) -> std::vector<TAssetMesh> {
+
+    std::vector<TAssetMesh> assetMeshes(primitiveIndices.size());
+    std::vector<TMeshOptimizationStatistics> meshOptimizationStatistics(primitiveIndices.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), assetMeshes.begin(), assetMeshes.end(), [&](TAssetMesh& assetMesh) {
+
+        const auto assetMeshIndex = static_cast<std::size_t>(&assetMesh - assetMeshes.data());
+        const auto [meshIndex, primitiveIndex] = primitiveIndices[assetMeshIndex];
+        if (IsSourceUnchanged(previousSourceHashes.Meshes, sourceHashes.Meshes, GetPrimitiveMeshName(assetName, asset, meshIndex, primitiveIndex))) {
+            return;
+        }
+
+        assetMesh = ProcessPrimitive(assetName, asset, bufferData, meshIndex, primitiveIndex, importSettings, meshOptimizationStatistics[assetMeshIndex]);
+    });
+
+    // keep the statistics aligned with the meshes while dropping the skipped ones
+    std::size_t processedMeshCount = 0;
+    for (std::size_t assetMeshIndex = 0; assetMeshIndex < assetMeshes.size(); ++assetMeshIndex) {
+        if (assetMeshes[assetMeshIndex].Name.empty()) {
+            continue;
+        }
+
+        if (processedMeshCount != assetMeshIndex) {
+            assetMeshes[processedMeshCount] = std::move(assetMeshes[assetMeshIndex]);
+            meshOptimizationStatistics[processedMeshCount] = meshOptimizationStatistics[assetMeshIndex];
+        }
+        processedMeshCount++;
+    }
+    assetMeshes.resize(processedMeshCount);
+    meshOptimizationStatistics.resize(processedMeshCount);
+
+    if (importSettings.OptimizeMeshes) {
+        LogMeshOptimizationStatistics(assetName, assetMeshes, meshOptimizationStatistics);
+    }
+
+    return assetMeshes;
+}
+
+// translation, rotation and scale accessors of EXT_mesh_gpu_instancing, missing ones stay at identity
+auto GetInstanceMatrices(const fastgltf::Asset& asset,
+                         const TAssetBufferData& bufferData,
+                         const fastgltf::Node& node) -> std::vector<glm::mat4> {
+
+    std::vector<glm::mat4> instanceMatrices;
+    if (node.instancingAttributes.empty()) {
+        return instanceMatrices;
+    }
+
+    const auto findInstancingAccessor = [&](std::string_view attributeName) -> const fastgltf::Accessor* {
+        const auto attribute = std::ranges::find_if(node.instancingAttributes, [&](const fastgltf::Attribute& instancingAttribute) {
+            return std::string_view(instancingAttribute.name) == attributeName;
+        });
+        return attribute != node.instancingAttributes.end()
+            ? &asset.accessors[attribute->accessorIndex]
+            : nullptr;
+    };
+
+    const auto* translationAccessor = findInstancingAccessor("TRANSLATION");
+    const auto* rotationAccessor = findInstancingAccessor("ROTATION");
+    const auto* scaleAccessor = findInstancingAccessor("SCALE");
+
+    // all accessors of a node have the same count
+    const auto instanceCount = translationAccessor != nullptr ? translationAccessor->count
+        : rotationAccessor != nullptr ? rotationAccessor->count
+        : scaleAccessor != nullptr ? scaleAccessor->count
+        : 0;
+
+    std::vector<glm::vec3> translations(instanceCount, glm::vec3(0.0f));
+    std::vector<glm::quat> rotations(instanceCount, glm::identity<glm::quat>());
+    std::vector<glm::vec3> scales(instanceCount, glm::vec3(1.0f));
+
+    const auto bufferDataAdapter = TAssetBufferDataAdapter{bufferData};
+    if (translationAccessor != nullptr && translationAccessor->count == instanceCount) {
+        fastgltf::copyFromAccessor<glm::vec3>(asset, *translationAccessor, translations.data(), bufferDataAdapter);
+    }
+    if (rotationAccessor != nullptr && rotationAccessor->count == instanceCount) {
+        // glTF stores quaternions as xyzw, glm::quat wants wxyz when constructed from components
+        fastgltf::iterateAccessorWithIndex<glm::vec4>(asset, *rotationAccessor, [&](glm::vec4 rotation, std::size_t index) {
+            rotations[index] = glm::quat(rotation.w, rotation.x, rotation.y, rotation.z);
+        }, bufferDataAdapter);
+    }
+    if (scaleAccessor != nullptr && scaleAccessor->count == instanceCount) {
+        fastgltf::copyFromAccessor<glm::vec3>(asset, *scaleAccessor, scales.data(), bufferDataAdapter);
+    }
+
+    instanceMatrices.reserve(instanceCount);
+    for (std::size_t instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex) {
+        instanceMatrices.push_back(glm::translate(glm::mat4(1.0f), translations[instanceIndex]) *
+                                   glm::mat4_cast(rotations[instanceIndex]) *
+                                   glm::scale(glm::mat4(1.0f), scales[instanceIndex]));
+    }
+
+    return instanceMatrices;
+}
+
+auto ProcessNodes(const std::string& assetName,
+                  const fastgltf::Asset& asset,
+                  const TAssetBufferData& bufferData) -> std::vector<TAssetMeshInstance> {
+
+    std::vector<TAssetMeshInstance> assetMeshInstances;
+    if (asset.scenes.empty()) {
+        return assetMeshInstances;
+    }
+
+    const auto sceneIndex = asset.defaultScene.value_or(0);
+    fastgltf::iterateSceneNodes(asset, sceneIndex, fastgltf::math::fmat4x4(), [&](const fastgltf::Node& node, fastgltf::math::fmat4x4 nodeMatrix) {
+
+        if (!node.meshIndex.has_value()) {
+            return;
+        }
+
+        const auto meshIndex = node.meshIndex.value();
+        const auto& mesh = asset.meshes[meshIndex];
+        const auto instanceMatrices = GetInstanceMatrices(asset, bufferData, node);
+        for (std::size_t primitiveIndex = 0; primitiveIndex < mesh.primitives.size(); ++primitiveIndex) {
+            const auto& primitive = mesh.primitives[primitiveIndex];
+            if (!HasPositionAttribute(primitive)) {
+                continue;
+            }
+
+            assetMeshInstances.push_back(TAssetMeshInstance{
+                .MeshName = GetPrimitiveMeshName(assetName, asset, meshIndex, primitiveIndex),
+                .MaterialName = primitive.materialIndex.has_value()
+                    ? GetSafeResourceName(assetName.data(), asset.materials[primitive.materialIndex.value()].name.data(), "material", primitive.materialIndex.value())
+                    : DefaultAssetMaterialName,
+                .WorldMatrix = glm::make_mat4(&nodeMatrix[0][0]),
+                .InstanceMatrices = instanceMatrices,
+            });
+        }
+    });
+
+    return assetMeshInstances;
+}
+
+// only the range of the buffer view the accessor reads from, large buffer views are often shared by many primitives
+auto HashAccessorSource(const fastgltf::Asset& asset,
+                        const TAssetBufferData& bufferData,
+                        const fastgltf::Accessor& accessor) -> uint64_t {
+
+    auto sourceHash = HashCombine(HashCombine(accessor.count, static_cast<uint64_t>(accessor.type)),
+                                  static_cast<uint64_t>(accessor.componentType));
+    sourceHash = HashCombine(sourceHash, accessor.normalized ? 1 : 0);
+    sourceHash = HashCombine(sourceHash, accessor.sparse.has_value() ? accessor.sparse->count : 0);
+    if (!accessor.bufferViewIndex.has_value() || accessor.count == 0) {
+        return sourceHash;
+    }
+
+    const auto& bufferView = asset.bufferViews[accessor.bufferViewIndex.value()];
+    const auto bufferViewBytes = TAssetBufferDataAdapter{bufferData}(asset, accessor.bufferViewIndex.value());
+    const auto elementSize = fastgltf::getElementByteSize(accessor.type, accessor.componentType);
+    const auto stride = bufferView.byteStride.value_or(elementSize);
+    const auto byteOffset = std::min(accessor.byteOffset, bufferViewBytes.size());
+    const auto byteCount = std::min((accessor.count - 1) * stride + elementSize, bufferViewBytes.size() - byteOffset);
+
+    return HashCombine(sourceHash, HashBytes(bufferViewBytes.subspan(byteOffset, byteCount)));
+}
+
+auto HashPrimitiveSource(const fastgltf::Asset& asset,
+                         const TAssetBufferData& bufferData,
+                         const fastgltf::Primitive& primitive) -> uint64_t {
+
+    auto sourceHash = HashCombine(static_cast<uint64_t>(primitive.type), primitive.materialIndex.value_or(SIZE_MAX));
+    for (const auto& attribute : primitive.attributes) {
+        sourceHash = HashCombine(sourceHash, HashBytes(std::as_bytes(std::span(attribute.name.data(), attribute.name.size()))));
+        sourceHash = HashCombine(sourceHash, HashAccessorSource(asset, bufferData, asset.accessors[attribute.accessorIndex]));
+    }
+
+    if (primitive.indicesAccessor.has_value()) {
+        sourceHash = HashCombine(sourceHash, HashAccessorSource(asset, bufferData, asset.accessors[primitive.indicesAccessor.value()]));
+    }
+
+    return sourceHash;
+}
+
+auto HashImageSources(const std::string& assetName,
+                      const fastgltf::Asset& asset,
+                      const TAssetBufferData& bufferData) -> phmap::flat_hash_map<std::string, uint64_t> {
+
+    std::vector<uint64_t> imageSourceHashes(asset.images.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), imageSourceHashes.begin(), imageSourceHashes.end(), [&](uint64_t& imageSourceHash) {
+
+        const auto imageIndex = static_cast<std::size_t>(&imageSourceHash - imageSourceHashes.data());
+        imageSourceHash = HashBytes(GetImageBytes(asset, bufferData, imageIndex));
+    });
+
+    phmap::flat_hash_map<std::string, uint64_t> sourceHashes;
+    for (std::size_t imageIndex = 0; imageIndex < imageSourceHashes.size(); ++imageIndex) {
+        sourceHashes[GetSafeResourceName(assetName.data(), asset.images[imageIndex].name.data(), "image", imageIndex)] = imageSourceHashes[imageIndex];
+    }
+
+    return sourceHashes;
+}
+
+auto HashMeshSources(const std::string& assetName,
+                     const fastgltf::Asset& asset,
+                     const TAssetBufferData& bufferData,
+                     std::span<const std::pair<std::size_t, std::size_t>> primitiveIndices) -> phmap::flat_hash_map<std::string, uint64_t> {
+
+    std::vector<uint64_t> meshSourceHashes(primitiveIndices.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), meshSourceHashes.begin(), meshSourceHashes.end(), [&](uint64_t& meshSourceHash) {
+
+        const auto [meshIndex, primitiveIndex] = primitiveIndices[static_cast<std::size_t>(&meshSourceHash - meshSourceHashes.data())];
+        meshSourceHash = HashPrimitiveSource(asset, bufferData, asset.meshes[meshIndex].primitives[primitiveIndex]);
+    });
+
+    phmap::flat_hash_map<std::string, uint64_t> sourceHashes;
+    for (std::size_t primitiveIndex = 0; primitiveIndex < primitiveIndices.size(); ++primitiveIndex) {
+        const auto [meshIndex, meshPrimitiveIndex] = primitiveIndices[primitiveIndex];
+        sourceHashes[GetPrimitiveMeshName(assetName, asset, meshIndex, meshPrimitiveIndex)] = meshSourceHashes[primitiveIndex];
+    }
+
+    return sourceHashes;
+}
+
+// everything an import produced, built on a worker thread and handed to the main thread as a whole,
+// a reload carries only the images and meshes whose source changed
+// import settings change the cooked result, so they are part of the cache key
+auto GetMeshCacheHash(uint64_t contentHash,
+                      const TAssetImportSettings& importSettings) -> uint64_t {
+
+    auto hash = HashCombine(contentHash, importSettings.OptimizeMeshes ? 1 : 0);
+    hash = HashCombine(hash, importSettings.GenerateLods ? 1 : 0);
+    return HashCombine(hash, importSettings.QuantizePositions ? 1 : 0);
+}
+
+struct TImportedAsset {
+    std::vector<TAssetImage> Images;
+    std::vector<TAssetMesh> Meshes;
+    std::vector<std::pair<std::string, TAssetMaterial>> Materials;
+    std::vector<TAssetMeshInstance> MeshInstances;
+    // hashed on the worker, publishing only looks them up
+    std::vector<uint64_t> ImageContentHashes;
+    std::vector<uint64_t> MeshContentHashes;
+    // the description the import read from, a reload parses a new one
+    std::shared_ptr<const fastgltf::Asset> Asset;
+    uint64_t ContentHash;
+    TAssetImportSettings ImportSettings;
+    TAssetSourceHashes SourceHashes;
+};
+
+// touches no asset globals, safe to run off the main thread
+auto ImportParsedAsset(const std::string& assetName,
+                       const TScannedAssetSource& scannedAssetSource,
+                       uint64_t contentHash,
+                       const TAssetImportSettings& importSettings) -> std::expected<TImportedAsset, std::string> {
+
+    const auto& filePath = scannedAssetSource.FilePath;
+    const auto& fgAsset = *scannedAssetSource.Asset;
+
+    // each stage fans its images, materials or primitives out over the pool, the stages themselves are
+    // issued from this thread, nesting them as pool tasks could starve the pool on small core counts
+    TImportedAsset importedAsset;
+    importedAsset.Asset = scannedAssetSource.Asset;
+    importedAsset.ContentHash = contentHash;
+    importedAsset.ImportSettings = importSettings;
+
+    // settings change every cooked resource, nothing of the previous import can be kept then
+    const auto previousSourceHashes = scannedAssetSource.ImportSettings == importSettings
+        ? scannedAssetSource.SourceHashes
+        : TAssetSourceHashes{};
+
+    // images are not cooked, they are mapped, hashed and decoded by every import, apart from the meshes
+    {
+        std::vector<std::size_t> imageIndices(fgAsset.images.size());
+        std::iota(imageIndices.begin(), imageIndices.end(), std::size_t(0));
+
+        auto imageDataResult = LoadAssetBufferData(filePath, fgAsset, {}, imageIndices);
+        if (!imageDataResult) {
+            return std::unexpected(imageDataResult.error());
+        }
+
+        importedAsset.SourceHashes.Images = HashImageSources(assetName, fgAsset, *imageDataResult);
+        importedAsset.Images = ProcessImages(assetName, fgAsset, *imageDataResult, previousSourceHashes, importedAsset.SourceHashes);
+    }
+
+    // the content hash covers the files, the key is known before anything of the meshes is read,
+    // a hit neither maps their buffers nor decodes or hashes them
+    const auto meshCacheHash = GetMeshCacheHash(contentHash, importSettings);
+    const auto meshCacheFilePath = GetMeshCacheFilePath(filePath, meshCacheHash);
+    auto cookedAssetResult = ReadMeshCache(meshCacheFilePath, meshCacheHash);
+    if (cookedAssetResult) {
+        importedAsset.Meshes = std::move(cookedAssetResult->Meshes);
+        importedAsset.Materials = std::move(cookedAssetResult->Materials);
+        importedAsset.MeshInstances = std::move(cookedAssetResult->MeshInstances);
+        for (std::size_t meshIndex = 0; meshIndex < importedAsset.Meshes.size(); ++meshIndex) {
+            importedAsset.SourceHashes.Meshes[importedAsset.Meshes[meshIndex].Name] = cookedAssetResult->MeshSourceHashes[meshIndex];
+        }
+    } else {
+        spdlog::info(cookedAssetResult.error());
+
+        // the buffers are mapped for as long as the meshes are processed
+        const auto primitiveIndices = GetPrimitiveIndices(assetName, fgAsset);
+        std::vector<std::size_t> bufferViewIndices;
+        for (const auto [meshIndex, primitiveIndex] : primitiveIndices) {
+            AddPrimitiveBufferViewIndices(fgAsset, fgAsset.meshes[meshIndex].primitives[primitiveIndex], bufferViewIndices);
+        }
+        AddInstancingBufferViewIndices(fgAsset, bufferViewIndices);
+
+        auto bufferDataResult = LoadAssetBufferData(filePath, fgAsset, bufferViewIndices, {});
+        if (!bufferDataResult) {
+            return std::unexpected(bufferDataResult.error());
+        }
+
+        const auto& bufferData = *bufferDataResult;
+        importedAsset.SourceHashes.Meshes = HashMeshSources(assetName, fgAsset, bufferData, primitiveIndices);
+        importedAsset.Materials = ProcessMaterials(assetName, fgAsset);
+        importedAsset.Meshes = ProcessMeshes(assetName, fgAsset, bufferData, primitiveIndices, importSettings, previousSourceHashes, importedAsset.SourceHashes);
+        importedAsset.MeshInstances = ProcessNodes(assetName, fgAsset, bufferData);
+
+        // a reload which skipped unchanged primitives has no complete set of meshes to cache,
+        // archived assets ship their cache inside the archive, there is no directory to write one next to them
+        if (importedAsset.Meshes.size() == importedAsset.SourceHashes.Meshes.size() && !FindArchivedAssetFile(filePath).has_value()) {
+            std::vector<uint64_t> meshSourceHashes;
+            meshSourceHashes.reserve(importedAsset.Meshes.size());
+            for (const auto& assetMesh : importedAsset.Meshes) {
+                meshSourceHashes.push_back(importedAsset.SourceHashes.Meshes.at(assetMesh.Name));
+            }
+
+            auto writeResult = WriteMeshCache(meshCacheFilePath, meshCacheHash, importedAsset.Meshes, meshSourceHashes, importedAsset.Materials, importedAsset.MeshInstances);
+            if (!writeResult) {
+                spdlog::warn(writeResult.error());
+            }
+        }
+    }
+
+    importedAsset.ImageContentHashes.resize(importedAsset.Images.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), importedAsset.Images.begin(), importedAsset.Images.end(), [&](const TAssetImage& assetImage) {
+
+        const auto imageIndex = static_cast<std::size_t>(&assetImage - importedAsset.Images.data());
+        importedAsset.ImageContentHashes[imageIndex] = HashAssetImageContent(assetImage);
+    });
+
+    importedAsset.MeshContentHashes.resize(importedAsset.Meshes.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), importedAsset.Meshes.begin(), importedAsset.Meshes.end(), [&](const TAssetMesh& assetMesh) {
+
+        const auto meshIndex = static_cast<std::size_t>(&assetMesh - importedAsset.Meshes.data());
+        importedAsset.MeshContentHashes[meshIndex] = HashAssetMeshContent(assetMesh);
+    });
+
+    return importedAsset;
+}
+
+// images, materials and meshes LoadAssetMeshesAsync asked for, in the order they are published
+struct TImportedAssetResources {
+    std::vector<TAssetImage> Images;
+    std::vector<std::pair<std::string, TAssetMaterial>> Materials;
+    std::vector<TAssetMesh> Meshes;
+    std::vector<uint64_t> ImageContentHashes;
+    std::vector<uint64_t> MeshContentHashes;
+    TAssetImportSettings ImportSettings;
+};
+
+// touches no asset globals, safe to run off the main thread, maps only the buffer views of the primitives and the images,
+// the mesh cache covers whole imports, it is neither read nor written here
+auto ImportAssetResources(const std::string& assetName,
+                          const TScannedAssetSource& scannedAssetSource,
+                          std::span<const std::pair<std::size_t, std::size_t>> primitiveIndices,
+                          std::span<const std::size_t> materialIndices,
+                          std::span<const std::size_t> imageIndices,
+                          const TAssetImportSettings& importSettings) -> std::expected<TImportedAssetResources, std::string> {
+
+    const auto& fgAsset = *scannedAssetSource.Asset;
+
+    std::vector<std::size_t> bufferViewIndices;
+    for (const auto [meshIndex, primitiveIndex] : primitiveIndices) {
+        AddPrimitiveBufferViewIndices(fgAsset, fgAsset.meshes[meshIndex].primitives[primitiveIndex], bufferViewIndices);
+    }
+
+    auto bufferDataResult = LoadAssetBufferData(scannedAssetSource.FilePath, fgAsset, bufferViewIndices, imageIndices);
+    if (!bufferDataResult) {
+        return std::unexpected(bufferDataResult.error());
+    }
+
+    const auto& bufferData = *bufferDataResult;
+    TImportedAssetResources importedResources;
+    importedResources.ImportSettings = importSettings;
+
+    const auto imageUsages = GetImageUsages(fgAsset);
+    importedResources.Images.resize(imageIndices.size());
+    importedResources.ImageContentHashes.resize(imageIndices.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), importedResources.Images.begin(), importedResources.Images.end(), [&](TAssetImage& assetImage) {
+
+        const auto assetImageIndex = static_cast<std::size_t>(&assetImage - importedResources.Images.data());
+        const auto imageIndex = imageIndices[assetImageIndex];
+        ProcessImage(assetName, fgAsset, bufferData, imageIndex, imageUsages[imageIndex], assetImage);
+        importedResources.ImageContentHashes[assetImageIndex] = HashAssetImageContent(assetImage);
+    });
+
+    importedResources.Materials.reserve(materialIndices.size());
+    for (const auto materialIndex : materialIndices) {
+        importedResources.Materials.push_back(ProcessMaterial(assetName, fgAsset, materialIndex));
+    }
+
+    importedResources.Meshes = ProcessMeshes(assetName, fgAsset, bufferData, primitiveIndices, importSettings, {}, {});
+    importedResources.MeshContentHashes.resize(importedResources.Meshes.size());
+    std::for_each(poolstl::par.on(*g_assetThreadPool), importedResources.Meshes.begin(), importedResources.Meshes.end(), [&](const TAssetMesh& assetMesh) {
+
+        const auto meshIndex = static_cast<std::size_t>(&assetMesh - importedResources.Meshes.data());
+        importedResources.MeshContentHashes[meshIndex] = HashAssetMeshContent(assetMesh);
+    });
+
+    return importedResources;
+}
+
+// works from the description ScanAsset parsed, the buffers and images are mapped again for every import
+auto ImportAsset(const std::string& assetName,
+                 const TScannedAssetSource& scannedAssetSource,
+                 const TAssetImportSettings& importSettings) -> std::expected<TImportedAsset, std::string> {
+
+    const auto contentHash = HashAssetSource(scannedAssetSource.FilePath, *scannedAssetSource.Asset);
+    if (!contentHash.has_value()) {
+        return std::unexpected(std::format("Assets: Unable to hash {}", scannedAssetSource.FilePath.string()));
+    }
+
+    return ImportParsedAsset(assetName, scannedAssetSource, *contentHash, importSettings);
+}
+
+// the cooked mesh cache maps the streams back in without any processing, cheap enough for the main thread
+auto ReadCachedAssetMesh(const TAssetResidencySource& source,
+                         const std::string& assetMeshName) -> std::optional<TAssetMesh> {
+
+    auto scannedAsset = g_scannedAssets.find(source.AssetName);
+    if (scannedAsset == g_scannedAssets.end()) {
+        return std::nullopt;
+    }
+
+    const auto meshCacheHash = GetMeshCacheHash(scannedAsset->second.ContentHash, source.ImportSettings);
+    auto cookedAssetResult = ReadMeshCache(GetMeshCacheFilePath(scannedAsset->second.FilePath, meshCacheHash), meshCacheHash);
+    if (!cookedAssetResult) {
+        return std::nullopt;
+    }
+
+    for (auto& cookedAssetMesh : cookedAssetResult->Meshes) {
+        if (cookedAssetMesh.Name == assetMeshName) {
+            return std::move(cookedAssetMesh);
+        }
+    }
+
+    return std::nullopt;
+}
+
+// touches no asset globals, maps and decodes only the buffer views of the one primitive
+auto ReimportAssetMesh(const std::filesystem::path& assetFilePath,
+                       const fastgltf::Asset& asset,
+                       const TAssetResidencySource& source,
+                       const std::string& assetMeshName) -> std::expected<TAssetMesh, std::string> {
+
+    for (std::size_t meshIndex = 0; meshIndex < asset.meshes.size(); ++meshIndex) {
+        for (std::size_t primitiveIndex = 0; primitiveIndex < asset.meshes[meshIndex].primitives.size(); ++primitiveIndex) {
+            if (GetPrimitiveMeshName(source.AssetName, asset, meshIndex, primitiveIndex) != assetMeshName) {
+                continue;
+            }
+
+            std::vector<std::size_t> bufferViewIndices;
+            AddPrimitiveBufferViewIndices(asset, asset.meshes[meshIndex].primitives[primitiveIndex], bufferViewIndices);
+            auto bufferDataResult = LoadAssetBufferData(assetFilePath, asset, bufferViewIndices, {});
+            if (!bufferDataResult) {
+                return std::unexpected(bufferDataResult.error());
+            }
+
+            TMeshOptimizationStatistics meshOptimizationStatistics = {};
+            return ProcessPrimitive(source.AssetName, asset, *bufferDataResult, meshIndex, primitiveIndex, source.ImportSettings, meshOptimizationStatistics);
+        }
+    }
+
+    return std::unexpected(std::format("Assets: {} no longer has mesh {}", source.AssetName, assetMeshName));
+}
+
+// touches no asset globals, maps only the one image
+auto ReimportAssetImage(const std::filesystem::path& assetFilePath,
+                        const fastgltf::Asset& asset,
+                        const TAssetResidencySource& source,
+                        const std::string& assetImageName) -> std::expected<TAssetImage, std::string> {
+
+    for (std::size_t imageIndex = 0; imageIndex < asset.images.size(); ++imageIndex) {
+        if (GetSafeResourceName(source.AssetName.data(), asset.images[imageIndex].name.data(), "image", imageIndex) != assetImageName) {
+            continue;
+        }
+
+        const std::array imageIndices = {imageIndex};
+        auto bufferDataResult = LoadAssetBufferData(assetFilePath, asset, {}, imageIndices);
+        if (!bufferDataResult) {
+            return std::unexpected(bufferDataResult.error());
+        }
+
+        TAssetImage assetImage;
+        ProcessImage(source.AssetName, asset, *bufferDataResult, imageIndex, GetImageUsages(asset)[imageIndex], assetImage);
+        return assetImage;
+    }
+
+    return std::unexpected(std::format("Assets: {} no longer has image {}", source.AssetName, assetImageName));
+}
+
+// the payload is re-imported from the scanned description on the load thread and put back on the main thread, unless it was
+// released or made resident otherwise in the meantime, every payload is queued once
+auto QueueAssetMeshReload(std::size_t contentIndex,
+                          const TAssetResidencySource& source,
+                          const std::string& assetMeshName) -> void {
+
+    auto scannedAsset = g_scannedAssets.find(source.AssetName);
+    if (scannedAsset == g_scannedAssets.end() || !g_pendingAssetMeshReloads.insert(contentIndex).second) {
+        return;
+    }
+
+    g_assetLoadThreadPool.submit_detach([contentIndex, source, assetFilePath = scannedAsset->second.FilePath, asset = scannedAsset->second.Asset, assetMeshName]() {
+
+        auto assetMeshResult = std::make_shared<std::expected<TAssetMesh, std::string>>(ReimportAssetMesh(assetFilePath, *asset, source, assetMeshName));
+        EnqueueOnMainThread([contentIndex, assetMeshResult]() {
+
+            g_pendingAssetMeshReloads.erase(contentIndex);
+            if (!*assetMeshResult) {
+                spdlog::error(assetMeshResult->error());
+                return;
+            }
+
+            const auto residencyKey = TAssetResidencyKey{TAssetResidencyKind::Mesh, contentIndex};
+            if (!g_assetMeshes.HasContent(contentIndex) || !g_assetResidency.IsEvicted(residencyKey)) {
+                return;
+            }
+
+            auto& assetMesh = g_assetMeshes.GetContent(contentIndex);
+            assetMesh = std::move(**assetMeshResult);
+            g_assetResidency.MarkReloaded(residencyKey, GetAssetMeshContentSize(assetMesh));
+        });
+    });
+}
+
+auto QueueAssetImageReload(std::size_t contentIndex,
+                           const TAssetResidencySource& source,
+                           const std::string& assetImageName) -> void {
+
+    auto scannedAsset = g_scannedAssets.find(source.AssetName);
+    if (scannedAsset == g_scannedAssets.end() || !g_pendingAssetImageReloads.insert(contentIndex).second) {
+        return;
+    }
+
+    g_assetLoadThreadPool.submit_detach([contentIndex, source, assetFilePath = scannedAsset->second.FilePath, asset = scannedAsset->second.Asset, assetImageName]() {
+
+        auto assetImageResult = std::make_shared<std::expected<TAssetImage, std::string>>(ReimportAssetImage(assetFilePath, *asset, source, assetImageName));
+        EnqueueOnMainThread([contentIndex, assetImageResult]() {
+
+            g_pendingAssetImageReloads.erase(contentIndex);
+            if (!*assetImageResult) {
+                spdlog::error(assetImageResult->error());
+                return;
+            }
+
+            const auto residencyKey = TAssetResidencyKey{TAssetResidencyKind::Image, contentIndex};
+            if (!g_assetImages.HasContent(contentIndex) || !g_assetResidency.IsEvicted(residencyKey)) {
+                return;
+            }
+
+            auto& assetImage = g_assetImages.GetContent(contentIndex);
+            assetImage = std::move(**assetImageResult);
+            g_assetResidency.MarkReloaded(residencyKey, GetAssetImageContentSize(assetImage));
+        });
+    });
+}
+
+// an evicted mesh is mapped back from the mesh cache right away, without one it is queued and resident on a later frame
+auto EnsureAssetMeshResident(std::size_t contentIndex) -> bool {
+
+    const auto residencyKey = TAssetResidencyKey{TAssetResidencyKind::Mesh, contentIndex};
+    if (!g_assetResidency.IsEvicted(residencyKey)) {
+        g_assetResidency.Touch(residencyKey);
+        return true;
+    }
+
+    auto& assetMesh = g_assetMeshes.GetContent(contentIndex);
+    const auto& source = g_assetResidency.GetSource(residencyKey);
+    if (auto cachedAssetMesh = ReadCachedAssetMesh(source, assetMesh.Name); cachedAssetMesh.has_value()) {
+        assetMesh = std::move(*cachedAssetMesh);
+        g_assetResidency.MarkReloaded(residencyKey, GetAssetMeshContentSize(assetMesh));
+        return true;
+    }
+
+    QueueAssetMeshReload(contentIndex, source, assetMesh.Name);
+    return false;
+}
+
+// images are not cooked, an evicted one is always queued
+auto EnsureAssetImageResident(std::size_t contentIndex) -> bool {
+
+    const auto residencyKey = TAssetResidencyKey{TAssetResidencyKind::Image, contentIndex};
+    if (!g_assetResidency.IsEvicted(residencyKey)) {
+        g_assetResidency.Touch(residencyKey);
+        return true;
+    }
+
+    QueueAssetImageReload(contentIndex, g_assetResidency.GetSource(residencyKey), g_assetImages.GetContent(contentIndex).Name);
+    return false;
+}
+
+// names, levels of detail and dimensions stay, only the streams and pixels are dropped
+auto EvictAssets() -> void {
+
+    for (const auto& residencyKey : g_assetResidency.CollectEvictions()) {
+        if (residencyKey.Kind == TAssetResidencyKind::Mesh) {
+            auto& assetMesh = g_assetMeshes.GetContent(residencyKey.ContentIndex);
+            // the levels of detail view the same storage as the streams, they are copied out before it goes
+            auto lods = std::make_shared<const std::vector<TAssetMeshLod>>(assetMesh.Lods.begin(), assetMesh.Lods.end());
+            assetMesh.VertexPositions = {};
+            assetMesh.VertexNormalUvTangents = {};
+            assetMesh.Lods = *lods;
+            assetMesh.Meshlets = {};
+            assetMesh.MeshletVertices = {};
+            assetMesh.MeshletTriangles = {};
+            assetMesh.Indices = {};
+            assetMesh.Storage = std::move(lods);
+        } else {
+            g_assetImages.GetContent(residencyKey.ContentIndex).Pixels.reset();
+        }
+    }
+}
+
+auto StoreAssetImage(const std::string& assetName,
+                     const std::string& assetImageName,
+                     TAssetImage&& assetImage,
+                     uint64_t contentHash) -> void {
+
+    // duplicates are compared byte by byte against the published payload, which has to be resident for that,
+    // an evicted one is not waited for, the compare fails and the image is published as a payload of its own
+    if (auto publishedContentIndex = g_assetImages.FindContentIndex(contentHash); publishedContentIndex.has_value()) {
+        EnsureAssetImageResident(*publishedContentIndex);
+    }
+
+    const auto assetImageId = g_assetImages.Intern(assetImageName);
+    const auto previousContentIndex = g_assetImages.GetContentIndex(assetImageId);
+    const auto contentSize = GetAssetImageContentSize(assetImage);
+    if (g_assetImages.Publish(assetImageName, std::move(assetImage), contentHash, IsSameAssetImageContent)) {
+        g_assetDeduplicationReport.DeduplicatedImageCount++;
+        g_assetDeduplicationReport.SavedImageBytes += contentSize;
+    } else {
+        g_assetResidency.Track({TAssetResidencyKind::Image, *g_assetImages.GetContentIndex(assetImageId)}, contentSize, TAssetResidencySource{
+            .AssetName = assetName,
+        });
+    }
+
+    if (previousContentIndex.has_value() && !g_assetImages.HasContent(*previousContentIndex)) {
+        g_assetResidency.Untrack({TAssetResidencyKind::Image, *previousContentIndex});
+    }
+}
+
+auto StoreAssetMesh(const std::string& assetName,
+                    const TAssetImportSettings& importSettings,
+                    const std::string& assetMeshName,
+                    TAssetMesh&& assetMesh,
+                    uint64_t contentHash) -> void {
+
+    // as in StoreAssetImage, only that an evicted mesh with a mesh cache entry is mapped back in and compared
+    if (auto publishedContentIndex = g_assetMeshes.FindContentIndex(contentHash); publishedContentIndex.has_value()) {
+        EnsureAssetMeshResident(*publishedContentIndex);
+    }
+
+    const auto assetMeshId = g_assetMeshes.Intern(assetMeshName);
+    const auto previousContentIndex = g_assetMeshes.GetContentIndex(assetMeshId);
+    const auto contentSize = GetAssetMeshContentSize(assetMesh);
+    if (g_assetMeshes.Publish(assetMeshName, std::move(assetMesh), contentHash, IsSameAssetMeshContent)) {
+        g_assetDeduplicationReport.DeduplicatedMeshCount++;
+        g_assetDeduplicationReport.SavedMeshBytes += contentSize;
+    } else {
+        g_assetResidency.Track({TAssetResidencyKind::Mesh, *g_assetMeshes.GetContentIndex(assetMeshId)}, contentSize, TAssetResidencySource{
+            .AssetName = assetName,
+            .ImportSettings = importSettings,
+        });
+    }
+
+    if (previousContentIndex.has_value() && !g_assetMeshes.HasContent(*previousContentIndex)) {
+        g_assetResidency.Untrack({TAssetResidencyKind::Mesh, *previousContentIndex});
+    }
+}
+
+auto GetCanonicalAssetImageId(const std::optional<std::string>& assetImageName) -> TAssetImageId {
+
+    return assetImageName.has_value()
+        ? GetCanonicalAssetImageId(g_assetImages.Intern(*assetImageName))
+        : TAssetImageId::Invalid;
+}
+
+// materials are equal when their factors are and their images resolve to the same canonical image,
+// which is why they have to be stored after the images they reference
+auto HashAssetMaterialContent(const TAssetMaterial& assetMaterial) -> uint64_t {
+
+    return HashCombine(
+        HashCombine(HashBytes(std::as_bytes(std::span(&assetMaterial.BaseColor, 1))),
+                    static_cast<uint64_t>(GetCanonicalAssetImageId(assetMaterial.BaseColorImageName))),
+        static_cast<uint64_t>(GetCanonicalAssetImageId(assetMaterial.NormalImageName)));
+}
+
+auto StoreAssetMaterial(const std::string& assetMaterialName,
+                        TAssetMaterial&& assetMaterial) -> void {
+
+    const auto contentHash = HashAssetMaterialContent(assetMaterial);
+    const auto isSameContent = [](const TAssetMaterial& material, const TAssetMaterial& otherMaterial) {
+        return material.BaseColor == otherMaterial.BaseColor &&
+               GetCanonicalAssetImageId(material.BaseColorImageName) == GetCanonicalAssetImageId(otherMaterial.BaseColorImageName) &&
+               GetCanonicalAssetImageId(material.NormalImageName) == GetCanonicalAssetImageId(otherMaterial.NormalImageName);
+    };
+
+    if (g_assetMaterials.Publish(assetMaterialName, std::move(assetMaterial), contentHash, isSameContent)) {
+        g_assetDeduplicationReport.DeduplicatedMaterialCount++;
+    }
+}
+
+auto StoreDefaultAssetMaterial() -> void {
+
+    if (!g_assetMaterials.Contains(DefaultAssetMaterialName)) {
+        StoreAssetMaterial(DefaultAssetMaterialName, TAssetMaterial{
+            .BaseColor = glm::vec4{1.0f},
+        });
+    }
+}
+
+// main thread only, makes the asset visible to GetAsset*
+auto PublishAsset(const std::string& assetName,
+                  TImportedAsset&& importedAsset) -> void {
+
+    const auto previousDeduplicationReport = g_assetDeduplicationReport;
+
+    // merge in source order, so the result does not depend on which task finished first,
+    // resources which are published already and whose payload did not change are left alone, the others are
+    // replaced and reported as reloaded, so that the renderer swaps their GPU resources
+    const auto reloadedImageCount = g_reloadedAssetImageIds.size();
+    for (std::size_t imageIndex = 0; imageIndex < importedAsset.Images.size(); ++imageIndex) {
+        auto assetImageName = importedAsset.Images[imageIndex].Name;
+        const auto assetImageId = g_assetImages.Intern(assetImageName);
+        const auto isReload = g_assetImages.Contains(assetImageId);
+        if (isReload && g_assetImages.GetContentHash(assetImageId) == importedAsset.ImageContentHashes[imageIndex]) {
+            continue;
+        }
+
+        StoreAssetImage(assetName, assetImageName, std::move(importedAsset.Images[imageIndex]), importedAsset.ImageContentHashes[imageIndex]);
+        if (isReload) {
+            g_reloadedAssetImageIds.push_back(assetImageId);
+        }
+    }
+
+    const auto isImageReloaded = [&](const std::optional<std::string>& assetImageName) {
+        return assetImageName.has_value() &&
+               std::find(g_reloadedAssetImageIds.begin() + reloadedImageCount, g_reloadedAssetImageIds.end(), g_assetImages.Intern(*assetImageName)) != g_reloadedAssetImageIds.end();
+    };
+
+    for (auto& [assetMaterialName, assetMaterial] : importedAsset.Materials) {
+        const auto assetMaterialId = g_assetMaterials.Intern(assetMaterialName);
+        const auto isReload = g_assetMaterials.Contains(assetMaterialId);
+        // a material keeps its hash when only the pixels of its images change, it still needs new textures
+        if (isReload &&
+            g_assetMaterials.GetContentHash(assetMaterialId) == HashAssetMaterialContent(assetMaterial) &&
+            !isImageReloaded(assetMaterial.BaseColorImageName) &&
+            !isImageReloaded(assetMaterial.NormalImageName)) {
+            continue;
+        }
+
+        StoreAssetMaterial(assetMaterialName, std::move(assetMaterial));
+        if (isReload) {
+            g_reloadedAssetMaterialIds.push_back(assetMaterialId);
+        }
+    }
+
+    StoreDefaultAssetMaterial();
+
+    for (std::size_t meshIndex = 0; meshIndex < importedAsset.Meshes.size(); ++meshIndex) {
+        auto assetMeshName = importedAsset.Meshes[meshIndex].Name;
+        const auto assetMeshId = g_assetMeshes.Intern(assetMeshName);
+        const auto isReload = g_assetMeshes.Contains(assetMeshId);
+        if (isReload && g_assetMeshes.GetContentHash(assetMeshId) == importedAsset.MeshContentHashes[meshIndex]) {
+            continue;
+        }
+
+        StoreAssetMesh(assetName, importedAsset.ImportSettings, assetMeshName, std::move(importedAsset.Meshes[meshIndex]), importedAsset.MeshContentHashes[meshIndex]);
+        if (isReload) {
+            g_reloadedAssetMeshIds.push_back(assetMeshId);
+        }
+    }
+
+    g_assetMeshInstances[assetName] = std::move(importedAsset.MeshInstances);
+
+    const auto savedBytes = (g_assetDeduplicationReport.SavedMeshBytes - previousDeduplicationReport.SavedMeshBytes) +
+                            (g_assetDeduplicationReport.SavedImageBytes - previousDeduplicationReport.SavedImageBytes);
+    spdlog::info("Assets: Deduplicated {} meshes, {} images and {} materials of {}, saving {:.2f} MiB",
+                 g_assetDeduplicationReport.DeduplicatedMeshCount - previousDeduplicationReport.DeduplicatedMeshCount,
+                 g_assetDeduplicationReport.DeduplicatedImageCount - previousDeduplicationReport.DeduplicatedImageCount,
+                 g_assetDeduplicationReport.DeduplicatedMaterialCount - previousDeduplicationReport.DeduplicatedMaterialCount,
+                 assetName,
+                 static_cast<double>(savedBytes) / (1024.0 * 1024.0));
+
+    if (auto scannedAsset = g_scannedAssets.find(assetName); scannedAsset != g_scannedAssets.end()) {
+        scannedAsset->second.Asset = std::move(importedAsset.Asset);
+        scannedAsset->second.ContentHash = importedAsset.ContentHash;
+        scannedAsset->second.ImportSettings = importedAsset.ImportSettings;
+        scannedAsset->second.SourceHashes = std::move(importedAsset.SourceHashes);
+    }
+}
+
+// main thread only, images before the materials referencing them, resources published meanwhile are left alone
+auto PublishAssetResources(const std::string& assetName,
+                           TImportedAssetResources&& importedResources) -> void {
+
+    for (std::size_t imageIndex = 0; imageIndex < importedResources.Images.size(); ++imageIndex) {
+        auto assetImageName = importedResources.Images[imageIndex].Name;
+        if (!g_assetImages.Contains(assetImageName)) {
+            StoreAssetImage(assetName, assetImageName, std::move(importedResources.Images[imageIndex]), importedResources.ImageContentHashes[imageIndex]);
+        }
+    }
+
+    for (auto& [assetMaterialName, assetMaterial] : importedResources.Materials) {
+        if (!g_assetMaterials.Contains(assetMaterialName)) {
+            StoreAssetMaterial(assetMaterialName, std::move(assetMaterial));
+        }
+    }
+
+    StoreDefaultAssetMaterial();
+
+    for (std::size_t meshIndex = 0; meshIndex < importedResources.Meshes.size(); ++meshIndex) {
+        auto assetMeshName = importedResources.Meshes[meshIndex].Name;
+        if (!g_assetMeshes.Contains(assetMeshName)) {
+            StoreAssetMesh(assetName, importedResources.ImportSettings, assetMeshName, std::move(importedResources.Meshes[meshIndex]), importedResources.MeshContentHashes[meshIndex]);
+        }
+    }
+}
+
+auto PublishAssetImage(const std::string& assetName,
+                       const TScannedAssetSource& scannedAssetSource,
+                       std::size_t imageIndex) -> bool {
+
+    const auto& asset = *scannedAssetSource.Asset;
+    const auto assetImageName = GetSafeResourceName(assetName.data(), asset.images[imageIndex].name.data(), "image", imageIndex);
+    if (g_assetImages.Contains(assetImageName)) {
+        return true;
+    }
+
+    const std::array imageIndices = {imageIndex};
+    auto bufferDataResult = LoadAssetBufferData(scannedAssetSource.FilePath, asset, {}, imageIndices);
+    if (!bufferDataResult) {
+        spdlog::error(bufferDataResult.error());
+        return false;
+    }
+
+    TAssetImage assetImage;
+    ProcessImage(assetName, asset, *bufferDataResult, imageIndex, GetImageUsages(asset)[imageIndex], assetImage);
+    const auto contentHash = HashAssetImageContent(assetImage);
+    StoreAssetImage(assetName, assetImageName, std::move(assetImage), contentHash);
+    return true;
+}
+
+auto PublishAssetMaterial(const std::string& assetName,
+                          const TScannedAssetSource& scannedAssetSource,
+                          std::size_t materialIndex) -> bool {
+
+    const auto& asset = *scannedAssetSource.Asset;
+    const auto& material = asset.materials[materialIndex];
+    for (const auto imageIndex : {GetMaterialImageIndex(asset, material.pbrData.baseColorTexture),
+                                  GetMaterialImageIndex(asset, material.normalTexture)}) {
+        if (imageIndex.has_value() && !PublishAssetImage(assetName, scannedAssetSource, imageIndex.value())) {
+            return false;
+        }
+    }
+
+    auto [assetMaterialName, assetMaterial] = ProcessMaterial(assetName, asset, materialIndex);
+    if (!g_assetMaterials.Contains(assetMaterialName)) {
+        StoreAssetMaterial(assetMaterialName, std::move(assetMaterial));
+    }
+
+    return true;
+}
+
+auto CreateAssetImage(const std::string& assetName,
+                      std::size_t imageIndex) -> bool {
+
+    auto scannedAsset = g_scannedAssets.find(assetName);
+    if (scannedAsset == g_scannedAssets.end()) {
+        spdlog::error("Assets: {} was not scanned", assetName);
+        return false;
+    }
+
+    if (imageIndex >= scannedAsset->second.Asset->images.size()) {
+        spdlog::error("Assets: {} has no image {}", assetName, imageIndex);
+        return false;
+    }
+
+    return PublishAssetImage(assetName, scannedAsset->second, imageIndex);
+}
+
+auto CreateAssetMaterial(const std::string& assetName,
+                         std::size_t materialIndex) -> bool {
+
+    auto scannedAsset = g_scannedAssets.find(assetName);
+    if (scannedAsset == g_scannedAssets.end()) {
+        spdlog::error("Assets: {} was not scanned", assetName);
+        return false;
+    }
+
+    if (materialIndex >= scannedAsset->second.Asset->materials.size()) {
+        spdlog::error("Assets: {} has no material {}", assetName, materialIndex);
+        return false;
+    }
+
+    return PublishAssetMaterial(assetName, scannedAsset->second, materialIndex);
+}
+
+auto CreateAssetMesh(const std::string& assetName,
+                     std::size_t meshIndex,
+                     const TAssetImportSettings& importSettings) -> bool {
+
+    auto scannedAsset = g_scannedAssets.find(assetName);
+    if (scannedAsset == g_scannedAssets.end()) {
+        spdlog::error("Assets: {} was not scanned", assetName);
+        return false;
+    }
+
+    const auto& scannedAssetSource = scannedAsset->second;
+    const auto& asset = *scannedAssetSource.Asset;
+    if (meshIndex >= asset.meshes.size()) {
+        spdlog::error("Assets: {} has no mesh {}", assetName, meshIndex);
+        return false;
+    }
+
+    StoreDefaultAssetMaterial();
+
+    // the primitives of the mesh often share their buffer views, they are mapped and decoded once for all of them
+    const auto& mesh = asset.meshes[meshIndex];
+    std::vector<std::size_t> bufferViewIndices;
+    for (const auto& primitive : mesh.primitives) {
+        if (HasPositionAttribute(primitive)) {
+            AddPrimitiveBufferViewIndices(asset, primitive, bufferViewIndices);
+        }
+    }
+
+    auto bufferDataResult = LoadAssetBufferData(scannedAssetSource.FilePath, asset, bufferViewIndices, {});
+    if (!bufferDataResult) {
+        spdlog::error(bufferDataResult.error());
+        return false;
+    }
+
+    for (std::size_t primitiveIndex = 0; primitiveIndex < mesh.primitives.size(); ++primitiveIndex) {
+        const auto& primitive = mesh.primitives[primitiveIndex];
+        if (primitive.materialIndex.has_value() && !PublishAssetMaterial(assetName, scannedAssetSource, primitive.materialIndex.value())) {
+            return false;
+        }
+
+        const auto assetMeshName = GetPrimitiveMeshName(assetName, asset, meshIndex, primitiveIndex);
+        if (!HasPositionAttribute(primitive) || g_assetMeshes.Contains(assetMeshName)) {
+            continue;
+        }
+
+        TMeshOptimizationStatistics meshOptimizationStatistics = {};
+        auto assetMesh = ProcessPrimitive(assetName, asset, *bufferDataResult, meshIndex, primitiveIndex, importSettings, meshOptimizationStatistics);
+        const auto contentHash = HashAssetMeshContent(assetMesh);
+        StoreAssetMesh(assetName, importSettings, assetMeshName, std::move(assetMesh), contentHash);
+    }
+
+    return true;
+}
+
+auto CreateAssetMesh(const std::string& assetName,
+                     const TAssetImportSettings& importSettings) -> bool {
+
+    auto importedAssetResult = ImportAsset(assetName, g_scannedAssets.at(assetName), importSettings);
+    if (!importedAssetResult) {
+        spdlog::error(importedAssetResult.error());
+        return false;
+    }
+
+    PublishAsset(assetName, std::move(*importedAssetResult));
+    return true;
+}
+
+auto LoadAssetAsync(const std::string& assetName,
+                    const TAssetImportSettings& importSettings,
+                    std::function<void()> onLoaded) -> std::shared_future<bool> {
+
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future().share();
+
+    // the source is copied here, ScanAsset may rehash g_scannedAssets while the import runs
+    g_assetLoadThreadPool.submit_detach([assetName, scannedAssetSource = g_scannedAssets.at(assetName), importSettings, onLoaded = std::move(onLoaded), promise]() mutable {
+
+        auto importedAssetResult = ImportAsset(assetName, scannedAssetSource, importSettings);
+        if (!importedAssetResult) {
+            spdlog::error(importedAssetResult.error());
+            promise->set_value(false);
+            return;
+        }
+
+        auto importedAsset = std::make_shared<TImportedAsset>(std::move(*importedAssetResult));
+        EnqueueOnMainThread([assetName, importedAsset, onLoaded = std::move(onLoaded), promise]() {
+            PublishAsset(assetName, std::move(*importedAsset));
+            if (onLoaded) {
+                onLoaded();
+            }
+            promise->set_value(true);
+        });
+    });
+
+    return future;
+}
+
+auto LoadAssetMeshInstances(const std::string& assetName) -> std::expected<std::vector<TAssetMeshInstance>, std::string> {
+
+    auto scannedAsset = g_scannedAssets.find(assetName);
+    if (scannedAsset == g_scannedAssets.end()) {
+        return std::unexpected(std::format("Assets: {} was not scanned", assetName));
+    }
+
+    const auto& asset = *scannedAsset->second.Asset;
+    std::vector<std::size_t> bufferViewIndices;
+    AddInstancingBufferViewIndices(asset, bufferViewIndices);
+
+    auto bufferDataResult = LoadAssetBufferData(scannedAsset->second.FilePath, asset, bufferViewIndices, {});
+    if (!bufferDataResult) {
+        return std::unexpected(bufferDataResult.error());
+    }
+
+    return ProcessNodes(assetName, asset, *bufferDataResult);
+}
+
+auto LoadAssetMeshesAsync(const std::string& assetName,
+                          std::span<const std::string> assetMeshNames,
+                          const TAssetImportSettings& importSettings) -> std::shared_future<bool> {
+
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future().share();
+
+    auto scannedAsset = g_scannedAssets.find(assetName);
+    if (scannedAsset == g_scannedAssets.end()) {
+        spdlog::error("Assets: {} was not scanned", assetName);
+        promise->set_value(false);
+        return future;
+    }
+
+    // what is left to import is resolved here, against the registries, which only the main thread touches
+    const auto& asset = *scannedAsset->second.Asset;
+    const phmap::flat_hash_set<std::string> requestedAssetMeshNames(assetMeshNames.begin(), assetMeshNames.end());
+    std::vector<std::pair<std::size_t, std::size_t>> primitiveIndices;
+    std::vector<std::size_t> materialIndices;
+    std::vector<std::size_t> imageIndices;
+    std::vector<std::string> importingAssetMaterialNames;
+    std::vector<std::string> importingAssetImageNames;
+
+    const auto addImage = [&](std::optional<std::size_t> imageIndex) {
+        if (!imageIndex.has_value()) {
+            return;
+        }
+
+        auto assetImageName = GetSafeResourceName(assetName.data(), asset.images[imageIndex.value()].name.data(), "image", imageIndex.value());
+        if (!g_assetImages.Contains(assetImageName) && g_importingAssetImageNames.insert(assetImageName).second) {
+            imageIndices.push_back(imageIndex.value());
+            importingAssetImageNames.push_back(std::move(assetImageName));
+        }
+    };
+
+    const auto addMaterial = [&](std::size_t materialIndex) {
+        auto assetMaterialName = GetSafeResourceName(assetName.data(), asset.materials[materialIndex].name.data(), "material", materialIndex);
+        std::erase(g_releasedAssetMaterialIds, g_assetMaterials.Intern(assetMaterialName));
+        if (g_assetMaterials.Contains(assetMaterialName) || !g_importingAssetMaterialNames.insert(assetMaterialName).second) {
+            return;
+        }
+
+        const auto& material = asset.materials[materialIndex];
+        addImage(GetMaterialImageIndex(asset, material.pbrData.baseColorTexture));
+        addImage(GetMaterialImageIndex(asset, material.normalTexture));
+        materialIndices.push_back(materialIndex);
+        importingAssetMaterialNames.push_back(std::move(assetMaterialName));
+    };
+
+    std::size_t foundMeshCount = 0;
+    for (std::size_t meshIndex = 0; meshIndex < asset.meshes.size(); ++meshIndex) {
+        for (std::size_t primitiveIndex = 0; primitiveIndex < asset.meshes[meshIndex].primitives.size(); ++primitiveIndex) {
+            const auto& primitive = asset.meshes[meshIndex].primitives[primitiveIndex];
+            const auto assetMeshName = GetPrimitiveMeshName(assetName, asset, meshIndex, primitiveIndex);
+            if (!HasPositionAttribute(primitive) || !requestedAssetMeshNames.contains(assetMeshName)) {
+                continue;
+            }
+
+            foundMeshCount++;
+
+            // requested again before the renderer took the release, the GPU resources are kept
+            std::erase(g_releasedAssetMeshIds, g_assetMeshes.Intern(assetMeshName));
+            if (primitive.materialIndex.has_value()) {
+                addMaterial(primitive.materialIndex.value());
+            }
+
+            if (!g_assetMeshes.Contains(assetMeshName)) {
+                primitiveIndices.emplace_back(meshIndex, primitiveIndex);
+            }
+        }
+    }
+
+    if (foundMeshCount < requestedAssetMeshNames.size()) {
+        spdlog::error("Assets: {} of the requested meshes are not part of {}", requestedAssetMeshNames.size() - foundMeshCount, assetName);
+    }
+
+    if (primitiveIndices.empty() && materialIndices.empty()) {
+        promise->set_value(true);
+        return future;
+    }
+
+    // the source is copied here, ScanAsset may rehash g_scannedAssets while the import runs
+    g_assetLoadThreadPool.submit_detach([assetName,
+                                         scannedAssetSource = scannedAsset->second,
+                                         primitiveIndices = std::move(primitiveIndices),
+                                         materialIndices = std::move(materialIndices),
+                                         imageIndices = std::move(imageIndices),
+                                         importingAssetMaterialNames = std::move(importingAssetMaterialNames),
+                                         importingAssetImageNames = std::move(importingAssetImageNames),
+                                         importSettings,
+                                         promise]() mutable {
+
+        auto importedResourcesResult = std::make_shared<std::expected<TImportedAssetResources, std::string>>(
+            ImportAssetResources(assetName, scannedAssetSource, primitiveIndices, materialIndices, imageIndices, importSettings));
+        EnqueueOnMainThread([assetName,
+                             importedResourcesResult,
+                             importingAssetMaterialNames = std::move(importingAssetMaterialNames),
+                             importingAssetImageNames = std::move(importingAssetImageNames),
+                             promise]() {
+
+            for (const auto& assetMaterialName : importingAssetMaterialNames) {
+                g_importingAssetMaterialNames.erase(assetMaterialName);
+            }
+            for (const auto& assetImageName : importingAssetImageNames) {
+                g_importingAssetImageNames.erase(assetImageName);
+            }
+
+            if (!*importedResourcesResult) {
+                spdlog::error(importedResourcesResult->error());
+                promise->set_value(false);
+                return;
+            }
+
+            PublishAssetResources(assetName, std::move(**importedResourcesResult));
+            promise->set_value(true);
+        });
+    });
+
+    return future;
+}
+
+// parses, hashes and imports on the load thread, an asset whose files did not change is left alone,
+// the json may have changed as well, the reload works from a description of its own, which replaces the scanned one
+auto ReloadAssetAsync(const std::string& assetName) -> void {
+
+    g_assetLoadThreadPool.submit_detach([assetName, scannedAssetSource = g_scannedAssets.at(assetName)]() mutable {
+
+        auto parseResult = ParseAssetDescription(scannedAssetSource.FilePath);
+        if (!parseResult) {
+            spdlog::error(parseResult.error());
+            return;
+        }
+
+        scannedAssetSource.Asset = std::move(*parseResult);
+        const auto contentHash = HashAssetSource(scannedAssetSource.FilePath, *scannedAssetSource.Asset);
+        if (!contentHash.has_value() || *contentHash == scannedAssetSource.ContentHash) {
+            return;
+        }
+
+        auto importedAssetResult = ImportParsedAsset(assetName, scannedAssetSource, *contentHash, scannedAssetSource.ImportSettings);
+        if (!importedAssetResult) {
+            spdlog::error(importedAssetResult.error());
+            return;
+        }
+
+        auto importedAsset = std::make_shared<TImportedAsset>(std::move(*importedAssetResult));
+        EnqueueOnMainThread([assetName, importedAsset]() {
+            PublishAsset(assetName, std::move(*importedAsset));
+            spdlog::info("Assets: Reloaded {}", assetName);
+        });
+    });
+}
+
+auto PollAssetFileChanges() -> void {
+
+    // an exporter writing the glTF and its buffers changes several files of an asset at once, it is reloaded once
+    std::vector<std::string> changedAssetNames;
+    for (const auto& changedFilePath : PollChangedFiles()) {
+        auto watchedAssetNames = g_assetNamesByWatchedFile.find(changedFilePath.string());
+        if (watchedAssetNames == g_assetNamesByWatchedFile.end()) {
+            continue;
+        }
+
+        for (const auto& assetName : watchedAssetNames->second) {
+            if (std::ranges::find(changedAssetNames, assetName) == changedAssetNames.end()) {
+                spdlog::info("Assets: {} changed, reloading {}", changedFilePath.string(), assetName);
+                changedAssetNames.push_back(assetName);
+            }
+        }
+    }
+
+    for (const auto& changedAssetName : changedAssetNames) {
+        ReloadAssetAsync(changedAssetName);
+    }
+}
+
+auto TakeReloadedAssetMeshIds() -> std::vector<TAssetMeshId> {
+
+    return std::exchange(g_reloadedAssetMeshIds, {});
+}
+
+auto TakeReloadedAssetMaterialIds() -> std::vector<TAssetMaterialId> {
+
+    return std::exchange(g_reloadedAssetMaterialIds, {});
+}
+
+auto TakeReloadedAssetImageIds() -> std::vector<TAssetImageId> {
+
+    return std::exchange(g_reloadedAssetImageIds, {});
+}
+
+auto ReleaseAssetMesh(TAssetMeshId assetMeshId) -> void {
+
+    g_releasedAssetMeshIds.push_back(assetMeshId);
+}
+
+auto ReleaseAssetMaterial(TAssetMaterialId assetMaterialId) -> void {
+
+    g_releasedAssetMaterialIds.push_back(assetMaterialId);
+}
+
+auto TakeReleasedAssetMeshIds() -> std::vector<TAssetMeshId> {
+
+    return std::exchange(g_releasedAssetMeshIds, {});
+}
+
+auto TakeReleasedAssetMaterialIds() -> std::vector<TAssetMaterialId> {
+
+    return std::exchange(g_releasedAssetMaterialIds, {});
+}
+
+auto WaitForAssetLoads() -> void {
+
+    g_assetLoadThreadPool.wait_for_tasks();
+}
+
+auto SetAssetThreadCount(std::size_t threadCount) -> void {
+
+    // imports in flight hold on to the pool, let them finish first
+    g_assetLoadThreadPool.wait_for_tasks();
+    g_assetThreadPool = std::make_unique<task_thread_pool::task_thread_pool>(static_cast<unsigned int>(threadCount));
+}
+
+auto GetAssetMeshId(const std::string& assetMeshName) -> TAssetMeshId {
+
+    return g_assetMeshes.Intern(assetMeshName);
+}
+
+auto GetAssetMaterialId(const std::string& assetMaterialName) -> TAssetMaterialId {
+
+    return g_assetMaterials.Intern(assetMaterialName);
+}
+
+auto GetAssetImageId(const std::string& assetImageName) -> TAssetImageId {
+
+    return g_assetImages.Intern(assetImageName);
+}
+
+auto GetAssetMeshName(TAssetMeshId assetMeshId) -> const std::string& {
+
+    return g_assetMeshes.GetName(assetMeshId);
+}
+
+auto GetAssetMaterialName(TAssetMaterialId assetMaterialId) -> const std::string& {
+
+    return g_assetMaterials.GetName(assetMaterialId);
+}
+
+auto GetAssetImageName(TAssetImageId assetImageId) -> const std::string& {
+
+    return g_assetImages.GetName(assetImageId);
+}
+
+auto GetCanonicalAssetMeshId(TAssetMeshId assetMeshId) -> TAssetMeshId {
+
+    return g_assetMeshes.Contains(assetMeshId)
+        ? g_assetMeshes.GetCanonicalId(assetMeshId)
+        : assetMeshId;
+}
+
+auto GetCanonicalAssetMaterialId(TAssetMaterialId assetMaterialId) -> TAssetMaterialId {
+
+    return g_assetMaterials.Contains(assetMaterialId)
+        ? g_assetMaterials.GetCanonicalId(assetMaterialId)
+        : assetMaterialId;
+}
+
+auto GetCanonicalAssetImageId(TAssetImageId assetImageId) -> TAssetImageId {
+
+    return g_assetImages.Contains(assetImageId)
+        ? g_assetImages.GetCanonicalId(assetImageId)
+        : assetImageId;
+}
+
+auto GetAssetDeduplicationReport() -> const TAssetDeduplicationReport& {
+
+    return g_assetDeduplicationReport;
+}
+
+auto HasAssetMesh(TAssetMeshId assetMeshId) -> bool {
+
+    return g_assetMeshes.Contains(assetMeshId);
+}
+
+auto HasAssetMaterial(TAssetMaterialId assetMaterialId) -> bool {
+
+    return g_assetMaterials.Contains(assetMaterialId);
+}
+
+auto HasAssetImage(TAssetImageId assetImageId) -> bool {
+
+    return g_assetImages.Contains(assetImageId);
+}
+
+auto SetAssetMemoryBudget(std::size_t budgetInBytes) -> void {
+
+    g_assetResidency.SetBudget(budgetInBytes);
+    EvictAssets();
+}
+
+auto GetAssetMemoryStatistics() -> const TAssetMemoryStatistics& {
+
+    return g_assetResidency.GetStatistics();
+}
+
+auto MarkAssetMeshUploaded(TAssetMeshId assetMeshId) -> void {
+
+    if (auto contentIndex = g_assetMeshes.GetContentIndex(assetMeshId); contentIndex.has_value()) {
+        g_assetResidency.MarkUploaded({TAssetResidencyKind::Mesh, *contentIndex});
+        EvictAssets();
+    }
+}
+
+auto MakeAssetMeshResident(TAssetMeshId assetMeshId) -> bool {
+
+    auto contentIndex = g_assetMeshes.GetContentIndex(assetMeshId);
+    return !contentIndex.has_value() || EnsureAssetMeshResident(*contentIndex);
+}
+
+auto MakeAssetImageResident(TAssetImageId assetImageId) -> bool {
+
+    auto contentIndex = g_assetImages.GetContentIndex(assetImageId);
+    return !contentIndex.has_value() || EnsureAssetImageResident(*contentIndex);
+}
+
+auto MarkAssetImageUploaded(TAssetImageId assetImageId) -> void {
+
+    if (auto contentIndex = g_assetImages.GetContentIndex(assetImageId); contentIndex.has_value()) {
+        g_assetResidency.MarkUploaded({TAssetResidencyKind::Image, *contentIndex});
+        EvictAssets();
+    }
+}
+
+auto MarkAssetMeshUnloaded(TAssetMeshId assetMeshId) -> void {
+
+    if (auto contentIndex = g_assetMeshes.GetContentIndex(assetMeshId); contentIndex.has_value()) {
+        g_assetResidency.MarkUnloaded({TAssetResidencyKind::Mesh, *contentIndex});
+        EvictAssets();
+    }
+}
+
+auto MarkAssetImageUnloaded(TAssetImageId assetImageId) -> void {
+
+    if (auto contentIndex = g_assetImages.GetContentIndex(assetImageId); contentIndex.has_value()) {
+        g_assetResidency.MarkUnloaded({TAssetResidencyKind::Image, *contentIndex});
+        EvictAssets();
+    }
+}
+
+auto GetAssetMesh(TAssetMeshId assetMeshId) -> TAssetMesh& {
+
+    if (auto contentIndex = g_assetMeshes.GetContentIndex(assetMeshId); contentIndex.has_value()) {
+        EnsureAssetMeshResident(*contentIndex);
+    }
+
+    return g_assetMeshes.Get(assetMeshId);
+}
+
+auto GetAssetMaterial(TAssetMaterialId assetMaterialId) -> TAssetMaterial& {
+
+    return g_assetMaterials.Get(assetMaterialId);
+}
+
+auto GetAssetImage(TAssetImageId assetImageId) -> TAssetImage& {
+
+    if (auto contentIndex = g_assetImages.GetContentIndex(assetImageId); contentIndex.has_value()) {
+        EnsureAssetImageResident(*contentIndex);
+    }
 
-    assert(!assetMeshName.empty() || g_assetMeshes.contains(assetMeshName));
-    return g_assetMeshes.at(assetMeshName);
+    return g_assetImages.Get(assetImageId);
 }
 
-auto GetAssetMaterial(const std::string& assetMaterialName) -> TAssetMaterial& {
+auto GetAssetMeshInstances(const std::string& assetName) -> std::vector<TAssetMeshInstance>& {
 
-    assert(!assetMaterialName.empty() || g_assetMaterials.contains(assetMaterialName));
-    return g_assetMaterials.at(assetMaterialName);
+    assert(!assetName.empty() && g_assetMeshInstances.contains(assetName));
+    return g_assetMeshInstances.at(assetName);
 }
\ No newline at end of file
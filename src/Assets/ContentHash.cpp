@@ -0,0 +1,69 @@
+#include <Hephaestus/Assets/ContentHash.hpp>
+#include <Hephaestus/Assets/AssetFileSystem.hpp>
+
+#include <array>
+#include <cstring>
+
+constexpr uint64_t HashPrime = 0x9E3779B97F4A7C15ull;
+
+constexpr auto HashMix(uint64_t value) -> uint64_t {
+
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+auto HashBytes(std::span<const std::byte> bytes) -> uint64_t {
+
+    // four independent lanes keep the multipliers busy, this runs close to memory bandwidth
+    std::array<uint64_t, 4> lanes = {
+        HashPrime,
+        HashPrime * 2,
+        HashPrime * 3,
+        HashPrime * 4
+    };
+
+    std::size_t offset = 0;
+    for (; offset + sizeof(uint64_t) * lanes.size() <= bytes.size(); offset += sizeof(uint64_t) * lanes.size()) {
+        for (std::size_t lane = 0; lane < lanes.size(); ++lane) {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes.data() + offset + lane * sizeof(uint64_t), sizeof(uint64_t));
+            lanes[lane] = (lanes[lane] ^ HashMix(word)) * HashPrime;
+        }
+    }
+
+    uint64_t tail = 0;
+    for (std::size_t lane = 0; offset < bytes.size(); ++offset, ++lane) {
+        tail |= static_cast<uint64_t>(bytes[offset]) << ((lane % sizeof(uint64_t)) * 8);
+        if (lane % sizeof(uint64_t) == sizeof(uint64_t) - 1) {
+            lanes[0] = (lanes[0] ^ HashMix(tail)) * HashPrime;
+            tail = 0;
+        }
+    }
+
+    auto hash = HashMix(bytes.size() ^ tail);
+    for (auto lane : lanes) {
+        hash = HashCombine(hash, lane);
+    }
+
+    return hash;
+}
+
+auto HashCombine(uint64_t hash,
+                 uint64_t value) -> uint64_t {
+
+    return HashMix(hash ^ (HashMix(value) + HashPrime + (hash << 6) + (hash >> 2)));
+}
+
+auto HashFile(const std::filesystem::path& filePath) -> std::optional<uint64_t> {
+
+    auto mappedFileResult = MapAssetFile(filePath);
+    if (!mappedFileResult) {
+        return std::nullopt;
+    }
+
+    return HashBytes((*mappedFileResult)->Bytes);
+}
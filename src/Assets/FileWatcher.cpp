@@ -0,0 +1,114 @@
+#include <Hephaestus/Assets/FileWatcher.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <parallel_hashmap/phmap.h>
+
+#include <spdlog/spdlog.h>
+
+#if defined(__linux__)
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+int32_t g_fileWatcherDescriptor = -1;
+// watched directories by watch descriptor
+phmap::flat_hash_map<int32_t, std::filesystem::path> g_watchedDirectories = {};
+phmap::flat_hash_set<std::string> g_watchedFiles = {};
+
+auto WatchFile(const std::filesystem::path& filePath) -> void {
+
+    if (g_fileWatcherDescriptor < 0) {
+        g_fileWatcherDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (g_fileWatcherDescriptor < 0) {
+            spdlog::warn("FileWatcher: Unable to initialize inotify: {}", std::strerror(errno));
+            return;
+        }
+    }
+
+    std::error_code errorCode;
+    const auto absoluteFilePath = std::filesystem::weakly_canonical(filePath, errorCode);
+    if (errorCode) {
+        spdlog::warn("FileWatcher: Unable to resolve {}: {}", filePath.string(), errorCode.message());
+        return;
+    }
+
+    // adding a watch for a directory which is watched already returns its existing descriptor
+    const auto directoryPath = absoluteFilePath.parent_path();
+    const auto watchDescriptor = inotify_add_watch(g_fileWatcherDescriptor, directoryPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchDescriptor < 0) {
+        spdlog::warn("FileWatcher: Unable to watch {}: {}", directoryPath.string(), std::strerror(errno));
+        return;
+    }
+
+    g_watchedDirectories[watchDescriptor] = directoryPath;
+    g_watchedFiles.insert(absoluteFilePath.string());
+}
+
+auto PollChangedFiles() -> std::vector<std::filesystem::path> {
+
+    std::vector<std::filesystem::path> changedFiles;
+    if (g_fileWatcherDescriptor < 0) {
+        return changedFiles;
+    }
+
+    alignas(inotify_event) std::array<char, 4096> events = {};
+    while (true) {
+        const auto bytesRead = read(g_fileWatcherDescriptor, events.data(), events.size());
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < bytesRead;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(events.data() + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            auto watchedDirectory = g_watchedDirectories.find(event->wd);
+            if (event->len == 0 || watchedDirectory == g_watchedDirectories.end()) {
+                continue;
+            }
+
+            auto changedFile = watchedDirectory->second / event->name;
+            if (g_watchedFiles.contains(changedFile.string()) && std::ranges::find(changedFiles, changedFile) == changedFiles.end()) {
+                changedFiles.push_back(std::move(changedFile));
+            }
+        }
+    }
+
+    return changedFiles;
+}
+
+auto StopWatchingFiles() -> void {
+
+    // closing the descriptor removes every watch added to it
+    if (g_fileWatcherDescriptor >= 0) {
+        close(g_fileWatcherDescriptor);
+        g_fileWatcherDescriptor = -1;
+    }
+
+    g_watchedDirectories.clear();
+    g_watchedFiles.clear();
+}
+
+#else
+
+auto WatchFile(const std::filesystem::path& filePath) -> void {
+
+    spdlog::debug("FileWatcher: Not supported on this platform, {} is not watched", filePath.string());
+}
+
+auto PollChangedFiles() -> std::vector<std::filesystem::path> {
+
+    return {};
+}
+
+auto StopWatchingFiles() -> void {
+
+}
+
+#endif
\ No newline at end of file
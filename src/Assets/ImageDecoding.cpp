@@ -0,0 +1,175 @@
+#include <Hephaestus/Assets/ImageDecoding.hpp>
+#include <Hephaestus/Assets/MipGeneration.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <memory>
+
+#include <ktx.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+constexpr std::array<uint8_t, 12> Ktx2Identifier = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+// VkFormat values of the block compressed formats a KTX2 file can carry without supercompression
+constexpr uint32_t VkFormatBc1RgbUnormBlock = 131;
+constexpr uint32_t VkFormatBc1RgbSrgbBlock = 132;
+constexpr uint32_t VkFormatBc1RgbaUnormBlock = 133;
+constexpr uint32_t VkFormatBc1RgbaSrgbBlock = 134;
+constexpr uint32_t VkFormatBc2UnormBlock = 135;
+constexpr uint32_t VkFormatBc2SrgbBlock = 136;
+constexpr uint32_t VkFormatBc3UnormBlock = 137;
+constexpr uint32_t VkFormatBc3SrgbBlock = 138;
+constexpr uint32_t VkFormatBc4UnormBlock = 139;
+constexpr uint32_t VkFormatBc4SnormBlock = 140;
+constexpr uint32_t VkFormatBc5UnormBlock = 141;
+constexpr uint32_t VkFormatBc5SnormBlock = 142;
+constexpr uint32_t VkFormatBc6HUfloatBlock = 143;
+constexpr uint32_t VkFormatBc6HSfloatBlock = 144;
+constexpr uint32_t VkFormatBc7UnormBlock = 145;
+constexpr uint32_t VkFormatBc7SrgbBlock = 146;
+
+constexpr auto VkFormatToFormat(uint32_t vkFormat) -> TFormat {
+    switch (vkFormat) {
+        case VkFormatBc1RgbUnormBlock: return TFormat::BC1_RGB_UNORM;
+        case VkFormatBc1RgbSrgbBlock: return TFormat::BC1_RGB_SRGB;
+        case VkFormatBc1RgbaUnormBlock: return TFormat::BC1_RGBA_UNORM;
+        case VkFormatBc1RgbaSrgbBlock: return TFormat::BC1_RGBA_SRGB;
+        case VkFormatBc2UnormBlock: return TFormat::BC2_RGBA_UNORM;
+        case VkFormatBc2SrgbBlock: return TFormat::BC2_RGBA_SRGB;
+        case VkFormatBc3UnormBlock: return TFormat::BC3_RGBA_UNORM;
+        case VkFormatBc3SrgbBlock: return TFormat::BC3_RGBA_SRGB;
+        case VkFormatBc4UnormBlock: return TFormat::BC4_R_UNORM;
+        case VkFormatBc4SnormBlock: return TFormat::BC4_R_SNORM;
+        case VkFormatBc5UnormBlock: return TFormat::BC5_RG_UNORM;
+        case VkFormatBc5SnormBlock: return TFormat::BC5_RG_SNORM;
+        case VkFormatBc6HUfloatBlock: return TFormat::BC6H_RGB_UFLOAT;
+        case VkFormatBc6HSfloatBlock: return TFormat::BC6H_RGB_SFLOAT;
+        case VkFormatBc7UnormBlock: return TFormat::BC7_RGBA_UNORM;
+        case VkFormatBc7SrgbBlock: return TFormat::BC7_RGBA_SRGB;
+        default: return TFormat::Undefined;
+    }
+}
+
+auto IsKtx2Image(std::span<const std::byte> imageBytes) -> bool {
+
+    return imageBytes.size() >= Ktx2Identifier.size() &&
+           std::memcmp(imageBytes.data(), Ktx2Identifier.data(), Ktx2Identifier.size()) == 0;
+}
+
+auto DecodeKtx2Image(std::span<const std::byte> imageBytes,
+                     TAssetImageUsage imageUsage,
+                     TAssetImage& assetImage) -> std::expected<void, std::string> {
+
+    ktxTexture2* texture = nullptr;
+    auto result = ktxTexture2_CreateFromMemory(reinterpret_cast<const ktx_uint8_t*>(imageBytes.data()),
+                                               imageBytes.size(),
+                                               KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+                                               &texture);
+    if (result != KTX_SUCCESS) {
+        return std::unexpected(std::format("Unable to read KTX2 image: {}", ktxErrorString(result)));
+    }
+
+    auto textureOwner = std::unique_ptr<ktxTexture2, decltype([](ktxTexture2* texturePointer) { ktxTexture2_Destroy(texturePointer); })>(texture);
+
+    if (texture->numDimensions != 2 || texture->numLayers > 1 || texture->numFaces > 1) {
+        return std::unexpected("Only 2D KTX2 images are supported");
+    }
+
+    const auto componentCount = ktxTexture2_GetNumComponents(texture);
+    auto format = TFormat::Undefined;
+    if (ktxTexture2_NeedsTranscoding(texture)) {
+
+        // BC4 and BC5 keep one and two channel data at full precision, BC7 for everything else
+        auto transcodeFormat = KTX_TTF_BC7_RGBA;
+        format = imageUsage == TAssetImageUsage::Color ? TFormat::BC7_RGBA_SRGB : TFormat::BC7_RGBA_UNORM;
+        if (imageUsage == TAssetImageUsage::Normal) {
+            transcodeFormat = KTX_TTF_BC5_RG;
+            format = TFormat::BC5_RG_UNORM;
+        } else if (componentCount == 1) {
+            transcodeFormat = KTX_TTF_BC4_R;
+            format = TFormat::BC4_R_UNORM;
+        }
+
+        result = ktxTexture2_TranscodeBasis(texture, transcodeFormat, 0);
+        if (result != KTX_SUCCESS) {
+            return std::unexpected(std::format("Unable to transcode KTX2 image: {}", ktxErrorString(result)));
+        }
+    } else {
+        format = VkFormatToFormat(texture->vkFormat);
+        if (format == TFormat::Undefined) {
+            return std::unexpected(std::format("KTX2 image has unsupported format {}", texture->vkFormat));
+        }
+    }
+
+    auto* baseTexture = ktxTexture(texture);
+    const auto dataSize = ktxTexture_GetDataSize(baseTexture);
+    auto* pixels = static_cast<std::byte*>(std::malloc(dataSize));
+    if (pixels == nullptr) {
+        return std::unexpected("Unable to allocate memory for KTX2 image");
+    }
+    std::memcpy(pixels, ktxTexture_GetData(baseTexture), dataSize);
+
+    assetImage.Width = static_cast<int32_t>(texture->baseWidth);
+    assetImage.Height = static_cast<int32_t>(texture->baseHeight);
+    assetImage.Components = static_cast<int32_t>(componentCount);
+    assetImage.Format = format;
+    assetImage.Levels.clear();
+    for (ktx_uint32_t level = 0; level < texture->numLevels; ++level) {
+
+        ktx_size_t levelOffset = 0;
+        ktxTexture_GetImageOffset(baseTexture, level, 0, 0, &levelOffset);
+        assetImage.Levels.push_back(TAssetImageLevel{
+            .Width = std::max(1, assetImage.Width >> level),
+            .Height = std::max(1, assetImage.Height >> level),
+            .Offset = levelOffset,
+            .Size = ktxTexture_GetImageSize(baseTexture, level),
+        });
+    }
+    assetImage.Pixels.reset(pixels);
+
+    return {};
+}
+
+auto DecodeImage(std::span<const std::byte> imageBytes,
+                 TAssetImageUsage imageUsage,
+                 TAssetImage& assetImage) -> std::expected<void, std::string> {
+
+    if (IsKtx2Image(imageBytes)) {
+        return DecodeKtx2Image(imageBytes, imageUsage, assetImage);
+    }
+
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t components = 0;
+    auto* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(imageBytes.data()),
+                                         static_cast<int32_t>(imageBytes.size()),
+                                         &width,
+                                         &height,
+                                         &components,
+                                         STBI_rgb_alpha);
+    if (pixels == nullptr) {
+        return std::unexpected(std::format("Unable to decode image: {}", stbi_failure_reason()));
+    }
+
+    assetImage.Width = width;
+    assetImage.Height = height;
+    assetImage.Components = STBI_rgb_alpha;
+    assetImage.Format = imageUsage == TAssetImageUsage::Color ? TFormat::R8G8B8A8_SRGB : TFormat::R8G8B8A8_UNORM;
+    assetImage.Levels = {
+        TAssetImageLevel{
+            .Width = width,
+            .Height = height,
+            .Offset = 0,
+            .Size = static_cast<std::size_t>(width) * height * STBI_rgb_alpha,
+        }
+    };
+    assetImage.Pixels.reset(reinterpret_cast<std::byte*>(pixels));
+
+    // runs on the decoding worker, the image arrives ready to upload with its full chain
+    return GenerateMipChain(assetImage);
+}
\ No newline at end of file
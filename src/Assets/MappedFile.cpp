@@ -0,0 +1,100 @@
+#include <Hephaestus/Assets/MappedFile.hpp>
+
+#include <format>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+TMappedFile::~TMappedFile() {
+
+#if defined(_WIN32)
+    if (_mapping != nullptr) {
+        UnmapViewOfFile(Bytes.data());
+        CloseHandle(_mapping);
+    }
+    if (_fileHandle != nullptr) {
+        CloseHandle(_fileHandle);
+    }
+#else
+    if (_mapping != nullptr) {
+        munmap(_mapping, Bytes.size());
+    }
+#endif
+}
+
+auto MapFile(const std::filesystem::path& filePath) -> std::expected<std::shared_ptr<const TMappedFile>, std::string> {
+
+    auto mappedFile = std::make_shared<TMappedFile>();
+
+#if defined(_WIN32)
+    auto fileHandle = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return std::unexpected(std::format("Unable to open {}", filePath.string()));
+    }
+    mappedFile->_fileHandle = fileHandle;
+
+    LARGE_INTEGER fileSize = {};
+    GetFileSizeEx(fileHandle, &fileSize);
+    if (fileSize.QuadPart == 0) {
+        return mappedFile;
+    }
+
+    auto mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        return std::unexpected(std::format("Unable to map {}", filePath.string()));
+    }
+    mappedFile->_mapping = mapping;
+
+    auto* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        return std::unexpected(std::format("Unable to map {}", filePath.string()));
+    }
+
+    mappedFile->Bytes = {static_cast<const std::byte*>(view), static_cast<std::size_t>(fileSize.QuadPart)};
+#else
+    auto fileDescriptor = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0) {
+        return std::unexpected(std::format("Unable to open {}", filePath.string()));
+    }
+
+    struct stat fileStatus = {};
+    if (fstat(fileDescriptor, &fileStatus) != 0) {
+        close(fileDescriptor);
+        return std::unexpected(std::format("Unable to stat {}", filePath.string()));
+    }
+
+    const auto fileSize = static_cast<std::size_t>(fileStatus.st_size);
+    if (fileSize == 0) {
+        close(fileDescriptor);
+        return mappedFile;
+    }
+
+    auto* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (mapping == MAP_FAILED) {
+        return std::unexpected(std::format("Unable to map {}", filePath.string()));
+    }
+
+    mappedFile->_mapping = mapping;
+    mappedFile->Bytes = {static_cast<const std::byte*>(mapping), fileSize};
+#endif
+
+    return mappedFile;
+}
+
+auto ViewMappedFile(std::shared_ptr<const TMappedFile> mappedFile,
+                    std::span<const std::byte> bytes) -> std::shared_ptr<const TMappedFile> {
+
+    auto viewedMappedFile = std::make_shared<TMappedFile>();
+    viewedMappedFile->Bytes = bytes;
+    viewedMappedFile->_viewedMappedFile = std::move(mappedFile);
+    return viewedMappedFile;
+}
\ No newline at end of file
@@ -0,0 +1,450 @@
+#include <Hephaestus/Assets/MeshCache.hpp>
+#include <Hephaestus/Assets/AssetFileSystem.hpp>
+#include <Hephaestus/RHI/VertexTypes.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+constexpr uint32_t MeshCacheMagic = 0x48434D48; // "HMCH"
+constexpr uint32_t MeshCacheFormatVersion = 11;
+constexpr uint64_t MeshCacheStreamAlignment = 16;
+constexpr uint64_t MeshCacheNoString = std::numeric_limits<uint64_t>::max();
+constexpr auto MeshCacheFileExtension = ".meshcache";
+
+/*
+ * File layout, all offsets are relative to the start of the file
+ *
+ * TMeshCacheHeader
+ * TMeshCacheMesh[MeshCount]
+ * TMeshCacheMaterial[MaterialCount]
+ * TMeshCacheMeshInstance[MeshInstanceCount]
+ * char[StringsSize]
+ * vertex position, vertex normal/uv/tangent, lod, meshlet, meshlet vertex, meshlet triangle and index streams per mesh,
+ * instance matrix streams per mesh instance, each aligned to MeshCacheStreamAlignment
+ */
+
+struct TMeshCacheString {
+    uint64_t Offset;
+    uint64_t Length;
+};
+
+struct TMeshCacheHeader {
+    uint32_t Magic;
+    uint32_t FormatVersion;
+    uint64_t SourceHash;
+    uint64_t FileSize;
+    uint32_t VertexPositionStride;
+    uint32_t VertexNormalUvTangentStride;
+    uint32_t MeshCount;
+    uint32_t MaterialCount;
+    uint32_t MeshInstanceCount;
+    uint32_t MeshletStride;
+    uint32_t LodStride;
+    uint32_t Reserved;
+    uint64_t StringsOffset;
+    uint64_t StringsSize;
+};
+
+struct TMeshCacheMesh {
+    TMeshCacheString Name;
+    TMeshCacheString MaterialName;
+    glm::mat4 InitialTransform;
+    glm::mat4 PositionDequantization;
+    uint64_t SourceHash;
+    uint64_t VertexPositionsOffset;
+    uint64_t VertexNormalUvTangentsOffset;
+    uint64_t VertexCount;
+    uint64_t LodsOffset;
+    uint64_t LodCount;
+    uint64_t MeshletsOffset;
+    uint64_t MeshletCount;
+    uint64_t MeshletVerticesOffset;
+    uint64_t MeshletVertexCount;
+    uint64_t MeshletTrianglesOffset;
+    uint64_t MeshletTrianglesSize;
+    uint64_t IndicesOffset;
+    uint64_t IndexCount;
+    TIndexElementType IndexElementType;
+    TVertexPositionFormat VertexPositionFormat;
+};
+
+struct TMeshCacheMaterial {
+    TMeshCacheString Name;
+    TMeshCacheString BaseColorImageName;
+    TMeshCacheString NormalImageName;
+    glm::vec4 BaseColor;
+};
+
+struct TMeshCacheMeshInstance {
+    TMeshCacheString MeshName;
+    TMeshCacheString MaterialName;
+    glm::mat4 WorldMatrix;
+    uint64_t InstanceMatricesOffset;
+    uint64_t InstanceCount;
+};
+
+constexpr auto AlignUp(uint64_t value,
+                       uint64_t alignment) -> uint64_t {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+auto GetMeshCacheFilePath(const std::filesystem::path& sourceFilePath,
+                          uint64_t sourceHash) -> std::filesystem::path {
+
+    // the whole file name of the source, a.glb and a.gltf next to each other must not share entries
+    auto cacheFilePath = sourceFilePath;
+    cacheFilePath.replace_filename(std::format("{}.{:016x}{}", sourceFilePath.filename().string(), sourceHash, MeshCacheFileExtension));
+    return cacheFilePath;
+}
+
+// entries of a source differ in their hash only, anything else with the same length starting with the
+// file name of the source would have to be named longer than it
+auto IsMeshCacheEntryOf(const std::filesystem::path& filePath,
+                        const std::filesystem::path& sourceFilePath) -> bool {
+
+    const auto fileName = filePath.filename().string();
+    return fileName.size() == GetMeshCacheFilePath(sourceFilePath, 0).filename().string().size() &&
+           fileName.starts_with(std::format("{}.", sourceFilePath.filename().string())) &&
+           fileName.ends_with(MeshCacheFileExtension);
+}
+
+auto RemoveMeshCacheEntries(const std::filesystem::path& sourceFilePath,
+                            const std::filesystem::path& keptCacheFilePath) -> void {
+
+    const auto cacheDirectoryPath = sourceFilePath.has_parent_path()
+        ? sourceFilePath.parent_path()
+        : std::filesystem::path(".");
+
+    std::error_code errorCode;
+    for (const auto& directoryEntry : std::filesystem::directory_iterator(cacheDirectoryPath, errorCode)) {
+        if (directoryEntry.path().filename() != keptCacheFilePath.filename() &&
+            IsMeshCacheEntryOf(directoryEntry.path(), sourceFilePath)) {
+            spdlog::info("MeshCache: Removing cache entry {}", directoryEntry.path().string());
+            std::filesystem::remove(directoryEntry.path(), errorCode);
+        }
+    }
+}
+
+auto RemoveMeshCacheEntries(const std::filesystem::path& sourceFilePath) -> void {
+
+    RemoveMeshCacheEntries(sourceFilePath, {});
+}
+
+auto ReadMeshCache(const std::filesystem::path& cacheFilePath,
+                   uint64_t sourceHash) -> std::expected<TCookedAsset, std::string> {
+
+    if (!HasAssetFile(cacheFilePath)) {
+        return std::unexpected(std::format("MeshCache: No cache entry {}", cacheFilePath.string()));
+    }
+
+    auto mappedFileResult = MapAssetFile(cacheFilePath);
+    if (!mappedFileResult) {
+        return std::unexpected(std::format("MeshCache: {}", mappedFileResult.error()));
+    }
+
+    auto mappedFile = *mappedFileResult;
+    const auto bytes = mappedFile->Bytes;
+
+    TMeshCacheHeader header = {};
+    if (bytes.size() < sizeof(TMeshCacheHeader)) {
+        return std::unexpected(std::format("MeshCache: {} is truncated", cacheFilePath.string()));
+    }
+    std::memcpy(&header, bytes.data(), sizeof(TMeshCacheHeader));
+
+    if (header.Magic != MeshCacheMagic ||
+        header.FormatVersion != MeshCacheFormatVersion ||
+        header.VertexPositionStride != sizeof(TGpuVertexPosition) ||
+        header.VertexNormalUvTangentStride != sizeof(TGpuVertexNormalUvTangent) ||
+        header.MeshletStride != sizeof(TGpuMeshlet) ||
+        header.LodStride != sizeof(TAssetMeshLod)) {
+        return std::unexpected(std::format("MeshCache: {} was written by a different format version", cacheFilePath.string()));
+    }
+
+    if (header.SourceHash != sourceHash) {
+        return std::unexpected(std::format("MeshCache: {} is stale", cacheFilePath.string()));
+    }
+
+    if (header.FileSize != bytes.size() ||
+        header.StringsOffset + header.StringsSize > bytes.size()) {
+        return std::unexpected(std::format("MeshCache: {} is truncated", cacheFilePath.string()));
+    }
+
+    auto isInRange = [&](uint64_t offset, uint64_t size) {
+        return offset <= bytes.size() && size <= bytes.size() - offset;
+    };
+
+    auto getString = [&](const TMeshCacheString& string) -> std::optional<std::string> {
+        if (string.Offset == MeshCacheNoString || string.Length > header.StringsSize || string.Offset > header.StringsSize - string.Length) {
+            return std::nullopt;
+        }
+        return std::string(reinterpret_cast<const char*>(bytes.data() + header.StringsOffset + string.Offset), string.Length);
+    };
+
+    auto recordOffset = static_cast<uint64_t>(sizeof(TMeshCacheHeader));
+    const auto recordsSize =
+        header.MeshCount * sizeof(TMeshCacheMesh) +
+        header.MaterialCount * sizeof(TMeshCacheMaterial) +
+        header.MeshInstanceCount * sizeof(TMeshCacheMeshInstance);
+    if (!isInRange(recordOffset, recordsSize)) {
+        return std::unexpected(std::format("MeshCache: {} is truncated", cacheFilePath.string()));
+    }
+
+    TCookedAsset cookedAsset;
+    cookedAsset.Meshes.reserve(header.MeshCount);
+    cookedAsset.MeshSourceHashes.reserve(header.MeshCount);
+    for (uint32_t meshIndex = 0; meshIndex < header.MeshCount; ++meshIndex, recordOffset += sizeof(TMeshCacheMesh)) {
+
+        TMeshCacheMesh mesh = {};
+        std::memcpy(&mesh, bytes.data() + recordOffset, sizeof(TMeshCacheMesh));
+
+        if (mesh.IndexElementType > TIndexElementType::UnsignedInteger ||
+            mesh.VertexPositionFormat > TVertexPositionFormat::Snorm8x4 ||
+            !isInRange(mesh.VertexPositionsOffset, mesh.VertexCount * GetVertexPositionSize(mesh.VertexPositionFormat)) ||
+            !isInRange(mesh.VertexNormalUvTangentsOffset, mesh.VertexCount * sizeof(TGpuVertexNormalUvTangent)) ||
+            !isInRange(mesh.LodsOffset, mesh.LodCount * sizeof(TAssetMeshLod)) ||
+            !isInRange(mesh.MeshletsOffset, mesh.MeshletCount * sizeof(TGpuMeshlet)) ||
+            !isInRange(mesh.MeshletVerticesOffset, mesh.MeshletVertexCount * sizeof(uint32_t)) ||
+            !isInRange(mesh.MeshletTrianglesOffset, mesh.MeshletTrianglesSize) ||
+            !isInRange(mesh.IndicesOffset, mesh.IndexCount * GetIndexElementSize(mesh.IndexElementType))) {
+            return std::unexpected(std::format("MeshCache: {} has a corrupt mesh record", cacheFilePath.string()));
+        }
+
+        // the renderer indexes with lod ranges directly, they have to stay within their streams
+        const auto lods = std::span(reinterpret_cast<const TAssetMeshLod*>(bytes.data() + mesh.LodsOffset), mesh.LodCount);
+        const auto areLodsInRange = std::ranges::all_of(lods, [&](const TAssetMeshLod& lod) {
+            return uint64_t(lod.IndexOffset) + lod.IndexCount <= mesh.IndexCount &&
+                   uint64_t(lod.MeshletOffset) + lod.MeshletCount <= mesh.MeshletCount;
+        });
+        if (!areLodsInRange) {
+            return std::unexpected(std::format("MeshCache: {} has a corrupt mesh record", cacheFilePath.string()));
+        }
+
+        // streams are aligned in the file and the mapping is page aligned, so they can be viewed in place
+        cookedAsset.Meshes.push_back(TAssetMesh{
+            .Name = getString(mesh.Name).value_or(""),
+            .InitialTransform = mesh.InitialTransform,
+            .PositionDequantization = mesh.PositionDequantization,
+            .VertexPositions = bytes.subspan(mesh.VertexPositionsOffset, mesh.VertexCount * GetVertexPositionSize(mesh.VertexPositionFormat)),
+            .VertexPositionFormat = mesh.VertexPositionFormat,
+            .VertexNormalUvTangents = {reinterpret_cast<const TGpuVertexNormalUvTangent*>(bytes.data() + mesh.VertexNormalUvTangentsOffset), mesh.VertexCount},
+            .Lods = lods,
+            .Meshlets = {reinterpret_cast<const TGpuMeshlet*>(bytes.data() + mesh.MeshletsOffset), mesh.MeshletCount},
+            .MeshletVertices = {reinterpret_cast<const uint32_t*>(bytes.data() + mesh.MeshletVerticesOffset), mesh.MeshletVertexCount},
+            .MeshletTriangles = {reinterpret_cast<const uint8_t*>(bytes.data() + mesh.MeshletTrianglesOffset), mesh.MeshletTrianglesSize},
+            .Indices = bytes.subspan(mesh.IndicesOffset, mesh.IndexCount * GetIndexElementSize(mesh.IndexElementType)),
+            .IndexElementType = mesh.IndexElementType,
+            .MaterialName = getString(mesh.MaterialName).value_or(""),
+            .Storage = mappedFile,
+        });
+        cookedAsset.MeshSourceHashes.push_back(mesh.SourceHash);
+    }
+
+    cookedAsset.Materials.reserve(header.MaterialCount);
+    for (uint32_t materialIndex = 0; materialIndex < header.MaterialCount; ++materialIndex, recordOffset += sizeof(TMeshCacheMaterial)) {
+
+        TMeshCacheMaterial material = {};
+        std::memcpy(&material, bytes.data() + recordOffset, sizeof(TMeshCacheMaterial));
+
+        cookedAsset.Materials.emplace_back(getString(material.Name).value_or(""), TAssetMaterial{
+            .BaseColor = material.BaseColor,
+            .BaseColorImageName = getString(material.BaseColorImageName),
+            .NormalImageName = getString(material.NormalImageName),
+        });
+    }
+
+    cookedAsset.MeshInstances.reserve(header.MeshInstanceCount);
+    for (uint32_t meshInstanceIndex = 0; meshInstanceIndex < header.MeshInstanceCount; ++meshInstanceIndex, recordOffset += sizeof(TMeshCacheMeshInstance)) {
+
+        TMeshCacheMeshInstance meshInstance = {};
+        std::memcpy(&meshInstance, bytes.data() + recordOffset, sizeof(TMeshCacheMeshInstance));
+
+        if (!isInRange(meshInstance.InstanceMatricesOffset, meshInstance.InstanceCount * sizeof(glm::mat4))) {
+            return std::unexpected(std::format("MeshCache: {} has a corrupt mesh instance record", cacheFilePath.string()));
+        }
+
+        const auto* instanceMatrices = reinterpret_cast<const glm::mat4*>(bytes.data() + meshInstance.InstanceMatricesOffset);
+        cookedAsset.MeshInstances.push_back(TAssetMeshInstance{
+            .MeshName = getString(meshInstance.MeshName).value_or(""),
+            .MaterialName = getString(meshInstance.MaterialName).value_or(""),
+            .WorldMatrix = meshInstance.WorldMatrix,
+            .InstanceMatrices = {instanceMatrices, instanceMatrices + meshInstance.InstanceCount},
+        });
+    }
+
+    return cookedAsset;
+}
+
+auto WriteMeshCache(const std::filesystem::path& cacheFilePath,
+                    uint64_t sourceHash,
+                    std::span<const TAssetMesh> assetMeshes,
+                    std::span<const uint64_t> meshSourceHashes,
+                    std::span<const std::pair<std::string, TAssetMaterial>> assetMaterials,
+                    std::span<const TAssetMeshInstance> assetMeshInstances) -> std::expected<void, std::string> {
+
+    std::string strings;
+    auto addString = [&](const std::string& string) -> TMeshCacheString {
+        auto cacheString = TMeshCacheString{
+            .Offset = strings.size(),
+            .Length = string.size()
+        };
+        strings.append(string);
+        return cacheString;
+    };
+    auto addOptionalString = [&](const std::optional<std::string>& string) -> TMeshCacheString {
+        return string.has_value()
+            ? addString(*string)
+            : TMeshCacheString{ .Offset = MeshCacheNoString, .Length = 0 };
+    };
+
+    TMeshCacheHeader header = {
+        .Magic = MeshCacheMagic,
+        .FormatVersion = MeshCacheFormatVersion,
+        .SourceHash = sourceHash,
+        .VertexPositionStride = sizeof(TGpuVertexPosition),
+        .VertexNormalUvTangentStride = sizeof(TGpuVertexNormalUvTangent),
+        .MeshCount = static_cast<uint32_t>(assetMeshes.size()),
+        .MaterialCount = static_cast<uint32_t>(assetMaterials.size()),
+        .MeshInstanceCount = static_cast<uint32_t>(assetMeshInstances.size()),
+        .MeshletStride = sizeof(TGpuMeshlet),
+        .LodStride = sizeof(TAssetMeshLod),
+    };
+
+    std::vector<TMeshCacheMesh> meshes;
+    meshes.reserve(assetMeshes.size());
+    for (std::size_t meshIndex = 0; meshIndex < assetMeshes.size(); ++meshIndex) {
+        const auto& assetMesh = assetMeshes[meshIndex];
+        meshes.push_back(TMeshCacheMesh{
+            .Name = addString(assetMesh.Name),
+            .MaterialName = addString(assetMesh.MaterialName),
+            .InitialTransform = assetMesh.InitialTransform,
+            .PositionDequantization = assetMesh.PositionDequantization,
+            .SourceHash = meshSourceHashes[meshIndex],
+            .VertexCount = assetMesh.VertexNormalUvTangents.size(),
+            .LodCount = assetMesh.Lods.size(),
+            .MeshletCount = assetMesh.Meshlets.size(),
+            .MeshletVertexCount = assetMesh.MeshletVertices.size(),
+            .MeshletTrianglesSize = assetMesh.MeshletTriangles.size(),
+            .IndexCount = assetMesh.Indices.size() / GetIndexElementSize(assetMesh.IndexElementType),
+            .IndexElementType = assetMesh.IndexElementType,
+            .VertexPositionFormat = assetMesh.VertexPositionFormat,
+        });
+    }
+
+    std::vector<TMeshCacheMaterial> materials;
+    materials.reserve(assetMaterials.size());
+    for (const auto& [assetMaterialName, assetMaterial] : assetMaterials) {
+        materials.push_back(TMeshCacheMaterial{
+            .Name = addString(assetMaterialName),
+            .BaseColorImageName = addOptionalString(assetMaterial.BaseColorImageName),
+            .NormalImageName = addOptionalString(assetMaterial.NormalImageName),
+            .BaseColor = assetMaterial.BaseColor,
+        });
+    }
+
+    std::vector<TMeshCacheMeshInstance> meshInstances;
+    meshInstances.reserve(assetMeshInstances.size());
+    for (const auto& assetMeshInstance : assetMeshInstances) {
+        meshInstances.push_back(TMeshCacheMeshInstance{
+            .MeshName = addString(assetMeshInstance.MeshName),
+            .MaterialName = addString(assetMeshInstance.MaterialName),
+            .WorldMatrix = assetMeshInstance.WorldMatrix,
+            .InstanceCount = assetMeshInstance.InstanceMatrices.size(),
+        });
+    }
+
+    header.StringsOffset = sizeof(TMeshCacheHeader) +
+                           meshes.size() * sizeof(TMeshCacheMesh) +
+                           materials.size() * sizeof(TMeshCacheMaterial) +
+                           meshInstances.size() * sizeof(TMeshCacheMeshInstance);
+    header.StringsSize = strings.size();
+
+    auto streamOffset = header.StringsOffset + header.StringsSize;
+    auto reserveStream = [&](uint64_t sizeInBytes) {
+        streamOffset = AlignUp(streamOffset, MeshCacheStreamAlignment);
+        auto offset = streamOffset;
+        streamOffset += sizeInBytes;
+        return offset;
+    };
+
+    for (std::size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        auto& mesh = meshes[meshIndex];
+        mesh.VertexPositionsOffset = reserveStream(assetMeshes[meshIndex].VertexPositions.size_bytes());
+        mesh.VertexNormalUvTangentsOffset = reserveStream(assetMeshes[meshIndex].VertexNormalUvTangents.size_bytes());
+        mesh.LodsOffset = reserveStream(assetMeshes[meshIndex].Lods.size_bytes());
+        mesh.MeshletsOffset = reserveStream(assetMeshes[meshIndex].Meshlets.size_bytes());
+        mesh.MeshletVerticesOffset = reserveStream(assetMeshes[meshIndex].MeshletVertices.size_bytes());
+        mesh.MeshletTrianglesOffset = reserveStream(assetMeshes[meshIndex].MeshletTriangles.size_bytes());
+        mesh.IndicesOffset = reserveStream(assetMeshes[meshIndex].Indices.size_bytes());
+    }
+    for (std::size_t meshInstanceIndex = 0; meshInstanceIndex < meshInstances.size(); ++meshInstanceIndex) {
+        meshInstances[meshInstanceIndex].InstanceMatricesOffset = reserveStream(meshInstances[meshInstanceIndex].InstanceCount * sizeof(glm::mat4));
+    }
+    header.FileSize = streamOffset;
+
+    // write to a temporary file first, a crash halfway through must not leave a valid looking cache entry behind
+    auto temporaryFilePath = cacheFilePath;
+    temporaryFilePath += ".tmp";
+
+    {
+        std::ofstream cacheFile(temporaryFilePath, std::ios::binary | std::ios::trunc);
+        if (!cacheFile) {
+            return std::unexpected(std::format("MeshCache: Unable to create {}", temporaryFilePath.string()));
+        }
+
+        uint64_t writtenBytes = 0;
+        auto write = [&](const void* data, uint64_t sizeInBytes) {
+            cacheFile.write(static_cast<const char*>(data), static_cast<std::streamsize>(sizeInBytes));
+            writtenBytes += sizeInBytes;
+        };
+        auto writeStream = [&](uint64_t offset, const void* data, uint64_t sizeInBytes) {
+            static constexpr std::array<char, MeshCacheStreamAlignment> padding = {};
+            write(padding.data(), offset - writtenBytes);
+            write(data, sizeInBytes);
+        };
+
+        write(&header, sizeof(TMeshCacheHeader));
+        write(meshes.data(), meshes.size() * sizeof(TMeshCacheMesh));
+        write(materials.data(), materials.size() * sizeof(TMeshCacheMaterial));
+        write(meshInstances.data(), meshInstances.size() * sizeof(TMeshCacheMeshInstance));
+        write(strings.data(), strings.size());
+
+        for (std::size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+            const auto& assetMesh = assetMeshes[meshIndex];
+            writeStream(meshes[meshIndex].VertexPositionsOffset, assetMesh.VertexPositions.data(), assetMesh.VertexPositions.size_bytes());
+            writeStream(meshes[meshIndex].VertexNormalUvTangentsOffset, assetMesh.VertexNormalUvTangents.data(), assetMesh.VertexNormalUvTangents.size_bytes());
+            writeStream(meshes[meshIndex].LodsOffset, assetMesh.Lods.data(), assetMesh.Lods.size_bytes());
+            writeStream(meshes[meshIndex].MeshletsOffset, assetMesh.Meshlets.data(), assetMesh.Meshlets.size_bytes());
+            writeStream(meshes[meshIndex].MeshletVerticesOffset, assetMesh.MeshletVertices.data(), assetMesh.MeshletVertices.size_bytes());
+            writeStream(meshes[meshIndex].MeshletTrianglesOffset, assetMesh.MeshletTriangles.data(), assetMesh.MeshletTriangles.size_bytes());
+            writeStream(meshes[meshIndex].IndicesOffset, assetMesh.Indices.data(), assetMesh.Indices.size_bytes());
+        }
+
+        for (std::size_t meshInstanceIndex = 0; meshInstanceIndex < meshInstances.size(); ++meshInstanceIndex) {
+            const auto& instanceMatrices = assetMeshInstances[meshInstanceIndex].InstanceMatrices;
+            writeStream(meshInstances[meshInstanceIndex].InstanceMatricesOffset, instanceMatrices.data(), instanceMatrices.size() * sizeof(glm::mat4));
+        }
+
+        if (!cacheFile) {
+            return std::unexpected(std::format("MeshCache: Unable to write {}", temporaryFilePath.string()));
+        }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryFilePath, cacheFilePath, errorCode);
+    if (errorCode) {
+        std::filesystem::remove(temporaryFilePath, errorCode);
+        return std::unexpected(std::format("MeshCache: Unable to move {} into place", cacheFilePath.string()));
+    }
+
+    // entries for previous versions of the source are stale now, the source is the cache file name without hash and extension
+    RemoveMeshCacheEntries(cacheFilePath.parent_path() / cacheFilePath.stem().stem(), cacheFilePath);
+
+    return {};
+}
@@ -0,0 +1,244 @@
+#include <Hephaestus/Assets/MeshOptimization.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <meshoptimizer.h>
+
+constexpr uint32_t VertexCacheSize = 16;
+constexpr float OverdrawThreshold = 1.05f;
+// 64/124 keeps a meshlet within the limits of common mesh shader implementations
+constexpr std::size_t MeshletMaxVertices = 64;
+constexpr std::size_t MeshletMaxTriangles = 124;
+constexpr float MeshletConeWeight = 0.25f;
+constexpr std::size_t MaxLodCount = 8;
+constexpr float LodReductionRatio = 0.5f;
+constexpr float LodMinimumReduction = 0.85f;
+constexpr float LodMaxRelativeError = 0.05f;
+
+auto AnalyzeVertexCache(const TAssetMeshData& assetMeshData) -> meshopt_VertexCacheStatistics {
+
+    return meshopt_analyzeVertexCache(assetMeshData.Indices.data(),
+                                      assetMeshData.Indices.size(),
+                                      assetMeshData.VertexPositions.size(),
+                                      VertexCacheSize,
+                                      0,
+                                      0);
+}
+
+auto RemapVertices(TAssetMeshData& assetMeshData,
+                   const std::vector<uint32_t>& remap,
+                   std::size_t uniqueVertexCount) -> void {
+
+    const auto vertexCount = assetMeshData.VertexPositions.size();
+
+    meshopt_remapIndexBuffer(assetMeshData.Indices.data(), assetMeshData.Indices.data(), assetMeshData.Indices.size(), remap.data());
+
+    meshopt_remapVertexBuffer(assetMeshData.VertexPositions.data(), assetMeshData.VertexPositions.data(), vertexCount, sizeof(glm::vec3), remap.data());
+    assetMeshData.VertexPositions.resize(uniqueVertexCount);
+
+    meshopt_remapVertexBuffer(assetMeshData.VertexNormalUvTangents.data(), assetMeshData.VertexNormalUvTangents.data(), vertexCount, sizeof(TGpuVertexNormalUvTangent), remap.data());
+    assetMeshData.VertexNormalUvTangents.resize(uniqueVertexCount);
+
+    if (!assetMeshData.QuantizedVertexPositions.empty()) {
+        meshopt_remapVertexBuffer(assetMeshData.QuantizedVertexPositions.data(), assetMeshData.QuantizedVertexPositions.data(), vertexCount, sizeof(TGpuVertexPosition), remap.data());
+        assetMeshData.QuantizedVertexPositions.resize(uniqueVertexCount);
+    }
+
+    if (!assetMeshData.QuantizedByteVertexPositions.empty()) {
+        meshopt_remapVertexBuffer(assetMeshData.QuantizedByteVertexPositions.data(), assetMeshData.QuantizedByteVertexPositions.data(), vertexCount, sizeof(TGpuVertexPositionSnorm8), remap.data());
+        assetMeshData.QuantizedByteVertexPositions.resize(uniqueVertexCount);
+    }
+}
+
+auto OptimizeMesh(TAssetMeshData& assetMeshData) -> TMeshOptimizationStatistics {
+
+    auto statistics = TMeshOptimizationStatistics{
+        .VertexCountBefore = assetMeshData.VertexPositions.size(),
+        .TriangleCount = assetMeshData.Indices.size() / 3,
+    };
+
+    const auto statisticsBefore = AnalyzeVertexCache(assetMeshData);
+    statistics.AcmrBefore = statisticsBefore.acmr;
+    statistics.AtvrBefore = statisticsBefore.atvr;
+
+    if (!assetMeshData.Indices.empty()) {
+
+        // both streams take part in deduplication, vertices are only equal when all their attributes are
+        const auto streams = std::array{
+            meshopt_Stream{ assetMeshData.VertexPositions.data(), sizeof(glm::vec3), sizeof(glm::vec3) },
+            meshopt_Stream{ assetMeshData.VertexNormalUvTangents.data(), sizeof(TGpuVertexNormalUvTangent), sizeof(TGpuVertexNormalUvTangent) },
+        };
+
+        std::vector<uint32_t> remap(assetMeshData.VertexPositions.size());
+        const auto uniqueVertexCount = meshopt_generateVertexRemapMulti(remap.data(),
+                                                                        assetMeshData.Indices.data(),
+                                                                        assetMeshData.Indices.size(),
+                                                                        assetMeshData.VertexPositions.size(),
+                                                                        streams.data(),
+                                                                        streams.size());
+        RemapVertices(assetMeshData, remap, uniqueVertexCount);
+
+        meshopt_optimizeVertexCache(assetMeshData.Indices.data(),
+                                    assetMeshData.Indices.data(),
+                                    assetMeshData.Indices.size(),
+                                    assetMeshData.VertexPositions.size());
+
+        meshopt_optimizeOverdraw(assetMeshData.Indices.data(),
+                                 assetMeshData.Indices.data(),
+                                 assetMeshData.Indices.size(),
+                                 &assetMeshData.VertexPositions[0].x,
+                                 assetMeshData.VertexPositions.size(),
+                                 sizeof(glm::vec3),
+                                 OverdrawThreshold);
+
+        const auto fetchedVertexCount = meshopt_optimizeVertexFetchRemap(remap.data(),
+                                                                         assetMeshData.Indices.data(),
+                                                                         assetMeshData.Indices.size(),
+                                                                         assetMeshData.VertexPositions.size());
+        RemapVertices(assetMeshData, remap, fetchedVertexCount);
+    }
+
+    const auto statisticsAfter = AnalyzeVertexCache(assetMeshData);
+    statistics.VertexCountAfter = assetMeshData.VertexPositions.size();
+    statistics.AcmrAfter = statisticsAfter.acmr;
+    statistics.AtvrAfter = statisticsAfter.atvr;
+
+    return statistics;
+}
+
+auto BuildLods(TAssetMeshData& assetMeshData,
+               bool generateLods) -> void {
+
+    assetMeshData.Lods = {
+        TAssetMeshLod{
+            .IndexOffset = 0,
+            .IndexCount = static_cast<uint32_t>(assetMeshData.Indices.size()),
+            .Error = 0.0f,
+        }
+    };
+
+    if (!generateLods || assetMeshData.Indices.empty()) {
+        return;
+    }
+
+    // simplification errors are relative to the mesh extent
+    const auto simplifyScale = meshopt_simplifyScale(&assetMeshData.VertexPositions[0].x,
+                                                     assetMeshData.VertexPositions.size(),
+                                                     sizeof(glm::vec3));
+
+    std::vector<uint32_t> lodIndices(assetMeshData.Indices);
+    std::vector<uint32_t> simplifiedIndices(assetMeshData.Indices.size());
+    auto lodError = 0.0f;
+
+    while (assetMeshData.Lods.size() < MaxLodCount) {
+
+        const auto targetIndexCount = static_cast<std::size_t>(lodIndices.size() * LodReductionRatio) / 3 * 3;
+        auto simplifyError = 0.0f;
+        const auto simplifiedIndexCount = meshopt_simplify(simplifiedIndices.data(),
+                                                           lodIndices.data(),
+                                                           lodIndices.size(),
+                                                           &assetMeshData.VertexPositions[0].x,
+                                                           assetMeshData.VertexPositions.size(),
+                                                           sizeof(glm::vec3),
+                                                           targetIndexCount,
+                                                           LodMaxRelativeError,
+                                                           0,
+                                                           &simplifyError);
+
+        // further levels would cost more memory than they save in triangles
+        if (simplifiedIndexCount == 0 || simplifiedIndexCount > lodIndices.size() * LodMinimumReduction) {
+            break;
+        }
+
+        lodIndices.assign(simplifiedIndices.begin(), simplifiedIndices.begin() + simplifiedIndexCount);
+        meshopt_optimizeVertexCache(lodIndices.data(),
+                                    lodIndices.data(),
+                                    lodIndices.size(),
+                                    assetMeshData.VertexPositions.size());
+
+        // every level is simplified from the previous one, so its error can only grow
+        lodError = std::max(lodError, simplifyError * simplifyScale);
+
+        assetMeshData.Lods.push_back(TAssetMeshLod{
+            .IndexOffset = static_cast<uint32_t>(assetMeshData.Indices.size()),
+            .IndexCount = static_cast<uint32_t>(lodIndices.size()),
+            .Error = lodError,
+        });
+        assetMeshData.Indices.insert(assetMeshData.Indices.end(), lodIndices.begin(), lodIndices.end());
+    }
+}
+
+auto BuildMeshlets(TAssetMeshData& assetMeshData) -> void {
+
+    if (assetMeshData.Indices.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> meshletIndices;
+    meshletIndices.reserve(assetMeshData.Indices.size());
+
+    for (auto& lod : assetMeshData.Lods) {
+
+        const auto maxMeshletCount = meshopt_buildMeshletsBound(lod.IndexCount, MeshletMaxVertices, MeshletMaxTriangles);
+        std::vector<meshopt_Meshlet> meshlets(maxMeshletCount);
+        std::vector<uint32_t> meshletVertices(maxMeshletCount * MeshletMaxVertices);
+        std::vector<uint8_t> meshletTriangles(maxMeshletCount * MeshletMaxTriangles * 3);
+
+        const auto meshletCount = meshopt_buildMeshlets(meshlets.data(),
+                                                        meshletVertices.data(),
+                                                        meshletTriangles.data(),
+                                                        &assetMeshData.Indices[lod.IndexOffset],
+                                                        lod.IndexCount,
+                                                        &assetMeshData.VertexPositions[0].x,
+                                                        assetMeshData.VertexPositions.size(),
+                                                        sizeof(glm::vec3),
+                                                        MeshletMaxVertices,
+                                                        MeshletMaxTriangles,
+                                                        MeshletConeWeight);
+        meshlets.resize(meshletCount);
+
+        // triangle ranges of meshlets are padded to 4 bytes
+        const auto& lastMeshlet = meshlets.back();
+        meshletVertices.resize(lastMeshlet.vertex_offset + lastMeshlet.vertex_count);
+        meshletTriangles.resize(lastMeshlet.triangle_offset + ((lastMeshlet.triangle_count * 3 + 3) & ~3u));
+
+        const auto meshletVertexOffset = static_cast<uint32_t>(assetMeshData.MeshletVertices.size());
+        const auto meshletTriangleOffset = static_cast<uint32_t>(assetMeshData.MeshletTriangles.size());
+
+        lod.IndexOffset = static_cast<uint32_t>(meshletIndices.size());
+        lod.MeshletOffset = static_cast<uint32_t>(assetMeshData.Meshlets.size());
+        lod.MeshletCount = static_cast<uint32_t>(meshletCount);
+
+        for (const auto& meshlet : meshlets) {
+
+            const auto bounds = meshopt_computeMeshletBounds(&meshletVertices[meshlet.vertex_offset],
+                                                             &meshletTriangles[meshlet.triangle_offset],
+                                                             meshlet.triangle_count,
+                                                             &assetMeshData.VertexPositions[0].x,
+                                                             assetMeshData.VertexPositions.size(),
+                                                             sizeof(glm::vec3));
+
+            assetMeshData.Meshlets.push_back(TGpuMeshlet{
+                .VertexOffset = meshletVertexOffset + meshlet.vertex_offset,
+                .TriangleOffset = meshletTriangleOffset + meshlet.triangle_offset,
+                .VertexCount = meshlet.vertex_count,
+                .TriangleCount = meshlet.triangle_count,
+                .IndexOffset = static_cast<uint32_t>(meshletIndices.size()),
+                .IndexCount = meshlet.triangle_count * 3,
+                .BoundingSphere = glm::vec4(bounds.center[0], bounds.center[1], bounds.center[2], bounds.radius),
+                .ConeAxisCutoff = glm::vec4(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2], bounds.cone_cutoff),
+            });
+
+            for (uint32_t index = 0; index < meshlet.triangle_count * 3; ++index) {
+                meshletIndices.push_back(meshletVertices[meshlet.vertex_offset + meshletTriangles[meshlet.triangle_offset + index]]);
+            }
+        }
+
+        lod.IndexCount = static_cast<uint32_t>(meshletIndices.size()) - lod.IndexOffset;
+        assetMeshData.MeshletVertices.insert(assetMeshData.MeshletVertices.end(), meshletVertices.begin(), meshletVertices.end());
+        assetMeshData.MeshletTriangles.insert(assetMeshData.MeshletTriangles.end(), meshletTriangles.begin(), meshletTriangles.end());
+    }
+
+    assetMeshData.Indices = std::move(meshletIndices);
+}
\ No newline at end of file
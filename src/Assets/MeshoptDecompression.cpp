@@ -0,0 +1,95 @@
+#include <Hephaestus/Assets/MeshoptDecompression.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+
+#include <meshoptimizer.h>
+
+// meshoptimizer only asserts on these, a malformed file must not take the loader down
+auto IsValidMeshoptStride(const fastgltf::CompressedBufferView& compressedBufferView) -> bool {
+
+    const auto stride = compressedBufferView.byteStride;
+    switch (compressedBufferView.mode) {
+        case fastgltf::MeshoptCompressionMode::Attributes:
+            if (stride == 0 || stride % 4 != 0 || stride > 256) {
+                return false;
+            }
+            break;
+        case fastgltf::MeshoptCompressionMode::Triangles:
+            if (compressedBufferView.count % 3 != 0) {
+                return false;
+            }
+            [[fallthrough]];
+        case fastgltf::MeshoptCompressionMode::Indices:
+            if (stride != 2 && stride != 4) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    switch (compressedBufferView.filter) {
+        case fastgltf::MeshoptCompressionFilter::Octahedral: return stride == 4 || stride == 8;
+        case fastgltf::MeshoptCompressionFilter::Quaternion: return stride == 8;
+        default: return true;
+    }
+}
+
+auto DecodeMeshoptBufferView(std::span<const std::byte> bufferBytes,
+                             const fastgltf::CompressedBufferView& compressedBufferView) -> std::expected<fastgltf::sources::Vector, std::string> {
+
+    if (compressedBufferView.byteOffset + compressedBufferView.byteLength > bufferBytes.size()) {
+        return std::unexpected(std::format("meshopt: Compressed range is outside of buffer {}", compressedBufferView.bufferIndex));
+    }
+
+    if (!IsValidMeshoptStride(compressedBufferView)) {
+        return std::unexpected(std::format("meshopt: Invalid byte stride {}", compressedBufferView.byteStride));
+    }
+
+    const auto* compressedBytes = reinterpret_cast<const unsigned char*>(bufferBytes.data() + compressedBufferView.byteOffset);
+    const auto count = compressedBufferView.count;
+    const auto stride = compressedBufferView.byteStride;
+
+    fastgltf::sources::Vector decodedBufferView = {};
+    decodedBufferView.bytes.resize(count * stride);
+    decodedBufferView.mimeType = fastgltf::MimeType::GltfBuffer;
+    auto* decodedBytes = reinterpret_cast<unsigned char*>(decodedBufferView.bytes.data());
+
+    int32_t result = -1;
+    switch (compressedBufferView.mode) {
+        case fastgltf::MeshoptCompressionMode::Attributes:
+            result = meshopt_decodeVertexBuffer(decodedBytes, count, stride, compressedBytes, compressedBufferView.byteLength);
+            break;
+        case fastgltf::MeshoptCompressionMode::Triangles:
+            result = meshopt_decodeIndexBuffer(decodedBytes, count, stride, compressedBytes, compressedBufferView.byteLength);
+            break;
+        case fastgltf::MeshoptCompressionMode::Indices:
+            result = meshopt_decodeIndexSequence(decodedBytes, count, stride, compressedBytes, compressedBufferView.byteLength);
+            break;
+        default:
+            break;
+    }
+
+    if (result != 0) {
+        return std::unexpected(std::format("meshopt: Failed to decode buffer view ({})", result));
+    }
+
+    switch (compressedBufferView.filter) {
+        case fastgltf::MeshoptCompressionFilter::Octahedral:
+            meshopt_decodeFilterOct(decodedBytes, count, stride);
+            break;
+        case fastgltf::MeshoptCompressionFilter::Quaternion:
+            meshopt_decodeFilterQuat(decodedBytes, count, stride);
+            break;
+        case fastgltf::MeshoptCompressionFilter::Exponential:
+            meshopt_decodeFilterExp(decodedBytes, count, stride);
+            break;
+        default:
+            break;
+    }
+
+    return decodedBufferView;
+}
\ No newline at end of file
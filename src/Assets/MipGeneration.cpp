@@ -0,0 +1,197 @@
+#include <Hephaestus/Assets/MipGeneration.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HEPHAESTUS_MIP_GENERATION_SSE2
+#endif
+
+constexpr int32_t RgbaComponents = 4;
+// filtering runs on 14 bit linear values, a sum of four of them still fits into 16 bits
+constexpr uint32_t LinearBits = 14;
+constexpr uint32_t LinearMax = (1u << LinearBits) - 1;
+// alpha and unorm channels are widened by a shift instead of a table, 255 << 6 stays below LinearMax
+constexpr uint32_t UnormShift = 6;
+
+struct TMipConversionTables {
+    std::array<uint16_t, 256> SrgbToLinear;
+    std::array<uint8_t, LinearMax + 1> LinearToSrgb;
+};
+
+auto GetMipConversionTables() -> const TMipConversionTables& {
+
+    static const auto tables = [] {
+        TMipConversionTables mipConversionTables = {};
+        for (uint32_t value = 0; value < mipConversionTables.SrgbToLinear.size(); ++value) {
+            const auto srgb = static_cast<float>(value) / 255.0f;
+            const auto linear = srgb <= 0.04045f
+                ? srgb / 12.92f
+                : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+            mipConversionTables.SrgbToLinear[value] = static_cast<uint16_t>(std::lround(linear * LinearMax));
+        }
+
+        for (uint32_t value = 0; value < mipConversionTables.LinearToSrgb.size(); ++value) {
+            const auto linear = static_cast<float>(value) / LinearMax;
+            const auto srgb = linear <= 0.0031308f
+                ? linear * 12.92f
+                : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+            mipConversionTables.LinearToSrgb[value] = static_cast<uint8_t>(std::clamp(std::lround(srgb * 255.0f), 0l, 255l));
+        }
+
+        return mipConversionTables;
+    }();
+
+    return tables;
+}
+
+auto WidenRow(const uint8_t* row,
+              int32_t width,
+              bool isSrgb,
+              uint16_t* linearRow) -> void {
+
+    const auto& srgbToLinear = GetMipConversionTables().SrgbToLinear;
+    for (int32_t component = 0; component < width * RgbaComponents; component += RgbaComponents) {
+        for (int32_t channel = 0; channel < 3; ++channel) {
+            linearRow[component + channel] = isSrgb
+                ? srgbToLinear[row[component + channel]]
+                : static_cast<uint16_t>(row[component + channel] << UnormShift);
+        }
+        linearRow[component + 3] = static_cast<uint16_t>(row[component + 3] << UnormShift);
+    }
+}
+
+auto NarrowRow(const uint16_t* linearRow,
+               int32_t width,
+               bool isSrgb,
+               uint8_t* row) -> void {
+
+    const auto& linearToSrgb = GetMipConversionTables().LinearToSrgb;
+    constexpr uint32_t rounding = 1u << (UnormShift - 1);
+    for (int32_t component = 0; component < width * RgbaComponents; component += RgbaComponents) {
+        for (int32_t channel = 0; channel < 3; ++channel) {
+            row[component + channel] = isSrgb
+                ? linearToSrgb[linearRow[component + channel]]
+                : static_cast<uint8_t>((linearRow[component + channel] + rounding) >> UnormShift);
+        }
+        row[component + 3] = static_cast<uint8_t>((linearRow[component + 3] + rounding) >> UnormShift);
+    }
+}
+
+// averages 2x2 blocks of two widened source rows, the last column is repeated for odd widths of one
+auto FilterRows(const uint16_t* sourceRow0,
+                const uint16_t* sourceRow1,
+                int32_t sourceWidth,
+                int32_t width,
+                uint16_t* row) -> void {
+
+    int32_t x = 0;
+
+#ifdef HEPHAESTUS_MIP_GENERATION_SSE2
+    // two destination pixels per iteration, four source pixels of both rows are eight 16 bit lanes per register pair
+    const auto rounding = _mm_set1_epi16(2);
+    for (; x + 2 <= width && (x + 2) * 2 <= sourceWidth; x += 2) {
+        const auto sourceOffset = x * 2 * RgbaComponents;
+        const auto row0Low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceRow0 + sourceOffset));
+        const auto row0High = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceRow0 + sourceOffset + 8));
+        const auto row1Low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceRow1 + sourceOffset));
+        const auto row1High = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sourceRow1 + sourceOffset + 8));
+
+        const auto columnsLow = _mm_add_epi16(row0Low, row1Low);
+        const auto columnsHigh = _mm_add_epi16(row0High, row1High);
+        const auto blockLow = _mm_add_epi16(columnsLow, _mm_srli_si128(columnsLow, 8));
+        const auto blockHigh = _mm_add_epi16(columnsHigh, _mm_srli_si128(columnsHigh, 8));
+
+        const auto average = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(blockLow, blockHigh), rounding), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x * RgbaComponents), average);
+    }
+#endif
+
+    for (; x < width; ++x) {
+        const auto sourceX0 = x * 2;
+        const auto sourceX1 = std::min(sourceX0 + 1, sourceWidth - 1);
+        for (int32_t channel = 0; channel < RgbaComponents; ++channel) {
+            const uint32_t sum = sourceRow0[sourceX0 * RgbaComponents + channel] +
+                                 sourceRow0[sourceX1 * RgbaComponents + channel] +
+                                 sourceRow1[sourceX0 * RgbaComponents + channel] +
+                                 sourceRow1[sourceX1 * RgbaComponents + channel];
+            row[x * RgbaComponents + channel] = static_cast<uint16_t>((sum + 2) >> 2);
+        }
+    }
+}
+
+auto GenerateMipLevel(const uint8_t* sourcePixels,
+                      const TAssetImageLevel& sourceLevel,
+                      uint8_t* pixels,
+                      const TAssetImageLevel& level,
+                      bool isSrgb) -> void {
+
+    std::vector<uint16_t> sourceRow0(static_cast<std::size_t>(sourceLevel.Width) * RgbaComponents);
+    std::vector<uint16_t> sourceRow1(sourceRow0.size());
+    std::vector<uint16_t> row(static_cast<std::size_t>(level.Width) * RgbaComponents);
+
+    const auto sourceStride = static_cast<std::size_t>(sourceLevel.Width) * RgbaComponents;
+    const auto stride = static_cast<std::size_t>(level.Width) * RgbaComponents;
+    for (int32_t y = 0; y < level.Height; ++y) {
+        const auto sourceY0 = y * 2;
+        const auto sourceY1 = std::min(sourceY0 + 1, sourceLevel.Height - 1);
+        WidenRow(sourcePixels + sourceY0 * sourceStride, sourceLevel.Width, isSrgb, sourceRow0.data());
+        WidenRow(sourcePixels + sourceY1 * sourceStride, sourceLevel.Width, isSrgb, sourceRow1.data());
+        FilterRows(sourceRow0.data(), sourceRow1.data(), sourceLevel.Width, level.Width, row.data());
+        NarrowRow(row.data(), level.Width, isSrgb, pixels + y * stride);
+    }
+}
+
+auto GenerateMipChain(TAssetImage& assetImage) -> std::expected<void, std::string> {
+
+    if (assetImage.Format != TFormat::R8G8B8A8_SRGB && assetImage.Format != TFormat::R8G8B8A8_UNORM) {
+        return std::unexpected("Mip chains can only be generated for R8G8B8A8 images");
+    }
+
+    if (assetImage.Levels.size() != 1 || assetImage.Pixels == nullptr) {
+        return std::unexpected("Mip chains need exactly the first level");
+    }
+
+    const auto levelCount = static_cast<uint32_t>(std::bit_width(static_cast<uint32_t>(std::max(assetImage.Width, assetImage.Height))));
+    auto pixelsSize = assetImage.Levels.front().Size;
+    for (uint32_t levelIndex = 1; levelIndex < levelCount; ++levelIndex) {
+        const auto width = std::max(assetImage.Width >> levelIndex, 1);
+        const auto height = std::max(assetImage.Height >> levelIndex, 1);
+        const auto size = static_cast<std::size_t>(width) * height * RgbaComponents;
+        assetImage.Levels.push_back(TAssetImageLevel{
+            .Width = width,
+            .Height = height,
+            .Offset = pixelsSize,
+            .Size = size,
+        });
+        pixelsSize += size;
+    }
+
+    // grows the decoded block in place where possible, the first level stays where it is
+    auto* pixels = static_cast<std::byte*>(std::realloc(assetImage.Pixels.get(), pixelsSize));
+    if (pixels == nullptr) {
+        assetImage.Levels.resize(1);
+        return std::unexpected("Unable to allocate the mip chain");
+    }
+    static_cast<void>(assetImage.Pixels.release());
+    assetImage.Pixels.reset(pixels);
+
+    const auto isSrgb = assetImage.Format == TFormat::R8G8B8A8_SRGB;
+    for (std::size_t levelIndex = 1; levelIndex < assetImage.Levels.size(); ++levelIndex) {
+        const auto& sourceLevel = assetImage.Levels[levelIndex - 1];
+        const auto& level = assetImage.Levels[levelIndex];
+        GenerateMipLevel(reinterpret_cast<const uint8_t*>(pixels + sourceLevel.Offset),
+                         sourceLevel,
+                         reinterpret_cast<uint8_t*>(pixels + level.Offset),
+                         level,
+                         isSrgb);
+    }
+
+    return {};
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <Hephaestus/Assets/VertexQuantization.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/packing.hpp>
+
+constexpr uint32_t TangentSignBit = 1u << 16;
+constexpr float PositionSnormMax = 32767.0f;
+
+auto SignNotZero(const glm::vec2& value) -> glm::vec2 {
+
+    return {value.x >= 0.0f ? 1.0f : -1.0f, value.y >= 0.0f ? 1.0f : -1.0f};
+}
+
+auto EncodeOctahedral(const glm::vec3& vector) -> glm::vec2 {
+
+    const auto length = glm::abs(vector.x) + glm::abs(vector.y) + glm::abs(vector.z);
+    if (length <= 0.0f) {
+        return glm::vec2{0.0f};
+    }
+
+    auto encoded = glm::vec2{vector.x, vector.y} / length;
+    if (vector.z < 0.0f) {
+        encoded = (1.0f - glm::abs(glm::vec2{encoded.y, encoded.x})) * SignNotZero(encoded);
+    }
+
+    return encoded;
+}
+
+auto DecodeOctahedral(const glm::vec2& encoded) -> glm::vec3 {
+
+    auto decoded = glm::vec3{encoded.x, encoded.y, 1.0f - glm::abs(encoded.x) - glm::abs(encoded.y)};
+    if (decoded.z < 0.0f) {
+        const auto xy = (1.0f - glm::abs(glm::vec2{decoded.y, decoded.x})) * SignNotZero(glm::vec2{decoded.x, decoded.y});
+        decoded.x = xy.x;
+        decoded.y = xy.y;
+    }
+
+    return glm::normalize(decoded);
+}
+
+auto GetPositionQuantization(const glm::vec3& boundsMin,
+                             const glm::vec3& boundsMax) -> TPositionQuantization {
+
+    // flat axes still need a scale to divide by, any will do since every position sits on the offset
+    const auto extent = (boundsMax - boundsMin) * 0.5f;
+    return TPositionQuantization{
+        .Scale = glm::vec3{
+            extent.x > 0.0f ? extent.x : 1.0f,
+            extent.y > 0.0f ? extent.y : 1.0f,
+            extent.z > 0.0f ? extent.z : 1.0f},
+        .Offset = (boundsMin + boundsMax) * 0.5f,
+    };
+}
+
+auto GetPositionDequantizationMatrix(const TPositionQuantization& positionQuantization) -> glm::mat4 {
+
+    auto dequantizationMatrix = glm::mat4(1.0f);
+    dequantizationMatrix[0][0] = positionQuantization.Scale.x;
+    dequantizationMatrix[1][1] = positionQuantization.Scale.y;
+    dequantizationMatrix[2][2] = positionQuantization.Scale.z;
+    dequantizationMatrix[3] = glm::vec4(positionQuantization.Offset, 1.0f);
+    return dequantizationMatrix;
+}
+
+auto EncodePosition(const glm::vec3& position,
+                    const TPositionQuantization& positionQuantization) -> glm::i16vec4 {
+
+    const auto encodedPosition = glm::round((position - positionQuantization.Offset) / positionQuantization.Scale * PositionSnormMax);
+    return glm::i16vec4(glm::clamp(encodedPosition, -PositionSnormMax, PositionSnormMax), 0);
+}
+
+auto DecodePosition(const glm::i16vec4& encodedPosition,
+                    const TPositionQuantization& positionQuantization) -> glm::vec3 {
+
+    return glm::vec3(encodedPosition) / PositionSnormMax * positionQuantization.Scale + positionQuantization.Offset;
+}
+
+auto EncodeNormal(const glm::vec3& normal) -> uint32_t {
+
+    return glm::packSnorm2x16(EncodeOctahedral(normal));
+}
+
+auto DecodeNormal(uint32_t encodedNormal) -> glm::vec3 {
+
+    return DecodeOctahedral(glm::unpackSnorm2x16(encodedNormal));
+}
+
+auto EncodeTangent(const glm::vec4& tangent) -> uint32_t {
+
+    const auto encodedTangent = glm::packSnorm2x16(EncodeOctahedral(glm::vec3{tangent}));
+    return tangent.w < 0.0f
+        ? encodedTangent | TangentSignBit
+        : encodedTangent & ~TangentSignBit;
+}
+
+auto DecodeTangent(uint32_t encodedTangent) -> glm::vec4 {
+
+    const auto sign = (encodedTangent & TangentSignBit) != 0 ? -1.0f : 1.0f;
+    return glm::vec4{DecodeOctahedral(glm::unpackSnorm2x16(encodedTangent & ~TangentSignBit)), sign};
+}
+
+auto EncodeUv(const glm::vec2& uv) -> uint32_t {
+
+    return glm::packHalf2x16(uv);
+}
+
+auto DecodeUv(uint32_t encodedUv) -> glm::vec2 {
+
+    return glm::unpackHalf2x16(encodedUv);
+}
\ No newline at end of file
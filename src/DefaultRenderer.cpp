@@ -1,6 +1,7 @@
 #include <Hephaestus/DefaultRenderer.hpp>
 #include <Hephaestus/Scene.hpp>
 
+#include <Hephaestus/Components/InstancesComponent.hpp>
 #include <Hephaestus/Components/MeshComponent.hpp>
 #include <Hephaestus/Components/MaterialComponent.hpp>
 #include <Hephaestus/Components/TransformComponent.hpp>
@@ -8,32 +9,279 @@
 #include <Hephaestus/Components/TagCreateGpuResourcesComponent.hpp>
 #include <Hephaestus/Components/GpuMaterialComponent.hpp>
 #include <Hephaestus/Components/GpuMeshComponent.hpp>
+#include <Hephaestus/Components/WorldBoundsComponent.hpp>
 
 #include <Hephaestus/RHI/Debug.hpp>
 #include <Hephaestus/RHI/VertexTypes.hpp>
 #include <Hephaestus/RHI/Buffer.hpp>
+#include <Hephaestus/RHI/Texture.hpp>
 
 #include <Hephaestus/Assets/Assets.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <optional>
+#include <vector>
+
 #include <glad/gl.h>
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 #include <spdlog/spdlog.h>
 
-#include <parallel_hashmap/phmap.h>
-
-phmap::flat_hash_map<std::string, TGpuMeshComponent> g_gpuMeshComponents = {};
-phmap::flat_hash_map<std::string, TGpuMaterialComponent> g_gpuMaterialComponents = {};
+// indexed by the asset ids, the render loop never hashes a name
+std::vector<std::optional<TGpuMesh>> g_gpuMeshes = {};
+std::vector<std::optional<TGpuMaterial>> g_gpuMaterials = {};
+struct TGpuTexture {
+    TTextureId TextureId;
+    // resident bindless handle
+    uint64_t Handle;
+};
 
-phmap::flat_hash_map<std::string, TGpuMesh> g_gpuMeshes = {};
-phmap::flat_hash_map<std::string, TGpuMaterial> g_gpuMaterials = {};
+std::vector<std::optional<TGpuTexture>> g_gpuTextures = {};
 
 struct TConstants {
     glm::mat4 ProjectionMatrix;
     glm::mat4 ViewMatrix;
+    // left, right, bottom, top, near, far, xyz = normal, w = distance
+    glm::vec4 FrustumPlanes[6];
+    glm::vec4 CameraPosition;
 } g_constants = {};
 
+// matches DrawElementsIndirectCommand in CullClusters.cs.glsl
+struct TGpuDrawElementsIndirectCommand {
+    uint32_t IndexCount;
+    uint32_t InstanceCount;
+    uint32_t FirstIndex;
+    int32_t BaseVertex;
+    uint32_t BaseInstance;
+};
+
+// matches GpuClusterDraw in GpuClusterDraw.include.glsl, one per entity and frame
+struct TGpuClusterDraw {
+    glm::mat4 PositionDequantization;
+    // into the instance buffer, entities without TInstancesComponent are a single instance
+    uint32_t FirstInstance;
+    uint32_t InstanceCount;
+    // of the selected level of detail, into the meshlet mega buffer
+    uint32_t FirstMeshlet;
+    uint32_t MeshletCount;
+    uint32_t BaseVertex;
+    uint32_t FirstIndex;
+    // into the position mega buffer, in words
+    uint32_t FirstPositionWord;
+    TVertexPositionFormat VertexPositionFormat;
+    uint32_t MaterialIndex;
+    // selects the index mega buffer and the range of commands the culling pass writes to
+    TIndexElementType IndexElementType;
+    uint32_t Reserved[2];
+};
+
+static_assert(sizeof(TGpuClusterDraw) == 112);
+
+// matches the work items in CullClusters.cs.glsl, one work group culls up to CullClustersWorkGroupSize meshlets of one cluster draw
+struct TGpuCullWorkItem {
+    uint32_t ClusterDrawIndex;
+    uint32_t FirstMeshlet;
+};
+
+// matches DrawCountBuffer in CullClusters.cs.glsl, the late work group counts are the indirect dispatch of the late phase,
+// commands of meshes with 16 bit indices are counted on their own, they follow the 32 bit ones in the command buffers
+struct TGpuDrawCounts {
+    uint32_t EarlyDrawCount;
+    uint32_t LateDrawCount;
+    uint32_t EarlyShortDrawCount;
+    uint32_t LateShortDrawCount;
+    uint32_t RejectedMeshletCount;
+    uint32_t LateWorkGroupCountX;
+    uint32_t LateWorkGroupCountY;
+    uint32_t LateWorkGroupCountZ;
+};
+
+// matches RejectedMeshlet in CullClusters.cs.glsl
+struct TGpuRejectedMeshlet {
+    uint32_t ClusterDrawIndex;
+    uint32_t MeshletIndex;
+};
+
+// matches GpuModelMeshInstance in GpuModelMeshInstance.include.glsl
+struct TGpuModelMeshInstance {
+    glm::mat4 WorldMatrix;
+};
+
+constexpr uint32_t CullClustersWorkGroupSize = 64;
+constexpr uint32_t BuildDepthPyramidWorkGroupSize = 8;
+constexpr uint32_t MaxWorkGroupCountX = 65535;
+constexpr uint32_t MaxGpuResourceCreationsPerFrame = 256;
+// the pass field of the draw sort keys, the geometry pass is the only one going through the render queue so far
+constexpr uint32_t GeometryPassSortKeyPass = 0;
+// a level of detail is good enough when its simplification error covers less than this many pixels
+constexpr float LodScreenSpaceErrorThreshold = 1.0f;
+// entities whose bounds project to a smaller radius than this many pixels are not drawn at all
+constexpr float ContributionCullingThreshold = 0.5f;
+
+auto ExtractFrustumPlanes(const glm::mat4& viewProjectionMatrix,
+                          glm::vec4 (&frustumPlanes)[6]) -> void {
+
+    const auto row0 = glm::row(viewProjectionMatrix, 0);
+    const auto row1 = glm::row(viewProjectionMatrix, 1);
+    const auto row2 = glm::row(viewProjectionMatrix, 2);
+    const auto row3 = glm::row(viewProjectionMatrix, 3);
+
+    frustumPlanes[0] = row3 + row0;
+    frustumPlanes[1] = row3 - row0;
+    frustumPlanes[2] = row3 + row1;
+    frustumPlanes[3] = row3 - row1;
+    // -w <= z covers both clip depth conventions, it is the conservative near plane for zero to one depth
+    frustumPlanes[4] = row3 + row2;
+    frustumPlanes[5] = row3 - row2;
+
+    for (auto& frustumPlane : frustumPlanes) {
+        frustumPlane /= glm::length(glm::vec3(frustumPlane));
+    }
+}
+
+// the extent of a transformed box is the extent projected onto the absolute axes of the matrix
+auto TransformBoundingBox(const glm::vec3& boxMin,
+                          const glm::vec3& boxMax,
+                          const glm::mat4& matrix,
+                          glm::vec3& transformedBoxMin,
+                          glm::vec3& transformedBoxMax) -> void {
+
+    const auto center = glm::vec3(matrix * glm::vec4((boxMin + boxMax) * 0.5f, 1.0f));
+    const auto extent = (boxMax - boxMin) * 0.5f;
+    const auto transformedExtent = glm::abs(glm::vec3(matrix[0])) * extent.x +
+                                   glm::abs(glm::vec3(matrix[1])) * extent.y +
+                                   glm::abs(glm::vec3(matrix[2])) * extent.z;
+
+    transformedBoxMin = center - transformedExtent;
+    transformedBoxMax = center + transformedExtent;
+}
+
+// instanced entities get the union of the boxes of all of their instances and a sphere around that union
+auto GetWorldBounds(const TGpuMesh& gpuMesh,
+                    const glm::mat4& worldMatrix,
+                    const TInstancesComponent* instancesComponent) -> TWorldBoundsComponent {
+
+    TWorldBoundsComponent worldBounds = {};
+    if (instancesComponent == nullptr) {
+        TransformBoundingBox(gpuMesh.BoundingBoxMin, gpuMesh.BoundingBoxMax, worldMatrix, worldBounds.BoxMin, worldBounds.BoxMax);
+
+        // the largest axis scale keeps the sphere conservative under non uniform scale
+        const auto worldScale = glm::max(glm::max(
+            glm::length(glm::vec3(worldMatrix[0])),
+            glm::length(glm::vec3(worldMatrix[1]))),
+            glm::length(glm::vec3(worldMatrix[2])));
+        worldBounds.Sphere = glm::vec4(glm::vec3(worldMatrix * glm::vec4(glm::vec3(gpuMesh.BoundingSphere), 1.0f)), gpuMesh.BoundingSphere.w * worldScale);
+        return worldBounds;
+    }
+
+    worldBounds.BoxMin = glm::vec3(std::numeric_limits<float>::max());
+    worldBounds.BoxMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const auto& instanceMatrix : instancesComponent->InstanceMatrices) {
+        glm::vec3 instanceBoxMin;
+        glm::vec3 instanceBoxMax;
+        TransformBoundingBox(gpuMesh.BoundingBoxMin, gpuMesh.BoundingBoxMax, worldMatrix * instanceMatrix, instanceBoxMin, instanceBoxMax);
+        worldBounds.BoxMin = glm::min(worldBounds.BoxMin, instanceBoxMin);
+        worldBounds.BoxMax = glm::max(worldBounds.BoxMax, instanceBoxMax);
+    }
+    worldBounds.Sphere = glm::vec4((worldBounds.BoxMin + worldBounds.BoxMax) * 0.5f, glm::distance(worldBounds.BoxMin, worldBounds.BoxMax) * 0.5f);
+    return worldBounds;
+}
+
+// picks the coarsest level of detail whose error, projected to the nearest point of the mesh bounds, stays below the threshold
+auto SelectGpuMeshLod(const TGpuMesh& gpuMesh,
+                      const glm::mat4& worldMatrix,
+                      float projectionScale,
+                      float errorThreshold) -> const TGpuMeshLod& {
+
+    const auto worldScale = std::max({
+        glm::length(glm::vec3(worldMatrix[0])),
+        glm::length(glm::vec3(worldMatrix[1])),
+        glm::length(glm::vec3(worldMatrix[2]))});
+    const auto center = glm::vec3(worldMatrix * glm::vec4(glm::vec3(gpuMesh.BoundingSphere), 1.0f));
+    const auto distance = std::max(glm::distance(center, glm::vec3(g_constants.CameraPosition)) - gpuMesh.BoundingSphere.w * worldScale,
+                                   glm::epsilon<float>());
+
+    for (auto lodIndex = gpuMesh.Lods.size() - 1; lodIndex > 0; --lodIndex) {
+        const auto& gpuMeshLod = gpuMesh.Lods[lodIndex];
+        if (gpuMeshLod.Error * worldScale / distance * projectionScale <= errorThreshold) {
+            return gpuMeshLod;
+        }
+    }
+
+    return gpuMesh.Lods.front();
+}
+
+// grow geometrically, the number of visible entities changes a lot while streaming scenes in
+auto EnsureBufferCapacity(uint32_t& buffer,
+                          std::size_t& capacity,
+                          std::size_t elementCount,
+                          std::size_t elementSize,
+                          std::string_view label) -> void {
+
+    if (elementCount > capacity) {
+        DeleteBuffer(buffer);
+        capacity = std::max(elementCount, capacity * 2);
+        buffer = CreateBuffer(label, static_cast<int64_t>(capacity * elementSize), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+}
+
+// before the dequantization, snorm positions unpacked the way the vertex shader does
+auto GetVertexPosition(const TAssetMesh& assetMesh,
+                       std::size_t vertexIndex) -> glm::vec3 {
+
+    const auto vertexPositionSize = GetVertexPositionSize(assetMesh.VertexPositionFormat);
+    const auto* vertexPositionBytes = assetMesh.VertexPositions.data() + vertexIndex * vertexPositionSize;
+    if (assetMesh.VertexPositionFormat == TVertexPositionFormat::Snorm16x4) {
+        TGpuVertexPosition vertexPosition = {};
+        std::memcpy(&vertexPosition, vertexPositionBytes, vertexPositionSize);
+        return glm::vec3(vertexPosition.Position) / 32767.0f;
+    }
+
+    if (assetMesh.VertexPositionFormat == TVertexPositionFormat::Snorm8x4) {
+        TGpuVertexPositionSnorm8 vertexPosition = {};
+        std::memcpy(&vertexPosition, vertexPositionBytes, vertexPositionSize);
+        return glm::vec3(vertexPosition.Position) / 127.0f;
+    }
+
+    glm::vec3 vertexPosition = {};
+    std::memcpy(&vertexPosition, vertexPositionBytes, vertexPositionSize);
+    return vertexPosition;
+}
+
+// asset ids are dense, the slots grow with the highest id seen so far
+template<class TGpuResource>
+auto GetGpuResourceSlot(std::vector<std::optional<TGpuResource>>& gpuResources,
+                        std::size_t index) -> std::optional<TGpuResource>& {
+
+    if (index >= gpuResources.size()) {
+        gpuResources.resize(index + 1);
+    }
+
+    return gpuResources[index];
+}
+
+template<class TGpuResource>
+auto HasGpuResource(const std::vector<std::optional<TGpuResource>>& gpuResources,
+                    std::size_t index) -> bool {
+
+    return index < gpuResources.size() && gpuResources[index].has_value();
+}
+
+auto UpdateConstants() -> void {
+
+    ExtractFrustumPlanes(g_constants.ProjectionMatrix * g_constants.ViewMatrix, g_constants.FrustumPlanes);
+    g_constants.CameraPosition = glm::inverse(g_constants.ViewMatrix)[3];
+}
+
 auto TDefaultRenderer::Load() -> bool {
 
     ApplicationContext.WindowFramebufferScaledSize = glm::ivec2{
@@ -59,6 +307,28 @@ auto TDefaultRenderer::Load() -> bool {
         .InputAssembly = {
             .PrimitiveTopology = TPrimitiveTopology::Triangles
         },
+        .VertexInput = TVertexInputDescriptor{
+            .VertexInputAttributes = {
+                TVertexInputAttributeDescriptor{
+                    .Location = 1,
+                    .Binding = 1,
+                    .Format = TFormat::R32_UINT,
+                    .Offset = offsetof(TGpuVertexNormalUvTangent, Normal),
+                },
+                TVertexInputAttributeDescriptor{
+                    .Location = 2,
+                    .Binding = 1,
+                    .Format = TFormat::R32_UINT,
+                    .Offset = offsetof(TGpuVertexNormalUvTangent, Tangent),
+                },
+                TVertexInputAttributeDescriptor{
+                    .Location = 3,
+                    .Binding = 1,
+                    .Format = TFormat::R16G16_FLOAT,
+                    .Offset = offsetof(TGpuVertexNormalUvTangent, Uv),
+                },
+            }
+        },
     });
 
     if (!geometryPassResult) {
@@ -79,9 +349,41 @@ auto TDefaultRenderer::Load() -> bool {
 
     _fullscreenPassPipelineId = *fullscreenPassResult;
 
+    auto cullClustersResult = CreateComputePipeline({
+        .Label = "CullClusters",
+        .ComputeShaderFilePath = "data/Shaders/Default/CullClusters.cs.glsl",
+    });
+
+    if (!cullClustersResult) {
+        spdlog::error(cullClustersResult.error());
+        return false;
+    }
+
+    _cullClustersPipelineId = *cullClustersResult;
+
+    auto buildDepthPyramidResult = CreateComputePipeline({
+        .Label = "BuildDepthPyramid",
+        .ComputeShaderFilePath = "data/Shaders/Default/BuildDepthPyramid.cs.glsl",
+    });
+
+    if (!buildDepthPyramidResult) {
+        spdlog::error(buildDepthPyramidResult.error());
+        return false;
+    }
+
+    _buildDepthPyramidPipelineId = *buildDepthPyramidResult;
+
     g_constants.ProjectionMatrix = glm::mat4(1.0f);
     g_constants.ViewMatrix = glm::mat4(1.0f);
+    UpdateConstants();
     _gpuConstantsBuffer = CreateBuffer("ConstantsBuffer", sizeof(TConstants), &g_constants, 0);
+    _clusterDrawCountBuffer = CreateBuffer("ClusterDrawCounts", sizeof(TGpuDrawCounts), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    _vertexMegaBuffer.AddStream("MegaVertexNormalUvTangents", sizeof(TGpuVertexNormalUvTangent));
+    _positionMegaBuffer.AddStream("MegaVertexPositions", sizeof(uint32_t));
+    _indexMegaBuffer.AddStream("MegaIndices", sizeof(uint32_t));
+    _shortIndexMegaBuffer.AddStream("MegaShortIndices", sizeof(uint16_t));
+    _meshletMegaBuffer.AddStream("MegaMeshlets", sizeof(TGpuMeshlet));
 
     return true;
 }
@@ -91,8 +393,26 @@ auto TDefaultRenderer::Unload() -> void {
     DestroyFramebuffers();
     DeleteGraphicsPipeline(_geometryPassPipelineId);
     DeleteGraphicsPipeline(_fullscreenPassPipelineId);
+    DeleteComputePipeline(_cullClustersPipelineId);
+    DeleteComputePipeline(_buildDepthPyramidPipelineId);
 
     DeleteBuffer(_gpuConstantsBuffer);
+    DeleteBuffer(_clusterDrawCommandBuffer);
+    DeleteBuffer(_clusterDrawCountBuffer);
+    DeleteBuffer(_commandClusterDrawIndexBuffer);
+    DeleteBuffer(_lateClusterDrawCommandBuffer);
+    DeleteBuffer(_lateCommandClusterDrawIndexBuffer);
+    DeleteBuffer(_rejectedMeshletBuffer);
+    DeleteBuffer(_clusterDrawBuffer);
+    DeleteBuffer(_cullWorkItemBuffer);
+    DeleteBuffer(_instanceBuffer);
+    DeleteBuffer(_gpuMaterialBuffer);
+
+    _vertexMegaBuffer.Delete();
+    _positionMegaBuffer.Delete();
+    _indexMegaBuffer.Delete();
+    _shortIndexMegaBuffer.Delete();
+    _meshletMegaBuffer.Delete();
 }
 
 auto TDefaultRenderer::Render(TRenderContext& renderContext,
@@ -102,55 +422,352 @@ auto TDefaultRenderer::Render(TRenderContext& renderContext,
 
     auto& registry = scene.GetRegistry();
 
+    ApplyAssetReloads(registry);
+    ApplyAssetReleases(registry);
+
     ///////////////////////
     // Create Gpu Resources if necessary
     ///////////////////////
 
+    // entities can reference assets which are still loading, they stay tagged until those are published,
+    // uploads are spread over frames so that a freshly published scene does not stall a single frame,
+    // they share the streaming budget with the entity creation of the scene, but one upload always happens
+    auto gpuResourceCreationBudget = MaxGpuResourceCreationsPerFrame;
+    auto isFirstGpuResourceCreation = true;
     auto createGpuResourcesNecessaryView = registry.view<TTagCreateGpuResourcesComponent>();
     for (auto& entity : createGpuResourcesNecessaryView) {
 
         auto& meshComponent = registry.get<TMeshComponent>(entity);
         auto& materialComponent = registry.get<TMaterialComponent>(entity);
 
-        CreateGpuMesh(meshComponent.MeshName);
-        CreateGpuMaterial(materialComponent.MaterialName);
+        if (!HasAssetMesh(meshComponent.MeshId) || !HasAssetMaterial(materialComponent.MaterialId)) {
+            continue;
+        }
 
-        registry.emplace<TGpuMeshComponent>(entity, meshComponent.MeshName);
-        registry.emplace<TGpuMaterialComponent>(entity, materialComponent.MaterialName);
+        if (gpuResourceCreationBudget == 0 ||
+            (!isFirstGpuResourceCreation && std::chrono::steady_clock::now() >= renderContext.StreamingDeadline)) {
+            break;
+        }
+        gpuResourceCreationBudget--;
+        isFirstGpuResourceCreation = false;
+
+        // entities sharing a deduplicated payload share its GPU resources too
+        const auto gpuMeshId = GetCanonicalAssetMeshId(meshComponent.MeshId);
+        const auto gpuMaterialId = GetCanonicalAssetMaterialId(materialComponent.MaterialId);
+        CreateGpuMesh(gpuMeshId);
+        CreateGpuMaterial(gpuMaterialId);
+
+        // evicted payloads are read back without blocking the frame, the entity stays tagged until they are in
+        if (!HasGpuResource(g_gpuMeshes, std::size_t(gpuMeshId)) || !HasGpuResource(g_gpuMaterials, std::size_t(gpuMaterialId))) {
+            continue;
+        }
+
+        registry.emplace<TGpuMeshComponent>(entity, gpuMeshId);
+        registry.emplace<TGpuMaterialComponent>(entity, gpuMaterialId);
 
         registry.remove<TTagCreateGpuResourcesComponent>(entity);
     }
 
-    BindFramebuffer(_geometryPassFramebuffer);
-    auto& geometryGraphicsPipeline = GetGraphicsPipeline(_geometryPassPipelineId);
-
-    auto worldMatrix = glm::mat4(1.0f);
-    auto materialIndex = 0u;
-
     g_constants.ProjectionMatrix = glm::mat4(1.0f);
     g_constants.ViewMatrix = glm::mat4(1.0f);
+    UpdateConstants();
     UpdateBuffer(_gpuConstantsBuffer, 0, sizeof(TConstants), &g_constants);
+    renderContext.ViewerPosition = glm::vec3(g_constants.CameraPosition);
+
+    ///////////////////////
+    // Cull Clusters
+    ///////////////////////
+
+    // every entity is one cluster draw, the culling pass turns each of its visible meshlets into a draw command,
+    // instanced entities share the commands between all of their instances, all commands land in one array,
+    // those of meshes with 32 bit indices first and those with 16 bit indices behind them, the geometry pass
+    // draws each range with a single call, the draw id leads each command back to its cluster draw
+    std::vector<TGpuClusterDraw> clusterDraws;
+    std::vector<TGpuCullWorkItem> cullWorkItems;
+    std::vector<TGpuModelMeshInstance> instances;
+    instances.reserve(registry.view<TGpuMeshComponent>().size());
+    uint32_t commandCount = 0;
+    uint32_t shortCommandCount = 0;
+
+    const auto framebufferHeight = ApplicationContext.IsEditor
+        ? ApplicationContext.SceneViewerScaledSize.y
+        : ApplicationContext.WindowFramebufferScaledSize.y;
+    const auto projectionScale = g_constants.ProjectionMatrix[1][1] * 0.5f * static_cast<float>(framebufferHeight);
+    const auto lodErrorThreshold = LodScreenSpaceErrorThreshold * std::exp2(ApplicationSettings.LodBias);
+
+    // world bounds follow the transforms, the visibility pass tests all of them at once before anything is submitted,
+    // the GPU culls the meshlets of what is left
+    _frustumCullingBounds.Clear();
+    _frustumCullingEntities.clear();
+
+    auto boundsView = registry.view<TGpuMeshComponent, TTransformComponent>();
+    for (auto&& [entity, gpuMeshComponent, transformComponent] : boundsView.each()) {
+
+        auto& gpuMesh = GetGpuMesh(gpuMeshComponent.MeshId);
+        auto* instancesComponent = registry.try_get<TInstancesComponent>(entity);
+        if (gpuMesh.MeshletCount == 0 || (instancesComponent != nullptr && instancesComponent->InstanceMatrices.empty())) {
+            continue;
+        }
+
+        const auto& worldBounds = registry.emplace_or_replace<TWorldBoundsComponent>(entity, GetWorldBounds(gpuMesh, transformComponent.Transform, instancesComponent));
+        _frustumCullingBounds.Add(worldBounds.Sphere, worldBounds.BoxMin, worldBounds.BoxMax);
+        _frustumCullingEntities.push_back(entity);
+    }
+
+    TFrustumCullingView frustumCullingView = {
+        .CameraPosition = glm::vec3(g_constants.CameraPosition),
+        .ProjectionScale = projectionScale,
+        .MinimumProjectedRadius = ContributionCullingThreshold,
+    };
+    std::ranges::copy(g_constants.FrustumPlanes, frustumCullingView.FrustumPlanes);
+
+    _frustumCullingVisibility.resize(_frustumCullingEntities.size());
+    CullFrustum(frustumCullingView, _frustumCullingBounds, _frustumCullingVisibility);
+
+    // visible entities are submitted by sort key instead of in storage order, entities sharing material and mesh
+    // end up next to each other and within them the nearest go first, this orders the cluster draws and the cull work items,
+    // the draw commands keep it only roughly, the cull pass appends them with atomics in whichever order its work groups
+    // finish, which the multi draws consume as is, so the depth test gains from the order while no state is rebound either way
+    _renderQueue.Clear();
+    for (uint32_t entityIndex = 0; entityIndex < _frustumCullingEntities.size(); ++entityIndex) {
+
+        if (_frustumCullingVisibility[entityIndex] == 0) {
+            continue;
+        }
+
+        const auto entity = _frustumCullingEntities[entityIndex];
+        auto* gpuMaterialComponent = registry.try_get<TGpuMaterialComponent>(entity);
+        if (gpuMaterialComponent == nullptr) {
+            continue;
+        }
+
+        const auto& worldBounds = registry.get<TWorldBoundsComponent>(entity);
+        _renderQueue.Add(MakeDrawSortKey(GeometryPassSortKeyPass,
+                                         static_cast<uint32_t>(_geometryPassPipelineId),
+                                         static_cast<uint32_t>(gpuMaterialComponent->MaterialId),
+                                         static_cast<uint32_t>(registry.get<TGpuMeshComponent>(entity).MeshId),
+                                         glm::distance(glm::vec3(worldBounds.Sphere), frustumCullingView.CameraPosition)),
+                         entityIndex);
+    }
+    _renderQueue.Sort();
+
+    // the transforms are packed into the instance buffer here and uploaded once, shaders fetch them by instance,
+    // everything else an entity needs by the draw id through its cluster draw, there are no per draw uniforms
+    for (const auto entityIndex : _renderQueue.GetDrawIndices()) {
+
+        const auto entity = _frustumCullingEntities[entityIndex];
+        const auto& gpuMaterialComponent = registry.get<TGpuMaterialComponent>(entity);
+        const auto& worldMatrix = registry.get<TTransformComponent>(entity).Transform;
+        auto& gpuMesh = GetGpuMesh(registry.get<TGpuMeshComponent>(entity).MeshId);
+
+        const auto firstInstance = static_cast<uint32_t>(instances.size());
+        const auto* gpuMeshLod = &gpuMesh.Lods.front();
+        if (auto* instancesComponent = registry.try_get<TInstancesComponent>(entity); instancesComponent != nullptr) {
+
+            // the instance which needs the most detail decides the level of detail for all of them
+            gpuMeshLod = &gpuMesh.Lods.back();
+            for (const auto& instanceMatrix : instancesComponent->InstanceMatrices) {
+                const auto instanceWorldMatrix = worldMatrix * instanceMatrix;
+                instances.push_back(TGpuModelMeshInstance{
+                    .WorldMatrix = instanceWorldMatrix,
+                });
+
+                gpuMeshLod = std::min(gpuMeshLod, &SelectGpuMeshLod(gpuMesh, instanceWorldMatrix, projectionScale, lodErrorThreshold));
+            }
+        } else {
+            instances.push_back(TGpuModelMeshInstance{
+                .WorldMatrix = worldMatrix,
+            });
+            gpuMeshLod = &SelectGpuMeshLod(gpuMesh, worldMatrix, projectionScale, lodErrorThreshold);
+        }
+
+        const auto clusterDrawIndex = static_cast<uint32_t>(clusterDraws.size());
+        clusterDraws.push_back(TGpuClusterDraw{
+            .PositionDequantization = gpuMesh.PositionDequantization,
+            .FirstInstance = firstInstance,
+            .InstanceCount = static_cast<uint32_t>(instances.size()) - firstInstance,
+            .FirstMeshlet = gpuMesh.FirstMeshlet + gpuMeshLod->MeshletOffset,
+            .MeshletCount = gpuMeshLod->MeshletCount,
+            .BaseVertex = gpuMesh.BaseVertex,
+            .FirstIndex = gpuMesh.FirstIndex,
+            .FirstPositionWord = gpuMesh.FirstPositionWord,
+            .VertexPositionFormat = gpuMesh.VertexPositionFormat,
+            .MaterialIndex = static_cast<uint32_t>(gpuMaterialComponent.MaterialId),
+            .IndexElementType = gpuMesh.IndexElementType,
+        });
+
+        for (uint32_t firstMeshlet = 0; firstMeshlet < gpuMeshLod->MeshletCount; firstMeshlet += CullClustersWorkGroupSize) {
+            cullWorkItems.push_back(TGpuCullWorkItem{
+                .ClusterDrawIndex = clusterDrawIndex,
+                .FirstMeshlet = firstMeshlet,
+            });
+        }
+        if (gpuMesh.IndexElementType == TIndexElementType::UnsignedShort) {
+            shortCommandCount += gpuMeshLod->MeshletCount;
+        } else {
+            commandCount += gpuMeshLod->MeshletCount;
+        }
+    }
+
+    if (clusterDraws.empty()) {
+        BindFramebuffer(_geometryPassFramebuffer);
+        return;
+    }
+
+    EnsureClusterDrawBuffers(clusterDraws.size(), cullWorkItems.size(), commandCount + shortCommandCount);
+    UploadDirtyGpuMaterials();
+    UpdateBuffer(_clusterDrawBuffer, 0, static_cast<int64_t>(clusterDraws.size() * sizeof(TGpuClusterDraw)), clusterDraws.data());
+    UpdateBuffer(_cullWorkItemBuffer, 0, static_cast<int64_t>(cullWorkItems.size() * sizeof(TGpuCullWorkItem)), cullWorkItems.data());
+    const auto drawCounts = TGpuDrawCounts{
+        .LateWorkGroupCountY = 1,
+        .LateWorkGroupCountZ = 1,
+    };
+    UpdateBuffer(_clusterDrawCountBuffer, 0, sizeof(TGpuDrawCounts), &drawCounts);
+
+    EnsureInstanceBuffer(instances.size());
+    UpdateBuffer(_instanceBuffer, 0, static_cast<int64_t>(instances.size() * sizeof(TGpuModelMeshInstance)), instances.data());
+
+    auto& cullClustersPipeline = GetComputePipeline(_cullClustersPipelineId);
+    cullClustersPipeline.Bind();
+    cullClustersPipeline.BindBufferAsUniformBuffer(_gpuConstantsBuffer, 0);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_instanceBuffer, 1);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_clusterDrawBuffer, 3);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_meshletMegaBuffer.GetBuffer(0), 4);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_clusterDrawCommandBuffer, 5);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_clusterDrawCountBuffer, 6);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_cullWorkItemBuffer, 7);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_commandClusterDrawIndexBuffer, 8);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_rejectedMeshletBuffer, 9);
+    cullClustersPipeline.BindTexture(0, GetTexture(_depthPyramidTexture).Id);
+    cullClustersPipeline.SetUniform(2, static_cast<uint32_t>(cullWorkItems.size()));
+    cullClustersPipeline.SetUniform(3, 0u);
+    cullClustersPipeline.SetUniform(4, commandCount);
+
+    // occlusion is culled in two phases, the early phase tests against last frame's depth pyramid and draws what passes,
+    // the pyramid is rebuilt from that depth and the late phase tests what the early phase rejected again,
+    // anything which became visible this frame is drawn in the same frame, nothing pops in
+    //
+    // one dispatch for the whole scene, work groups beyond the x limit wrap into y
+    const auto cullWorkGroupCountX = std::min(static_cast<uint32_t>(cullWorkItems.size()), MaxWorkGroupCountX);
+    const auto cullWorkGroupCountY = (static_cast<uint32_t>(cullWorkItems.size()) + cullWorkGroupCountX - 1) / cullWorkGroupCountX;
+    cullClustersPipeline.Dispatch(cullWorkGroupCountX, cullWorkGroupCountY, 1);
+
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    ///////////////////////
+    // Geometry Pass
+    ///////////////////////
+
+    BindFramebuffer(_geometryPassFramebuffer);
+    DrawClusters(_clusterDrawCommandBuffer,
+                 _commandClusterDrawIndexBuffer,
+                 offsetof(TGpuDrawCounts, EarlyDrawCount),
+                 offsetof(TGpuDrawCounts, EarlyShortDrawCount),
+                 commandCount,
+                 shortCommandCount);
+
+    ///////////////////////
+    // Depth Pyramid
+    ///////////////////////
+
+    BuildDepthPyramid();
+
+    ///////////////////////
+    // Cull Clusters Late
+    ///////////////////////
+
+    cullClustersPipeline.Bind();
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_lateClusterDrawCommandBuffer, 5);
+    cullClustersPipeline.BindBufferAsShaderStorageBuffer(_lateCommandClusterDrawIndexBuffer, 8);
+    cullClustersPipeline.BindTexture(0, GetTexture(_depthPyramidTexture).Id);
+    cullClustersPipeline.SetUniform(3, 1u);
+    cullClustersPipeline.DispatchIndirect(_clusterDrawCountBuffer, offsetof(TGpuDrawCounts, LateWorkGroupCountX));
+
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    ///////////////////////
+    // Geometry Pass Late
+    ///////////////////////
+
+    // the framebuffer is still bound, binding it again would clear what the early phase drew
+    DrawClusters(_lateClusterDrawCommandBuffer,
+                 _lateCommandClusterDrawIndexBuffer,
+                 offsetof(TGpuDrawCounts, LateDrawCount),
+                 offsetof(TGpuDrawCounts, LateShortDrawCount),
+                 commandCount,
+                 shortCommandCount);
+}
+
+auto TDefaultRenderer::DrawClusters(uint32_t drawCommandBuffer,
+                                    uint32_t commandClusterDrawIndexBuffer,
+                                    std::size_t drawCountOffset,
+                                    std::size_t shortDrawCountOffset,
+                                    std::size_t maxDrawCount,
+                                    std::size_t maxShortDrawCount) -> void {
+
+    auto& geometryGraphicsPipeline = GetGraphicsPipeline(_geometryPassPipelineId);
 
     geometryGraphicsPipeline.Bind();
     geometryGraphicsPipeline.BindBufferAsUniformBuffer(_gpuConstantsBuffer, 0);
+    geometryGraphicsPipeline.BindBufferAsShaderStorageBuffer(_instanceBuffer, 1);
+    geometryGraphicsPipeline.BindBufferAsShaderStorageBuffer(_gpuMaterialBuffer, 2);
+    geometryGraphicsPipeline.BindBufferAsShaderStorageBuffer(_clusterDrawBuffer, 3);
+    geometryGraphicsPipeline.BindBufferAsShaderStorageBuffer(commandClusterDrawIndexBuffer, 8);
+    // positions are pulled by the vertex shader, snorm and float meshes are drawn by the same call
+    geometryGraphicsPipeline.BindBufferAsShaderStorageBuffer(_positionMegaBuffer.GetBuffer(0), 10);
+
+    // the count the culling pass wrote is the number of commands, no matter how many entities there are this is one call
+    // per index type, the draw id restarts at 0 with every call, the vertex shader adds the first command of the call
+    geometryGraphicsPipeline.BindBufferAsVertexBuffer(_vertexMegaBuffer.GetBuffer(0), 1, 0, sizeof(TGpuVertexNormalUvTangent));
+    if (maxDrawCount > 0) {
+        geometryGraphicsPipeline.SetUniform(0, 0u);
+        geometryGraphicsPipeline.MultiDrawElementsIndirectCount(_indexMegaBuffer.GetBuffer(0),
+                                                                TIndexElementType::UnsignedInteger,
+                                                                drawCommandBuffer,
+                                                                0,
+                                                                _clusterDrawCountBuffer,
+                                                                static_cast<int64_t>(drawCountOffset),
+                                                                static_cast<int32_t>(maxDrawCount));
+    }
 
-    auto gpuResourcesView = registry.view<TGpuMeshComponent>();
-    for (auto& entity : gpuResourcesView) {
+    if (maxShortDrawCount > 0) {
+        geometryGraphicsPipeline.SetUniform(0, static_cast<uint32_t>(maxDrawCount));
+        geometryGraphicsPipeline.MultiDrawElementsIndirectCount(_shortIndexMegaBuffer.GetBuffer(0),
+                                                                TIndexElementType::UnsignedShort,
+                                                                drawCommandBuffer,
+                                                                static_cast<int64_t>(maxDrawCount * sizeof(TGpuDrawElementsIndirectCommand)),
+                                                                _clusterDrawCountBuffer,
+                                                                static_cast<int64_t>(shortDrawCountOffset),
+                                                                static_cast<int32_t>(maxShortDrawCount));
+    }
+}
 
-        auto& gpuMeshComponent = registry.get<TGpuMeshComponent>(entity);
-        auto& gpuMaterialComponent = registry.get<TGpuMaterialComponent>(entity);
-        auto& transformComponent = registry.get<TTransformComponent>(entity);
+auto TDefaultRenderer::BuildDepthPyramid() -> void {
+
+    auto& buildDepthPyramidPipeline = GetComputePipeline(_buildDepthPyramidPipelineId);
+    const auto& depthPyramid = GetTexture(_depthPyramidTexture);
 
-        auto& gpuMesh = GetGpuMesh(gpuMeshComponent.MeshName);
-        auto& gpuMaterial = GetGpuMaterial(gpuMaterialComponent.MaterialName);
+    buildDepthPyramidPipeline.Bind();
+    buildDepthPyramidPipeline.BindTexture(0, _geometryPassFramebuffer.DepthStencilAttachment.value().Texture.Id);
+
+    for (int32_t level = 0; level < _depthPyramidLevelCount; ++level) {
+
+        if (level > 0) {
+            buildDepthPyramidPipeline.BindTextureAsImage(0, depthPyramid.Id, level - 1, TFormat::R32_FLOAT);
+        }
+        buildDepthPyramidPipeline.BindTextureAsImage(1, depthPyramid.Id, level, TFormat::R32_FLOAT);
+        buildDepthPyramidPipeline.SetUniform(0, level);
 
-        geometryGraphicsPipeline.SetUniform(0, worldMatrix);
-        geometryGraphicsPipeline.SetUniform(5, materialIndex);
+        const auto levelWidth = std::max(depthPyramid.Extent.Width >> level, 1u);
+        const auto levelHeight = std::max(depthPyramid.Extent.Height >> level, 1u);
+        buildDepthPyramidPipeline.Dispatch((levelWidth + BuildDepthPyramidWorkGroupSize - 1) / BuildDepthPyramidWorkGroupSize,
+                                           (levelHeight + BuildDepthPyramidWorkGroupSize - 1) / BuildDepthPyramidWorkGroupSize,
+                                           1);
 
-        geometryGraphicsPipeline.BindBufferAsVertexBuffer(gpuMesh.VertexPositionBuffer, 0, 0, sizeof(TGpuVertexPosition));
-        geometryGraphicsPipeline.BindBufferAsVertexBuffer(gpuMesh.VertexNormalUvTangentBuffer, 1, 0, sizeof(TGpuVertexPosition));
-        geometryGraphicsPipeline.DrawElements(gpuMesh.IndexBuffer, gpuMesh.IndexCount);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
     }
+
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
 }
 
 auto TDefaultRenderer::RenderUserInterface(TRenderContext &renderContext,
@@ -165,7 +782,7 @@ auto TDefaultRenderer::RenderUserInterface(TRenderContext &renderContext,
 
     if (!ApplicationContext.IsEditor) {
         ImGui::SetNextWindowPos({32, 32});
-        ImGui::SetNextWindowSize({168, 176});
+        ImGui::SetNextWindowSize({168, 296});
         auto windowBackgroundColor = ImGui::GetStyleColorVec4(ImGuiCol_WindowBg);
         windowBackgroundColor.w = 0.4f;
         ImGui::PushStyleColor(ImGuiCol_WindowBg, windowBackgroundColor);
@@ -181,6 +798,13 @@ auto TDefaultRenderer::RenderUserInterface(TRenderContext &renderContext,
             ImGui::Text("rpms: %.0f", framesPerSecond * 60.0f);
             ImGui::Text("  ft: %.2f ms", renderContext.DeltaTime * 1000.0f);
             ImGui::Text("   f: %lu", renderContext.FrameCounter);
+
+            ImGui::SeparatorText("Asset Memory");
+
+            const auto& assetMemoryStatistics = GetAssetMemoryStatistics();
+            ImGui::Text("res: %.1f MiB", static_cast<double>(assetMemoryStatistics.ResidentBytes) / (1024.0 * 1024.0));
+            ImGui::Text("evi: %.1f MiB", static_cast<double>(assetMemoryStatistics.EvictedBytes) / (1024.0 * 1024.0));
+            ImGui::Text("rel: %.1f MiB", static_cast<double>(assetMemoryStatistics.ReloadedBytes) / (1024.0 * 1024.0));
         }
         ImGui::End();
         ImGui::PopStyleColor();
@@ -191,6 +815,7 @@ auto TDefaultRenderer::RenderUserInterface(TRenderContext &renderContext,
 auto TDefaultRenderer::DestroyFramebuffers() -> void {
 
     DeleteFramebuffer(_geometryPassFramebuffer);
+    DeleteTexture(_depthPyramidTexture);
 }
 
 auto TDefaultRenderer::CreateFramebuffers(const glm::ivec2& framebufferSize) -> void {
@@ -225,6 +850,26 @@ auto TDefaultRenderer::CreateFramebuffers(const glm::ivec2& framebufferSize) ->
          }
     });
 
+    // the power of two below the framebuffer, so that every level halves exactly
+    const auto depthPyramidWidth = std::bit_floor(static_cast<uint32_t>(std::max(framebufferSize.x, 1)));
+    const auto depthPyramidHeight = std::bit_floor(static_cast<uint32_t>(std::max(framebufferSize.y, 1)));
+    _depthPyramidLevelCount = std::bit_width(std::max(depthPyramidWidth, depthPyramidHeight));
+    _depthPyramidTexture = CreateTexture({
+        .TextureType = TTextureType::Texture2D,
+        .Format = TFormat::R32_FLOAT,
+        .Extent = TExtent3D(depthPyramidWidth, depthPyramidHeight, 1),
+        .MipMapLevels = _depthPyramidLevelCount,
+        .Layers = 1,
+        .SampleCount = TSampleCount::One,
+        .Label = "DepthPyramid",
+    });
+
+    // there is no previous frame after a resize, the far plane occludes nothing
+    const auto farDepth = 1.0f;
+    for (int32_t level = 0; level < _depthPyramidLevelCount; ++level) {
+        glClearTexImage(GetTexture(_depthPyramidTexture).Id, level, GL_RED, GL_FLOAT, &farDepth);
+    }
+
     /*
     _resolvePassFramebuffer = CreateFramebuffer({
         .Label = "ResolvePass"
@@ -265,52 +910,433 @@ auto TDefaultRenderer::ResizeIfNecessary(const TRenderContext& renderContext) ->
     }
 }
 
-auto TDefaultRenderer::CreateGpuMesh(const std::string& assetMeshName) -> void {
+auto TDefaultRenderer::EnsureClusterDrawBuffers(std::size_t clusterDrawCount,
+                                                std::size_t cullWorkItemCount,
+                                                std::size_t commandCount) -> void {
+
+    EnsureBufferCapacity(_clusterDrawBuffer, _clusterDrawCapacity, clusterDrawCount, sizeof(TGpuClusterDraw), "ClusterDraws");
+    EnsureBufferCapacity(_cullWorkItemBuffer, _cullWorkItemCapacity, cullWorkItemCount, sizeof(TGpuCullWorkItem), "CullWorkItems");
+
+    // commands, their cluster draw indices and the rejected meshlets are written side by side, one per meshlet at most,
+    // they always have the same capacity
+    if (commandCount > _clusterDrawCommandCapacity) {
+        DeleteBuffer(_clusterDrawCommandBuffer);
+        DeleteBuffer(_commandClusterDrawIndexBuffer);
+        DeleteBuffer(_lateClusterDrawCommandBuffer);
+        DeleteBuffer(_lateCommandClusterDrawIndexBuffer);
+        DeleteBuffer(_rejectedMeshletBuffer);
+
+        _clusterDrawCommandCapacity = std::max(commandCount, _clusterDrawCommandCapacity * 2);
+        const auto capacity = static_cast<int64_t>(_clusterDrawCommandCapacity);
+        _clusterDrawCommandBuffer = CreateBuffer("EarlyClusterDrawCommands", capacity * sizeof(TGpuDrawElementsIndirectCommand), nullptr, 0);
+        _commandClusterDrawIndexBuffer = CreateBuffer("EarlyCommandClusterDrawIndices", capacity * sizeof(uint32_t), nullptr, 0);
+        _lateClusterDrawCommandBuffer = CreateBuffer("LateClusterDrawCommands", capacity * sizeof(TGpuDrawElementsIndirectCommand), nullptr, 0);
+        _lateCommandClusterDrawIndexBuffer = CreateBuffer("LateCommandClusterDrawIndices", capacity * sizeof(uint32_t), nullptr, 0);
+        _rejectedMeshletBuffer = CreateBuffer("RejectedMeshlets", capacity * sizeof(TGpuRejectedMeshlet), nullptr, 0);
+    }
+}
+
+auto TDefaultRenderer::EnsureInstanceBuffer(std::size_t instanceCount) -> void {
+
+    EnsureBufferCapacity(_instanceBuffer, _instanceCapacity, instanceCount, sizeof(TGpuModelMeshInstance), "ModelMeshInstances");
+}
+
+// runs before anything of the frame is recorded, resources of unchanged assets are not touched
+auto TDefaultRenderer::ApplyAssetReloads(entt::registry& registry) -> void {
+
+    const auto reloadedAssetImageIds = TakeReloadedAssetImageIds();
+    const auto reloadedAssetMaterialIds = TakeReloadedAssetMaterialIds();
+    const auto reloadedAssetMeshIds = TakeReloadedAssetMeshIds();
+    if (reloadedAssetImageIds.empty() && reloadedAssetMaterialIds.empty() && reloadedAssetMeshIds.empty()) {
+        return;
+    }
+
+    std::vector<uint64_t> deletedTextureHandles;
+    for (const auto assetImageId : reloadedAssetImageIds) {
+        if (std::size_t(assetImageId) < g_gpuTextures.size() && g_gpuTextures[std::size_t(assetImageId)].has_value()) {
+            deletedTextureHandles.push_back(g_gpuTextures[std::size_t(assetImageId)]->Handle);
+            DeleteGpuTexture(assetImageId);
+        }
+    }
+
+    // any material can sample a reloaded image through deduplication, not just the reloaded ones
+    for (std::size_t gpuMaterialIndex = 0; gpuMaterialIndex < g_gpuMaterials.size(); ++gpuMaterialIndex) {
+        const auto& gpuMaterial = g_gpuMaterials[gpuMaterialIndex];
+        const auto isReloaded = std::ranges::find(reloadedAssetMaterialIds, TAssetMaterialId(gpuMaterialIndex)) != reloadedAssetMaterialIds.end();
+        const auto samplesDeletedTexture = gpuMaterial.has_value() &&
+            (std::ranges::find(deletedTextureHandles, gpuMaterial->BaseColorTexture) != deletedTextureHandles.end() ||
+             std::ranges::find(deletedTextureHandles, gpuMaterial->NormalTexture) != deletedTextureHandles.end());
+        if (!isReloaded && !samplesDeletedTexture) {
+            continue;
+        }
+
+        g_gpuMaterials[gpuMaterialIndex].reset();
+        MarkGpuMaterialDirty(TAssetMaterialId(gpuMaterialIndex));
+        if (HasAssetMaterial(TAssetMaterialId(gpuMaterialIndex))) {
+            CreateGpuMaterial(TAssetMaterialId(gpuMaterialIndex));
+        }
+    }
+
+    for (const auto assetMeshId : reloadedAssetMeshIds) {
+        DeleteGpuMesh(assetMeshId);
+    }
+
+    // a reloaded id can now share another payload or stop sharing one, and the ids which shared its old payload
+    // have a new canonical id, so every entity touching a reloaded id resolves its GPU resources again
+    auto meshesView = registry.view<TMeshComponent, TGpuMeshComponent>();
+    for (auto& entity : meshesView) {
+
+        auto& meshComponent = registry.get<TMeshComponent>(entity);
+        auto& gpuMeshComponent = registry.get<TGpuMeshComponent>(entity);
+        if (std::ranges::find(reloadedAssetMeshIds, meshComponent.MeshId) == reloadedAssetMeshIds.end() &&
+            std::ranges::find(reloadedAssetMeshIds, gpuMeshComponent.MeshId) == reloadedAssetMeshIds.end()) {
+            continue;
+        }
+
+        gpuMeshComponent.MeshId = GetCanonicalAssetMeshId(meshComponent.MeshId);
+        CreateGpuMesh(gpuMeshComponent.MeshId);
+    }
+
+    auto materialsView = registry.view<TMaterialComponent, TGpuMaterialComponent>();
+    for (auto& entity : materialsView) {
+
+        auto& materialComponent = registry.get<TMaterialComponent>(entity);
+        auto& gpuMaterialComponent = registry.get<TGpuMaterialComponent>(entity);
+        if (std::ranges::find(reloadedAssetMaterialIds, materialComponent.MaterialId) == reloadedAssetMaterialIds.end() &&
+            std::ranges::find(reloadedAssetMaterialIds, gpuMaterialComponent.MaterialId) == reloadedAssetMaterialIds.end()) {
+            continue;
+        }
+
+        gpuMaterialComponent.MaterialId = GetCanonicalAssetMaterialId(materialComponent.MaterialId);
+        CreateGpuMaterial(gpuMaterialComponent.MaterialId);
+    }
+
+    // a new canonical id can point at an evicted payload, its entities go back to the creation pass until it is in
+    auto gpuResourcesView = registry.view<TGpuMeshComponent, TGpuMaterialComponent>();
+    for (auto& entity : gpuResourcesView) {
+
+        const auto& gpuMeshComponent = registry.get<TGpuMeshComponent>(entity);
+        const auto& gpuMaterialComponent = registry.get<TGpuMaterialComponent>(entity);
+        if (HasGpuResource(g_gpuMeshes, std::size_t(gpuMeshComponent.MeshId)) &&
+            HasGpuResource(g_gpuMaterials, std::size_t(gpuMaterialComponent.MaterialId))) {
+            continue;
+        }
+
+        registry.remove<TGpuMeshComponent, TGpuMaterialComponent>(entity);
+        registry.emplace_or_replace<TTagCreateGpuResourcesComponent>(entity);
+    }
+}
+
+// runs after the reloads, the entities of unloaded cells are destroyed by then, so a GPU resource which no entity
+// references anymore can go, together with the CPU copy it was uploaded from
+auto TDefaultRenderer::ApplyAssetReleases(entt::registry& registry) -> void {
 
-    auto& assetMesh = GetAssetMesh(assetMeshName);
+    const auto releasedAssetMeshIds = TakeReleasedAssetMeshIds();
+    const auto releasedAssetMaterialIds = TakeReleasedAssetMaterialIds();
+    if (releasedAssetMeshIds.empty() && releasedAssetMaterialIds.empty()) {
+        return;
+    }
+
+    // deduplicated payloads are shared with entities of other cells, including the ones still waiting for their upload
+    std::vector<bool> isGpuMeshUsed(g_gpuMeshes.size(), false);
+    for (auto& entity : registry.view<TMeshComponent>()) {
+        const auto gpuMeshId = std::size_t(GetCanonicalAssetMeshId(registry.get<TMeshComponent>(entity).MeshId));
+        if (gpuMeshId < isGpuMeshUsed.size()) {
+            isGpuMeshUsed[gpuMeshId] = true;
+        }
+    }
 
-    uint32_t buffers[3] = {};
-    {
-        glCreateBuffers(3, buffers);
+    std::vector<bool> isGpuMaterialUsed(g_gpuMaterials.size(), false);
+    for (auto& entity : registry.view<TMaterialComponent>()) {
+        const auto gpuMaterialId = std::size_t(GetCanonicalAssetMaterialId(registry.get<TMaterialComponent>(entity).MaterialId));
+        if (gpuMaterialId < isGpuMaterialUsed.size()) {
+            isGpuMaterialUsed[gpuMaterialId] = true;
+        }
+    }
 
-        SetDebugLabel(buffers[0], GL_BUFFER, std::format("{}_GpuVertexPosition", assetMeshName));
-        SetDebugLabel(buffers[1], GL_BUFFER, std::format("{}_GpuVertexNormalUvTangent", assetMeshName));
-        SetDebugLabel(buffers[2], GL_BUFFER, std::format("{}_Indices", assetMeshName));
+    for (const auto assetMeshId : releasedAssetMeshIds) {
+        const auto gpuMeshId = GetCanonicalAssetMeshId(assetMeshId);
+        if (!HasGpuResource(g_gpuMeshes, std::size_t(gpuMeshId)) || isGpuMeshUsed[std::size_t(gpuMeshId)]) {
+            continue;
+        }
 
-        glNamedBufferStorage(buffers[0], sizeof(TGpuVertexPosition) * assetMesh.VertexPositions.size(),
-                             assetMesh.VertexPositions.data(), 0);
-        glNamedBufferStorage(buffers[1], sizeof(TGpuVertexNormalUvTangent) * assetMesh.VertexNormalUvTangents.size(),
-                             assetMesh.VertexNormalUvTangents.data(), 0);
-        glNamedBufferStorage(buffers[2], sizeof(uint32_t) * assetMesh.Indices.size(), assetMesh.Indices.data(), 0);
+        DeleteGpuMesh(gpuMeshId);
+        MarkAssetMeshUnloaded(gpuMeshId);
     }
 
-    g_gpuMeshes[assetMeshName] = TGpuMesh{
-        .VertexPositionBuffer = buffers[0],
-        .VertexNormalUvTangentBuffer = buffers[1],
-        .IndexBuffer = buffers[2],
+    std::vector<uint64_t> releasedTextureHandles;
+    for (const auto assetMaterialId : releasedAssetMaterialIds) {
+        const auto gpuMaterialId = GetCanonicalAssetMaterialId(assetMaterialId);
+        if (!HasGpuResource(g_gpuMaterials, std::size_t(gpuMaterialId)) || isGpuMaterialUsed[std::size_t(gpuMaterialId)]) {
+            continue;
+        }
 
-        .VertexCount = assetMesh.VertexPositions.size(),
-        .IndexCount = assetMesh.Indices.size(),
+        releasedTextureHandles.push_back(g_gpuMaterials[std::size_t(gpuMaterialId)]->BaseColorTexture);
+        releasedTextureHandles.push_back(g_gpuMaterials[std::size_t(gpuMaterialId)]->NormalTexture);
+        g_gpuMaterials[std::size_t(gpuMaterialId)].reset();
+        MarkGpuMaterialDirty(gpuMaterialId);
+    }
+
+    // textures are shared through deduplicated images, a texture goes only once no remaining material samples it
+    for (const auto& gpuMaterial : g_gpuMaterials) {
+        if (gpuMaterial.has_value()) {
+            std::erase(releasedTextureHandles, gpuMaterial->BaseColorTexture);
+            std::erase(releasedTextureHandles, gpuMaterial->NormalTexture);
+        }
+    }
+
+    if (releasedTextureHandles.empty()) {
+        return;
+    }
+
+    for (std::size_t gpuTextureIndex = 0; gpuTextureIndex < g_gpuTextures.size(); ++gpuTextureIndex) {
+        const auto& gpuTexture = g_gpuTextures[gpuTextureIndex];
+        if (!gpuTexture.has_value() || std::ranges::find(releasedTextureHandles, gpuTexture->Handle) == releasedTextureHandles.end()) {
+            continue;
+        }
+
+        DeleteGpuTexture(TAssetImageId(gpuTextureIndex));
+        MarkAssetImageUnloaded(TAssetImageId(gpuTextureIndex));
+    }
+}
+
+auto TDefaultRenderer::DeleteGpuMesh(TAssetMeshId assetMeshId) -> void {
+
+    if (std::size_t(assetMeshId) >= g_gpuMeshes.size() || !g_gpuMeshes[std::size_t(assetMeshId)].has_value()) {
+        return;
+    }
+
+    // draws of this frame are recorded already, the ranges are only reused by uploads after them
+    auto& gpuMesh = *g_gpuMeshes[std::size_t(assetMeshId)];
+    _vertexMegaBuffer.Free(gpuMesh.BaseVertex, static_cast<uint32_t>(gpuMesh.VertexCount));
+    _positionMegaBuffer.Free(gpuMesh.FirstPositionWord, static_cast<uint32_t>(gpuMesh.PositionWordCount));
+    auto& indexMegaBuffer = gpuMesh.IndexElementType == TIndexElementType::UnsignedShort ? _shortIndexMegaBuffer : _indexMegaBuffer;
+    indexMegaBuffer.Free(gpuMesh.FirstIndex, static_cast<uint32_t>(gpuMesh.IndexCount));
+    _meshletMegaBuffer.Free(gpuMesh.FirstMeshlet, static_cast<uint32_t>(gpuMesh.MeshletCount));
+
+    g_gpuMeshes[std::size_t(assetMeshId)].reset();
+}
+
+auto TDefaultRenderer::DeleteGpuTexture(TAssetImageId assetImageId) -> void {
+
+    if (std::size_t(assetImageId) >= g_gpuTextures.size() || !g_gpuTextures[std::size_t(assetImageId)].has_value()) {
+        return;
+    }
+
+    DeleteTexture(g_gpuTextures[std::size_t(assetImageId)]->TextureId);
+    g_gpuTextures[std::size_t(assetImageId)].reset();
+}
+
+auto TDefaultRenderer::CreateGpuMesh(TAssetMeshId assetMeshId) -> void {
+
+    auto& gpuMeshSlot = GetGpuResourceSlot(g_gpuMeshes, std::size_t(assetMeshId));
+    if (gpuMeshSlot.has_value() || !MakeAssetMeshResident(assetMeshId)) {
+        return;
+    }
+
+    auto& assetMesh = GetAssetMesh(assetMeshId);
+
+    std::vector<TGpuMeshLod> gpuMeshLods;
+    gpuMeshLods.reserve(assetMesh.Lods.size());
+    for (const auto& assetMeshLod : assetMesh.Lods) {
+        gpuMeshLods.push_back(TGpuMeshLod{
+            .MeshletOffset = assetMeshLod.MeshletOffset,
+            .MeshletCount = assetMeshLod.MeshletCount,
+            .Error = assetMeshLod.Error,
+        });
+    }
+
+    const auto vertexCount = static_cast<uint32_t>(assetMesh.VertexNormalUvTangents.size());
+
+    // the dequantization only scales and offsets, so the bounds of the stored positions map straight to mesh space
+    auto storedBoundingBoxMin = glm::vec3(std::numeric_limits<float>::max());
+    auto storedBoundingBoxMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+        const auto vertexPosition = GetVertexPosition(assetMesh, vertexIndex);
+        storedBoundingBoxMin = glm::min(storedBoundingBoxMin, vertexPosition);
+        storedBoundingBoxMax = glm::max(storedBoundingBoxMax, vertexPosition);
+    }
+    const auto boundingBoxMin = glm::vec3(assetMesh.PositionDequantization * glm::vec4(storedBoundingBoxMin, 1.0f));
+    const auto boundingBoxMax = glm::vec3(assetMesh.PositionDequantization * glm::vec4(storedBoundingBoxMax, 1.0f));
+    const auto boundingSphere = vertexCount == 0
+        ? glm::vec4(0.0f)
+        : glm::vec4((boundingBoxMin + boundingBoxMax) * 0.5f, glm::distance(boundingBoxMin, boundingBoxMax) * 0.5f);
+
+    const auto positionWordCount = static_cast<uint32_t>(assetMesh.VertexPositions.size() / sizeof(uint32_t));
+    const auto indexCount = static_cast<uint32_t>(assetMesh.Indices.size() / GetIndexElementSize(assetMesh.IndexElementType));
+    const auto meshletCount = static_cast<uint32_t>(assetMesh.Meshlets.size());
+
+    const auto baseVertex = _vertexMegaBuffer.Allocate(vertexCount);
+    const auto firstPositionWord = _positionMegaBuffer.Allocate(positionWordCount);
+    // a multi draw needs a single index type, each type has its own mega buffer, indices stay relative to the base vertex
+    auto& indexMegaBuffer = assetMesh.IndexElementType == TIndexElementType::UnsignedShort ? _shortIndexMegaBuffer : _indexMegaBuffer;
+    const auto firstIndex = indexMegaBuffer.Allocate(indexCount);
+    const auto firstMeshlet = _meshletMegaBuffer.Allocate(meshletCount);
+
+    _vertexMegaBuffer.Upload(0, baseVertex, std::as_bytes(assetMesh.VertexNormalUvTangents));
+    _positionMegaBuffer.Upload(0, firstPositionWord, assetMesh.VertexPositions);
+    _meshletMegaBuffer.Upload(0, firstMeshlet, std::as_bytes(assetMesh.Meshlets));
+    indexMegaBuffer.Upload(0, firstIndex, assetMesh.Indices);
+
+    gpuMeshSlot = TGpuMesh{
+        .BaseVertex = baseVertex,
+        .FirstIndex = firstIndex,
+        .FirstMeshlet = firstMeshlet,
+        .FirstPositionWord = firstPositionWord,
+
+        .VertexCount = vertexCount,
+        .IndexCount = indexCount,
+        .MeshletCount = meshletCount,
+        .PositionWordCount = positionWordCount,
+
+        .Lods = std::move(gpuMeshLods),
+        .BoundingBoxMin = boundingBoxMin,
+        .BoundingBoxMax = boundingBoxMax,
+        .BoundingSphere = boundingSphere,
 
         .InitialTransform = assetMesh.InitialTransform,
+        .PositionDequantization = assetMesh.PositionDequantization,
+        .VertexPositionFormat = assetMesh.VertexPositionFormat,
+        .IndexElementType = assetMesh.IndexElementType,
     };
+    MarkAssetMeshUploaded(assetMeshId);
 }
 
-auto TDefaultRenderer::CreateGpuMaterial(const std::string& assetMaterialName) -> void {
+auto TDefaultRenderer::CreateGpuMaterial(TAssetMaterialId assetMaterialId) -> void {
 
-    auto& assetMaterial = GetAssetMaterial(assetMaterialName);
+    if (GetGpuResourceSlot(g_gpuMaterials, std::size_t(assetMaterialId)).has_value()) {
+        return;
+    }
+
+    auto& assetMaterial = GetAssetMaterial(assetMaterialId);
+
+    // a texture is created once, from a resident image, the material waits for evicted ones to be read back
+    const auto isImageReady = [](const std::optional<std::string>& assetImageName) {
+        if (!assetImageName.has_value()) {
+            return true;
+        }
+
+        const auto assetImageId = GetCanonicalAssetImageId(GetAssetImageId(*assetImageName));
+        return HasGpuResource(g_gpuTextures, std::size_t(assetImageId)) || !HasAssetImage(assetImageId) || MakeAssetImageResident(assetImageId);
+    };
+    const auto isBaseColorImageReady = isImageReady(assetMaterial.BaseColorImageName);
+    const auto isNormalImageReady = isImageReady(assetMaterial.NormalImageName);
+    if (!isBaseColorImageReady || !isNormalImageReady) {
+        return;
+    }
 
-    g_gpuMaterials[assetMaterialName] = TGpuMaterial{
+    // materials are created once, interning their image names here keeps the hashing off the render loop
+    auto gpuMaterial = TGpuMaterial{
+        .BaseColor = assetMaterial.BaseColor,
+        .BaseColorTexture = assetMaterial.BaseColorImageName.has_value() ? CreateGpuTexture(GetCanonicalAssetImageId(GetAssetImageId(*assetMaterial.BaseColorImageName))) : 0,
+        .NormalTexture = assetMaterial.NormalImageName.has_value() ? CreateGpuTexture(GetCanonicalAssetImageId(GetAssetImageId(*assetMaterial.NormalImageName))) : 0,
+    };
+    g_gpuMaterials[std::size_t(assetMaterialId)] = gpuMaterial;
+    MarkGpuMaterialDirty(assetMaterialId);
+}
+
+auto TDefaultRenderer::MarkGpuMaterialDirty(TAssetMaterialId assetMaterialId) -> void {
+
+    _dirtyGpuMaterialsBegin = std::min(_dirtyGpuMaterialsBegin, std::size_t(assetMaterialId));
+    _dirtyGpuMaterialsEnd = std::max(_dirtyGpuMaterialsEnd, std::size_t(assetMaterialId) + 1);
+}
+
+auto TDefaultRenderer::UploadDirtyGpuMaterials() -> void {
+
+    // the table is indexed by material id, growing it drops its content, so the whole table is uploaded again
+    if (g_gpuMaterials.size() > _gpuMaterialCapacity) {
+        EnsureBufferCapacity(_gpuMaterialBuffer, _gpuMaterialCapacity, g_gpuMaterials.size(), sizeof(TGpuMaterial), "Materials");
+        _dirtyGpuMaterialsBegin = 0;
+        _dirtyGpuMaterialsEnd = g_gpuMaterials.size();
+    }
+
+    if (_dirtyGpuMaterialsBegin >= _dirtyGpuMaterialsEnd) {
+        return;
+    }
+
+    // one contiguous range per frame, materials without a slot are zeroed, their texture handles read as none
+    std::vector<TGpuMaterial> dirtyGpuMaterials(_dirtyGpuMaterialsEnd - _dirtyGpuMaterialsBegin, TGpuMaterial{});
+    for (auto gpuMaterialIndex = _dirtyGpuMaterialsBegin; gpuMaterialIndex < _dirtyGpuMaterialsEnd; ++gpuMaterialIndex) {
+        if (const auto& gpuMaterial = g_gpuMaterials[gpuMaterialIndex]; gpuMaterial.has_value()) {
+            dirtyGpuMaterials[gpuMaterialIndex - _dirtyGpuMaterialsBegin] = *gpuMaterial;
+        }
+    }
+
+    UpdateBuffer(_gpuMaterialBuffer,
+                 static_cast<int64_t>(_dirtyGpuMaterialsBegin * sizeof(TGpuMaterial)),
+                 static_cast<int64_t>(dirtyGpuMaterials.size() * sizeof(TGpuMaterial)),
+                 dirtyGpuMaterials.data());
+
+    _dirtyGpuMaterialsBegin = SIZE_MAX;
+    _dirtyGpuMaterialsEnd = 0;
+}
+
+auto TDefaultRenderer::CreateGpuTexture(TAssetImageId assetImageId) -> uint64_t {
+
+    if (const auto& gpuTextureSlot = GetGpuResourceSlot(g_gpuTextures, std::size_t(assetImageId)); gpuTextureSlot.has_value()) {
+        return gpuTextureSlot->Handle;
+    }
+
+    if (!HasAssetImage(assetImageId)) {
+        return 0;
+    }
+
+    const auto& assetImageName = GetAssetImageName(assetImageId);
+    auto& assetImage = GetAssetImage(assetImageId);
+    if (assetImage.Pixels == nullptr || assetImage.Levels.empty()) {
+        return 0;
+    }
+
+    // compressed images are limited to the levels they bring, decoded ones arrive with their full chain,
+    // whatever is still missing is generated after the upload
+    const auto isCompressed = IsFormatCompressed(assetImage.Format);
+    const auto levelCount = isCompressed
+        ? static_cast<int32_t>(assetImage.Levels.size())
+        : static_cast<int32_t>(std::floor(std::log2(std::max(assetImage.Width, assetImage.Height)))) + 1;
+
+    auto textureId = CreateTexture({
+        .TextureType = TTextureType::Texture2D,
+        .Format = assetImage.Format,
+        .Extent = TExtent3D(assetImage.Width, assetImage.Height, 1),
+        .MipMapLevels = levelCount,
+        .Layers = 0,
+        .SampleCount = TSampleCount::One,
+        .Label = assetImageName,
+    });
+
+    for (uint32_t level = 0; auto& assetImageLevel : assetImage.Levels) {
+        UploadTexture(textureId, TUploadTextureDescriptor{
+            .Level = level,
+            .Offset = {},
+            .Extent = TExtent3D(assetImageLevel.Width, assetImageLevel.Height, 1),
+            .PixelData = assetImage.Pixels.get() + assetImageLevel.Offset,
+            .PixelDataSize = static_cast<int32_t>(assetImageLevel.Size),
+        });
+
+        level++;
+    }
+
+    if (static_cast<int32_t>(assetImage.Levels.size()) < levelCount) {
+        GenerateMipmaps(textureId);
+    }
 
+    const auto textureHandle = MakeTextureResident(textureId);
+    g_gpuTextures[std::size_t(assetImageId)] = TGpuTexture{
+        .TextureId = textureId,
+        .Handle = textureHandle,
     };
+    MarkAssetImageUploaded(assetImageId);
+    return textureHandle;
 }
 
-auto TDefaultRenderer::GetGpuMesh(const std::string& meshName) -> TGpuMesh& {
+auto TDefaultRenderer::GetGpuMesh(TAssetMeshId assetMeshId) -> TGpuMesh& {
 
-    return g_gpuMeshes[meshName];
+    assert(std::size_t(assetMeshId) < g_gpuMeshes.size() && g_gpuMeshes[std::size_t(assetMeshId)].has_value());
+    return *g_gpuMeshes[std::size_t(assetMeshId)];
 }
 
-auto TDefaultRenderer::GetGpuMaterial(const std::string& materialName) -> TGpuMaterial& {
+auto TDefaultRenderer::GetGpuMaterial(TAssetMaterialId assetMaterialId) -> TGpuMaterial& {
 
-    return g_gpuMaterials[materialName];
+    assert(std::size_t(assetMaterialId) < g_gpuMaterials.size() && g_gpuMaterials[std::size_t(assetMaterialId)].has_value());
+    return *g_gpuMaterials[std::size_t(assetMaterialId)];
 }
\ No newline at end of file
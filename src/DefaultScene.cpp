@@ -19,5 +19,24 @@ auto TDefaultScene::Load() -> bool {
 
     auto scannedAsset = *scannedAssetResult;
 
+    // only the layout of the scene is read up front, the entities are streamed in cell by cell around the viewer,
+    // each cell imports the meshes, materials and images it references, the window keeps rendering meanwhile
+    auto assetMeshInstancesResult = LoadAssetMeshInstances(scannedAsset.Name);
+    if (!assetMeshInstancesResult) {
+        spdlog::error(assetMeshInstancesResult.error());
+        return false;
+    }
+
+    AddStreamedAsset(scannedAsset.Name, TAssetImportSettings{ .OptimizeMeshes = true, .GenerateLods = true });
+    for (auto& assetMeshInstance : *assetMeshInstancesResult) {
+        AddStreamedEntity(TStreamedEntity{
+            .AssetName = scannedAsset.Name,
+            .InitialTransform = assetMeshInstance.WorldMatrix,
+            .AssetMeshName = std::move(assetMeshInstance.MeshName),
+            .AssetMaterialName = std::move(assetMeshInstance.MaterialName),
+            .InstanceMatrices = std::move(assetMeshInstance.InstanceMatrices),
+        });
+    }
+
     return true;
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include <Hephaestus/FrustumCulling.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include <poolstl/poolstl.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HEPHAESTUS_FRUSTUM_CULLING_SSE2
+#endif
+
+// below this many bounds per batch handing work to other cores costs more than the tests themselves
+constexpr std::size_t FrustumCullingBatchSize = 4096;
+
+auto TFrustumCullingBounds::Clear() -> void {
+
+    SphereCenterX.clear();
+    SphereCenterY.clear();
+    SphereCenterZ.clear();
+    SphereRadius.clear();
+    BoxCenterX.clear();
+    BoxCenterY.clear();
+    BoxCenterZ.clear();
+    BoxExtentX.clear();
+    BoxExtentY.clear();
+    BoxExtentZ.clear();
+}
+
+auto TFrustumCullingBounds::Add(const glm::vec4& sphere,
+                                const glm::vec3& boxMin,
+                                const glm::vec3& boxMax) -> void {
+
+    const auto boxCenter = (boxMin + boxMax) * 0.5f;
+    const auto boxExtent = (boxMax - boxMin) * 0.5f;
+
+    SphereCenterX.push_back(sphere.x);
+    SphereCenterY.push_back(sphere.y);
+    SphereCenterZ.push_back(sphere.z);
+    SphereRadius.push_back(sphere.w);
+    BoxCenterX.push_back(boxCenter.x);
+    BoxCenterY.push_back(boxCenter.y);
+    BoxCenterZ.push_back(boxCenter.z);
+    BoxExtentX.push_back(boxExtent.x);
+    BoxExtentY.push_back(boxExtent.y);
+    BoxExtentZ.push_back(boxExtent.z);
+}
+
+auto TFrustumCullingBounds::GetCount() const -> std::size_t {
+
+    return SphereRadius.size();
+}
+
+// summed in the order of the SSE2 path, so that both round alike and agree on bounds which touch a plane
+auto GetPlaneDistance(const glm::vec4& frustumPlane,
+                      const glm::vec3& position) -> float {
+
+    return (frustumPlane.x * position.x + frustumPlane.y * position.y) + (frustumPlane.z * position.z + frustumPlane.w);
+}
+
+// a sphere is outside when it lies entirely behind one plane, a box when its support point along the plane normal does,
+// tiny bounds are compared squared so that no square root or division is needed: radius * scale < minimum * distance
+auto IsBoundsVisible(const TFrustumCullingView& view,
+                     const TFrustumCullingBounds& bounds,
+                     std::size_t index) -> bool {
+
+    const auto sphereCenter = glm::vec3(bounds.SphereCenterX[index], bounds.SphereCenterY[index], bounds.SphereCenterZ[index]);
+    const auto sphereRadius = bounds.SphereRadius[index];
+    const auto boxCenter = glm::vec3(bounds.BoxCenterX[index], bounds.BoxCenterY[index], bounds.BoxCenterZ[index]);
+    const auto boxExtent = glm::vec3(bounds.BoxExtentX[index], bounds.BoxExtentY[index], bounds.BoxExtentZ[index]);
+
+    for (const auto& frustumPlane : view.FrustumPlanes) {
+        if (GetPlaneDistance(frustumPlane, sphereCenter) < -sphereRadius) {
+            return false;
+        }
+        if (GetPlaneDistance(frustumPlane, boxCenter) < -glm::dot(glm::abs(glm::vec3(frustumPlane)), boxExtent)) {
+            return false;
+        }
+    }
+
+    const auto projectedRadius = sphereRadius * view.ProjectionScale;
+    const auto toCamera = sphereCenter - view.CameraPosition;
+    return projectedRadius * projectedRadius >= view.MinimumProjectedRadius * view.MinimumProjectedRadius * glm::dot(toCamera, toCamera);
+}
+
+auto CullFrustumBatch(const TFrustumCullingView& view,
+                      const TFrustumCullingBounds& bounds,
+                      std::size_t first,
+                      std::size_t last,
+                      uint8_t* visibility) -> void {
+
+    auto index = first;
+
+#ifdef HEPHAESTUS_FRUSTUM_CULLING_SSE2
+    // four bounds per iteration, one lane each, every plane is broadcast once per iteration
+    const auto signMask = _mm_set1_ps(-0.0f);
+    const auto projectionScale = _mm_set1_ps(view.ProjectionScale);
+    const auto minimumProjectedRadius = _mm_set1_ps(view.MinimumProjectedRadius);
+    const auto cameraX = _mm_set1_ps(view.CameraPosition.x);
+    const auto cameraY = _mm_set1_ps(view.CameraPosition.y);
+    const auto cameraZ = _mm_set1_ps(view.CameraPosition.z);
+
+    for (; index + 4 <= last; index += 4) {
+        const auto sphereCenterX = _mm_loadu_ps(bounds.SphereCenterX.data() + index);
+        const auto sphereCenterY = _mm_loadu_ps(bounds.SphereCenterY.data() + index);
+        const auto sphereCenterZ = _mm_loadu_ps(bounds.SphereCenterZ.data() + index);
+        const auto sphereRadius = _mm_loadu_ps(bounds.SphereRadius.data() + index);
+        const auto boxCenterX = _mm_loadu_ps(bounds.BoxCenterX.data() + index);
+        const auto boxCenterY = _mm_loadu_ps(bounds.BoxCenterY.data() + index);
+        const auto boxCenterZ = _mm_loadu_ps(bounds.BoxCenterZ.data() + index);
+        const auto boxExtentX = _mm_loadu_ps(bounds.BoxExtentX.data() + index);
+        const auto boxExtentY = _mm_loadu_ps(bounds.BoxExtentY.data() + index);
+        const auto boxExtentZ = _mm_loadu_ps(bounds.BoxExtentZ.data() + index);
+        const auto negativeSphereRadius = _mm_xor_ps(sphereRadius, signMask);
+
+        auto isOutside = _mm_setzero_ps();
+        for (const auto& frustumPlane : view.FrustumPlanes) {
+            const auto planeX = _mm_set1_ps(frustumPlane.x);
+            const auto planeY = _mm_set1_ps(frustumPlane.y);
+            const auto planeZ = _mm_set1_ps(frustumPlane.z);
+            const auto planeW = _mm_set1_ps(frustumPlane.w);
+
+            const auto sphereDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, sphereCenterX), _mm_mul_ps(planeY, sphereCenterY)),
+                                                   _mm_add_ps(_mm_mul_ps(planeZ, sphereCenterZ), planeW));
+            isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(sphereDistance, negativeSphereRadius));
+
+            const auto boxDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX, boxCenterX), _mm_mul_ps(planeY, boxCenterY)),
+                                                _mm_add_ps(_mm_mul_ps(planeZ, boxCenterZ), planeW));
+            const auto boxRadius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, planeX), boxExtentX),
+                                                         _mm_mul_ps(_mm_andnot_ps(signMask, planeY), boxExtentY)),
+                                              _mm_mul_ps(_mm_andnot_ps(signMask, planeZ), boxExtentZ));
+            isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(boxDistance, _mm_xor_ps(boxRadius, signMask)));
+        }
+
+        const auto toCameraX = _mm_sub_ps(sphereCenterX, cameraX);
+        const auto toCameraY = _mm_sub_ps(sphereCenterY, cameraY);
+        const auto toCameraZ = _mm_sub_ps(sphereCenterZ, cameraZ);
+        const auto distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toCameraX, toCameraX), _mm_mul_ps(toCameraY, toCameraY)),
+                                                _mm_mul_ps(toCameraZ, toCameraZ));
+        const auto projectedRadius = _mm_mul_ps(sphereRadius, projectionScale);
+        const auto isTiny = _mm_cmplt_ps(_mm_mul_ps(projectedRadius, projectedRadius),
+                                         _mm_mul_ps(_mm_mul_ps(minimumProjectedRadius, minimumProjectedRadius), distanceSquared));
+
+        const auto culledMask = _mm_movemask_ps(_mm_or_ps(isOutside, isTiny));
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            visibility[index + lane] = (culledMask & (1 << lane)) == 0 ? 1 : 0;
+        }
+    }
+#endif
+
+    for (; index < last; ++index) {
+        visibility[index] = IsBoundsVisible(view, bounds, index) ? 1 : 0;
+    }
+}
+
+auto CullFrustum(const TFrustumCullingView& view,
+                 const TFrustumCullingBounds& bounds,
+                 std::span<uint8_t> visibility) -> void {
+
+    const auto count = bounds.GetCount();
+    assert(visibility.size() >= count);
+
+    if (count <= FrustumCullingBatchSize) {
+        CullFrustumBatch(view, bounds, 0, count, visibility.data());
+        return;
+    }
+
+    // batches write disjoint ranges of visibility, they need no synchronization
+    std::vector<std::size_t> batchFirsts;
+    for (std::size_t first = 0; first < count; first += FrustumCullingBatchSize) {
+        batchFirsts.push_back(first);
+    }
+
+    std::for_each(poolstl::par, batchFirsts.begin(), batchFirsts.end(), [&](std::size_t first) {
+        CullFrustumBatch(view, bounds, first, std::min(first + FrustumCullingBatchSize, count), visibility.data());
+    });
+}
\ No newline at end of file
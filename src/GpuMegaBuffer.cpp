@@ -0,0 +1,119 @@
+#include <Hephaestus/GpuMegaBuffer.hpp>
+#include <Hephaestus/RHI/Buffer.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+#include <glad/gl.h>
+
+// small enough to not matter for an empty scene, large enough to not grow for every mesh of a small one
+constexpr uint32_t InitialMegaBufferCapacity = 64 * 1024;
+
+auto TGpuMegaBuffer::AddStream(const std::string& label,
+                               uint32_t elementSize) -> void {
+
+    assert(_capacity == 0);
+    _streams.push_back(TStream{
+        .Label = label,
+        .ElementSize = elementSize,
+        .Buffer = 0,
+    });
+}
+
+auto TGpuMegaBuffer::Delete() -> void {
+
+    for (auto& stream : _streams) {
+        DeleteBuffer(stream.Buffer);
+        stream.Buffer = 0;
+    }
+
+    _freeRanges.clear();
+    _capacity = 0;
+}
+
+auto TGpuMegaBuffer::Allocate(uint32_t elementCount) -> uint32_t {
+
+    auto freeRange = std::ranges::find_if(_freeRanges, [&](const auto& range) {
+        return range.second >= elementCount;
+    });
+
+    if (freeRange == _freeRanges.end()) {
+        Grow(_capacity + elementCount);
+        freeRange = std::ranges::find_if(_freeRanges, [&](const auto& range) {
+            return range.second >= elementCount;
+        });
+        assert(freeRange != _freeRanges.end());
+    }
+
+    const auto [elementOffset, freeElementCount] = *freeRange;
+    _freeRanges.erase(freeRange);
+    if (freeElementCount > elementCount) {
+        _freeRanges.emplace(elementOffset + elementCount, freeElementCount - elementCount);
+    }
+
+    return elementOffset;
+}
+
+auto TGpuMegaBuffer::Free(uint32_t elementOffset,
+                          uint32_t elementCount) -> void {
+
+    if (elementCount == 0) {
+        return;
+    }
+
+    auto [freeRange, isInserted] = _freeRanges.emplace(elementOffset, elementCount);
+    assert(isInserted);
+
+    if (auto nextRange = std::next(freeRange); nextRange != _freeRanges.end() && freeRange->first + freeRange->second == nextRange->first) {
+        freeRange->second += nextRange->second;
+        _freeRanges.erase(nextRange);
+    }
+
+    if (freeRange != _freeRanges.begin()) {
+        if (auto previousRange = std::prev(freeRange); previousRange->first + previousRange->second == freeRange->first) {
+            previousRange->second += freeRange->second;
+            _freeRanges.erase(freeRange);
+        }
+    }
+}
+
+auto TGpuMegaBuffer::Upload(std::size_t streamIndex,
+                            uint32_t elementOffset,
+                            std::span<const std::byte> bytes) -> void {
+
+    const auto& stream = _streams[streamIndex];
+    assert(elementOffset + bytes.size() / stream.ElementSize <= _capacity);
+    UpdateBuffer(stream.Buffer,
+                 static_cast<int64_t>(elementOffset) * stream.ElementSize,
+                 static_cast<int64_t>(bytes.size()),
+                 bytes.data());
+}
+
+auto TGpuMegaBuffer::GetBuffer(std::size_t streamIndex) const -> uint32_t {
+
+    return _streams[streamIndex].Buffer;
+}
+
+auto TGpuMegaBuffer::GetCapacity() const -> uint32_t {
+
+    return _capacity;
+}
+
+auto TGpuMegaBuffer::Grow(uint32_t minimumCapacity) -> void {
+
+    const auto capacity = std::max({minimumCapacity, _capacity * 2, InitialMegaBufferCapacity});
+    for (auto& stream : _streams) {
+
+        const auto buffer = CreateBuffer(stream.Label, static_cast<int64_t>(capacity) * stream.ElementSize, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        if (stream.Buffer != 0) {
+            glCopyNamedBufferSubData(stream.Buffer, buffer, 0, 0, static_cast<int64_t>(_capacity) * stream.ElementSize);
+            DeleteBuffer(stream.Buffer);
+        }
+        stream.Buffer = buffer;
+    }
+
+    // the new tail is free, merging keeps a free range at the old end in one piece
+    Free(_capacity, capacity - _capacity);
+    _capacity = capacity;
+}
\ No newline at end of file
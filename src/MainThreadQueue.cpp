@@ -0,0 +1,27 @@
+#include <Hephaestus/MainThreadQueue.hpp>
+
+#include <mutex>
+#include <vector>
+
+std::mutex g_mainThreadQueueMutex;
+std::vector<std::function<void()>> g_mainThreadQueue = {};
+
+auto EnqueueOnMainThread(std::function<void()> task) -> void {
+
+    std::lock_guard lock(g_mainThreadQueueMutex);
+    g_mainThreadQueue.push_back(std::move(task));
+}
+
+auto DrainMainThreadQueue() -> void {
+
+    // swap first, tasks may enqueue further tasks, those run next frame
+    std::vector<std::function<void()>> tasks;
+    {
+        std::lock_guard lock(g_mainThreadQueueMutex);
+        tasks.swap(g_mainThreadQueue);
+    }
+
+    for (auto& task : tasks) {
+        task();
+    }
+}
\ No newline at end of file
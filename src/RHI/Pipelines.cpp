@@ -18,6 +18,17 @@ uint32_t g_lastIndexBuffer = 0;
 std::vector<TGraphicsPipeline> g_graphicsPipelines = {};
 std::vector<TComputePipeline> g_computePipelines = {};
 
+constexpr auto IndexElementTypeToGL(TIndexElementType indexElementType) -> uint32_t {
+    switch (indexElementType) {
+        case TIndexElementType::UnsignedShort:
+            return GL_UNSIGNED_SHORT;
+        case TIndexElementType::UnsignedInteger:
+            return GL_UNSIGNED_INT;
+        default:
+            std::unreachable();
+    }
+}
+
 auto GetGraphicsPipeline(TGraphicsPipelineId graphicsPipelineId) -> TGraphicsPipeline& {
     assert(graphicsPipelineId != TGraphicsPipelineId::Invalid);
     return g_graphicsPipelines[static_cast<size_t>(graphicsPipelineId)];
@@ -57,6 +68,13 @@ auto TPipeline::BindTextureAndSampler(int32_t bindingIndex,
     glBindSampler(bindingIndex, sampler);
 }
 
+auto TPipeline::BindTextureAsImage(int32_t bindingIndex,
+                                   uint32_t texture,
+                                   int32_t level,
+                                   TFormat format) -> void {
+    glBindImageTexture(bindingIndex, texture, level, GL_FALSE, 0, GL_READ_WRITE, FormatToGL(format));
+}
+
 auto TPipeline::SetUniform(int32_t location,
                            float value) -> void {
     glProgramUniform1f(Id, location, value);
@@ -140,25 +158,63 @@ auto TGraphicsPipeline::DrawArrays(int32_t vertexOffset,
 }
 
 auto TGraphicsPipeline::DrawElements(uint32_t indexBuffer,
-                                     int32_t elementCount) -> void {
+                                     int32_t elementCount,
+                                     TIndexElementType indexElementType) -> void {
 
     if (g_lastIndexBuffer != indexBuffer) {
         glVertexArrayElementBuffer(InputLayout.has_value() ? InputLayout.value() : g_defaultInputLayout, indexBuffer);
         g_lastIndexBuffer = indexBuffer;
     }
 
-    glDrawElements(PrimitiveTopology, elementCount, GL_UNSIGNED_INT, nullptr);
+    glDrawElements(PrimitiveTopology, elementCount, IndexElementTypeToGL(indexElementType), nullptr);
 }
 
 auto TGraphicsPipeline::DrawElementsInstanced(uint32_t indexBuffer,
                                               int32_t elementCount,
+                                              TIndexElementType indexElementType,
                                               int32_t instanceCount) -> void {
     if (g_lastIndexBuffer != indexBuffer) {
         glVertexArrayElementBuffer(InputLayout.has_value() ? InputLayout.value() : g_defaultInputLayout, indexBuffer);
         g_lastIndexBuffer = indexBuffer;
     }
 
-    glDrawElementsInstanced(PrimitiveTopology, elementCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+    glDrawElementsInstanced(PrimitiveTopology, elementCount, IndexElementTypeToGL(indexElementType), nullptr, instanceCount);
+}
+
+auto TGraphicsPipeline::MultiDrawElementsIndirectCount(uint32_t indexBuffer,
+                                                       TIndexElementType indexElementType,
+                                                       uint32_t commandBuffer,
+                                                       int64_t commandBufferOffset,
+                                                       uint32_t countBuffer,
+                                                       int64_t countBufferOffset,
+                                                       int32_t maxDrawCount) -> void {
+    if (g_lastIndexBuffer != indexBuffer) {
+        glVertexArrayElementBuffer(InputLayout.has_value() ? InputLayout.value() : g_defaultInputLayout, indexBuffer);
+        g_lastIndexBuffer = indexBuffer;
+    }
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBindBuffer(GL_PARAMETER_BUFFER, countBuffer);
+    glMultiDrawElementsIndirectCount(PrimitiveTopology,
+                                     IndexElementTypeToGL(indexElementType),
+                                     reinterpret_cast<const void*>(commandBufferOffset),
+                                     countBufferOffset,
+                                     maxDrawCount,
+                                     0);
+}
+
+auto TComputePipeline::Dispatch(uint32_t workGroupCountX,
+                                uint32_t workGroupCountY,
+                                uint32_t workGroupCountZ) -> void {
+
+    glDispatchCompute(workGroupCountX, workGroupCountY, workGroupCountZ);
+}
+
+auto TComputePipeline::DispatchIndirect(uint32_t commandBuffer,
+                                        int64_t commandBufferOffset) -> void {
+
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, commandBuffer);
+    glDispatchComputeIndirect(commandBufferOffset);
 }
 
 auto DeleteGraphicsPipeline(const TGraphicsPipelineId& graphicsPipelineId) -> void {
@@ -392,7 +448,7 @@ auto CreateGraphicsPipeline(const TGraphicsPipelineDescriptor& graphicsPipelineD
 
 auto CreateComputePipeline(const TComputePipelineDescriptor& computePipelineDescriptor) -> std::expected<TComputePipelineId, std::string> {
 
-    const auto id = TComputePipelineId(g_graphicsPipelines.size());
+    const auto id = TComputePipelineId(g_computePipelines.size());
     auto& pipeline = g_computePipelines.emplace_back();
 
     auto computeProgramResult = CreateComputeProgram(computePipelineDescriptor.Label,
@@ -326,16 +326,22 @@ auto FormatToGL(TFormat format) -> uint32_t {
             return GL_DEPTH24_STENCIL8;
         case TFormat::S8_UINT:
             return GL_STENCIL_INDEX8;
-            /*
-            case TFormat::BC1_RGB_UNORM: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
-            case TFormat::BC1_RGBA_UNORM: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-            case TFormat::BC1_RGB_SRGB: return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
-            case TFormat::BC1_RGBA_SRGB: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
-            case TFormat::BC2_RGBA_UNORM: return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-            case TFormat::BC2_RGBA_SRGB: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
-            case TFormat::BC3_RGBA_UNORM: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-            case TFormat::BC3_RGBA_SRGB: return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
-            */
+        case TFormat::BC1_RGB_UNORM:
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TFormat::BC1_RGBA_UNORM:
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case TFormat::BC1_RGB_SRGB:
+            return GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+        case TFormat::BC1_RGBA_SRGB:
+            return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+        case TFormat::BC2_RGBA_UNORM:
+            return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        case TFormat::BC2_RGBA_SRGB:
+            return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT;
+        case TFormat::BC3_RGBA_UNORM:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TFormat::BC3_RGBA_SRGB:
+            return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
         case TFormat::BC4_R_UNORM:
             return GL_COMPRESSED_RED_RGTC1;
         case TFormat::BC4_R_SNORM:
@@ -360,6 +366,31 @@ auto FormatToGL(TFormat format) -> uint32_t {
     }
 }
 
+auto IsFormatCompressed(TFormat format) -> bool {
+
+    switch (format) {
+        case TFormat::BC1_RGB_UNORM:
+        case TFormat::BC1_RGB_SRGB:
+        case TFormat::BC1_RGBA_UNORM:
+        case TFormat::BC1_RGBA_SRGB:
+        case TFormat::BC2_RGBA_UNORM:
+        case TFormat::BC2_RGBA_SRGB:
+        case TFormat::BC3_RGBA_UNORM:
+        case TFormat::BC3_RGBA_SRGB:
+        case TFormat::BC4_R_UNORM:
+        case TFormat::BC4_R_SNORM:
+        case TFormat::BC5_RG_UNORM:
+        case TFormat::BC5_RG_SNORM:
+        case TFormat::BC6H_RGB_UFLOAT:
+        case TFormat::BC6H_RGB_SFLOAT:
+        case TFormat::BC7_RGBA_UNORM:
+        case TFormat::BC7_RGBA_SRGB:
+            return true;
+        default:
+            return false;
+    }
+}
+
 auto FormatToBaseTypeClass(TFormat format) -> TBaseTypeClass {
     switch (format) {
         case TFormat::R8_UNORM:
@@ -386,6 +417,7 @@ auto FormatToBaseTypeClass(TFormat format) -> TBaseTypeClass {
         case TFormat::R10G10B10A2_UNORM:
         case TFormat::R12G12B12A12_UNORM:
         case TFormat::R16G16B16A16_UNORM:
+        case TFormat::R16G16B16A16_SNORM:
         case TFormat::R8G8B8_SRGB:
         case TFormat::R8G8B8A8_SRGB:
         case TFormat::R16_FLOAT:
@@ -630,6 +662,7 @@ auto FormatToComponentCount(TFormat format) -> int32_t {
         case TFormat::R8G8B8A8_UNORM:
         case TFormat::R8G8B8A8_SNORM:
         case TFormat::R16G16B16A16_UNORM:
+        case TFormat::R16G16B16A16_SNORM:
         case TFormat::R16G16B16A16_FLOAT:
         case TFormat::R32G32B32A32_FLOAT:
         case TFormat::R8G8B8A8_SINT:
@@ -662,6 +695,7 @@ auto IsFormatNormalized(TFormat format) -> int32_t {
         case TFormat::R8G8B8A8_UNORM:
         case TFormat::R8G8B8A8_SNORM:
         case TFormat::R16G16B16A16_UNORM:
+        case TFormat::R16G16B16A16_SNORM:
             return GL_TRUE;
         case TFormat::R16_FLOAT:
         case TFormat::R32_FLOAT:
@@ -718,6 +752,7 @@ auto FormatToFormatClass(TFormat format) -> TFormatClass {
         case TFormat::R8G8B8A8_UNORM:
         case TFormat::R8G8B8A8_SNORM:
         case TFormat::R16G16B16A16_UNORM:
+        case TFormat::R16G16B16A16_SNORM:
         case TFormat::R16_FLOAT:
         case TFormat::R16G16_FLOAT:
         case TFormat::R16G16B16_FLOAT:
@@ -879,6 +914,47 @@ auto UploadTexture(const TTextureId& textureId,
 
     auto& texture = GetTexture(textureId);
 
+    // block compressed data goes up as is, there is no format or type to convert from
+    if (IsFormatCompressed(texture.Format)) {
+        const auto internalFormat = FormatToGL(texture.Format);
+        switch (TextureTypeToDimension(texture.TextureType)) {
+            case 1:
+                glCompressedTextureSubImage1D(texture.Id,
+                                              updateTextureDescriptor.Level,
+                                              updateTextureDescriptor.Offset.X,
+                                              updateTextureDescriptor.Extent.Width,
+                                              internalFormat,
+                                              updateTextureDescriptor.PixelDataSize,
+                                              updateTextureDescriptor.PixelData);
+                break;
+            case 2:
+                glCompressedTextureSubImage2D(texture.Id,
+                                              updateTextureDescriptor.Level,
+                                              updateTextureDescriptor.Offset.X,
+                                              updateTextureDescriptor.Offset.Y,
+                                              updateTextureDescriptor.Extent.Width,
+                                              updateTextureDescriptor.Extent.Height,
+                                              internalFormat,
+                                              updateTextureDescriptor.PixelDataSize,
+                                              updateTextureDescriptor.PixelData);
+                break;
+            case 3:
+                glCompressedTextureSubImage3D(texture.Id,
+                                              updateTextureDescriptor.Level,
+                                              updateTextureDescriptor.Offset.X,
+                                              updateTextureDescriptor.Offset.Y,
+                                              updateTextureDescriptor.Offset.Z,
+                                              updateTextureDescriptor.Extent.Width,
+                                              updateTextureDescriptor.Extent.Height,
+                                              updateTextureDescriptor.Extent.Depth,
+                                              internalFormat,
+                                              updateTextureDescriptor.PixelDataSize,
+                                              updateTextureDescriptor.PixelData);
+                break;
+        }
+        return;
+    }
+
     uint32_t format = 0;
     if (updateTextureDescriptor.UploadFormat == TUploadFormat::Auto) {
         format = UploadFormatToGL(FormatToUploadFormat(texture.Format));
@@ -940,6 +1016,15 @@ auto MakeTextureResident(const TTextureId& textureId) -> uint64_t {
     return textureHandle;
 }
 
+auto DeleteTexture(const TTextureId& textureId) -> void {
+
+    auto& texture = GetTexture(textureId);
+
+    // deleting the texture releases its handles, resident ones included
+    glDeleteTextures(1, &texture.Id);
+    texture.Id = 0;
+}
+
 auto GenerateMipmaps(const TTextureId& textureId) -> void {
 
     auto& texture = GetTexture(textureId);
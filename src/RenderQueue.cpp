@@ -0,0 +1,87 @@
+#include <Hephaestus/RenderQueue.hpp>
+
+#include <array>
+#include <bit>
+#include <utility>
+
+constexpr uint32_t DrawSortKeyDepthBits = 16;
+constexpr uint32_t DrawSortKeyMeshBits = 20;
+constexpr uint32_t DrawSortKeyMaterialBits = 20;
+constexpr uint32_t DrawSortKeyPipelineBits = 6;
+constexpr uint32_t DrawSortKeyPassBits = 2;
+
+constexpr uint32_t RadixBits = 8;
+constexpr uint32_t RadixBucketCount = 1u << RadixBits;
+constexpr uint32_t RadixPassCount = 64 / RadixBits;
+
+auto MakeDrawSortKey(uint32_t pass,
+                     uint32_t pipeline,
+                     uint32_t material,
+                     uint32_t mesh,
+                     float viewDepth) -> uint64_t {
+
+    // the bits of a non negative float order like the float itself, the upper 16 keep sign, exponent and 7 bits of mantissa
+    const auto depth = std::bit_cast<uint32_t>(viewDepth > 0.0f ? viewDepth : 0.0f) >> (32 - DrawSortKeyDepthBits);
+
+    auto sortKey = static_cast<uint64_t>(pass & ((1u << DrawSortKeyPassBits) - 1));
+    sortKey = (sortKey << DrawSortKeyPipelineBits) | (pipeline & ((1u << DrawSortKeyPipelineBits) - 1));
+    sortKey = (sortKey << DrawSortKeyMaterialBits) | (material & ((1u << DrawSortKeyMaterialBits) - 1));
+    sortKey = (sortKey << DrawSortKeyMeshBits) | (mesh & ((1u << DrawSortKeyMeshBits) - 1));
+    sortKey = (sortKey << DrawSortKeyDepthBits) | depth;
+    return sortKey;
+}
+
+auto TRenderQueue::Clear() -> void {
+
+    _sortKeys.clear();
+    _drawIndices.clear();
+}
+
+auto TRenderQueue::Add(uint64_t sortKey,
+                       uint32_t drawIndex) -> void {
+
+    _sortKeys.push_back(sortKey);
+    _drawIndices.push_back(drawIndex);
+}
+
+auto TRenderQueue::Sort() -> void {
+
+    // all histograms in one read, a byte which is the same for every key leaves the order as it is and its pass is skipped,
+    // with few materials and meshes most of the upper bytes are
+    std::array<std::array<uint32_t, RadixBucketCount>, RadixPassCount> histograms = {};
+    for (const auto sortKey : _sortKeys) {
+        for (uint32_t radixPass = 0; radixPass < RadixPassCount; ++radixPass) {
+            histograms[radixPass][(sortKey >> (radixPass * RadixBits)) & (RadixBucketCount - 1)]++;
+        }
+    }
+
+    _scratchSortKeys.resize(_sortKeys.size());
+    _scratchDrawIndices.resize(_drawIndices.size());
+
+    for (uint32_t radixPass = 0; radixPass < RadixPassCount; ++radixPass) {
+
+        auto& histogram = histograms[radixPass];
+        if (_sortKeys.empty() || histogram[(_sortKeys.front() >> (radixPass * RadixBits)) & (RadixBucketCount - 1)] == _sortKeys.size()) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (auto& bucket : histogram) {
+            offset += std::exchange(bucket, offset);
+        }
+
+        for (std::size_t index = 0; index < _sortKeys.size(); ++index) {
+            const auto destination = histogram[(_sortKeys[index] >> (radixPass * RadixBits)) & (RadixBucketCount - 1)]++;
+            _scratchSortKeys[destination] = _sortKeys[index];
+            _scratchDrawIndices[destination] = _drawIndices[index];
+        }
+
+        std::swap(_sortKeys, _scratchSortKeys);
+        std::swap(_drawIndices, _scratchDrawIndices);
+    }
+}
+
+auto TRenderQueue::GetDrawIndices() const -> std::span<const uint32_t> {
+
+    return _drawIndices;
+}
\ No newline at end of file
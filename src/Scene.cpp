@@ -1,11 +1,23 @@
 #include <Hephaestus/Scene.hpp>
 
+#include <Hephaestus/Assets/Assets.hpp>
+
+#include <Hephaestus/Components/InstancesComponent.hpp>
 #include <Hephaestus/Components/MeshComponent.hpp>
 #include <Hephaestus/Components/TransformComponent.hpp>
 #include <Hephaestus/Components/MaterialComponent.hpp>
 #include <Hephaestus/Components/ParentComponent.hpp>
 #include <Hephaestus/Components/TagCreateGpuResourcesComponent.hpp>
 
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+auto GetCellKey(const glm::ivec2& cellCoordinate) -> uint64_t {
+
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cellCoordinate.x)) << 32) | static_cast<uint32_t>(cellCoordinate.y);
+}
+
 auto TScene::GetRegistry() -> entt::registry& {
     return _registry;
 }
@@ -13,7 +25,8 @@ auto TScene::GetRegistry() -> entt::registry& {
 auto TScene::AddEntity(std::optional<entt::entity> parent,
                        glm::mat4x4 initialTransform,
                        const std::string &assetMeshName,
-                       const std::string &assetMaterialName) -> entt::entity {
+                       const std::string &assetMaterialName,
+                       std::span<const glm::mat4> instanceMatrices) -> entt::entity {
 
     auto entity = _registry.create();
     if (parent.has_value()) {
@@ -22,13 +35,232 @@ auto TScene::AddEntity(std::optional<entt::entity> parent,
         _registry.emplace<TChildOfComponent>(entity, parent.value());
     }
     if (!assetMeshName.empty()) {
-        _registry.emplace<TMeshComponent>(entity, assetMeshName);
+        _registry.emplace<TMeshComponent>(entity, GetAssetMeshId(assetMeshName));
     }
     if (!assetMaterialName.empty()) {
-        _registry.emplace<TMaterialComponent>(entity, assetMaterialName);
+        _registry.emplace<TMaterialComponent>(entity, GetAssetMaterialId(assetMaterialName));
+    }
+    if (!instanceMatrices.empty()) {
+        _registry.emplace<TInstancesComponent>(entity, std::vector<glm::mat4>(instanceMatrices.begin(), instanceMatrices.end()));
     }
     _registry.emplace<TTransformComponent>(entity, initialTransform);
     _registry.emplace<TTagCreateGpuResourcesComponent>(entity);
 
     return entity;
 }
+
+
+auto TScene::AddStreamedEntity(TStreamedEntity&& streamedEntity) -> void {
+
+    if (_streamingSettings.CellSize <= 0.0f) {
+        // nothing is ever unloaded without cells, the entity waits in the renderer until its mesh is published
+        auto streamedAsset = _streamedAssets.find(streamedEntity.AssetName);
+        if (streamedAsset != _streamedAssets.end() && !_assetMeshLoads.contains(streamedEntity.AssetMeshName)) {
+            _assetMeshLoads[streamedEntity.AssetMeshName] = LoadAssetMeshesAsync(streamedEntity.AssetName,
+                                                                                 std::span(&streamedEntity.AssetMeshName, 1),
+                                                                                 streamedAsset->second.ImportSettings);
+        }
+
+        AddEntity(std::nullopt,
+                  streamedEntity.InitialTransform,
+                  streamedEntity.AssetMeshName,
+                  streamedEntity.AssetMaterialName,
+                  streamedEntity.InstanceMatrices);
+        return;
+    }
+
+    const auto translation = glm::vec3(streamedEntity.InitialTransform[3]);
+    const auto cellCoordinate = glm::ivec2(glm::floor(glm::vec2(translation.x, translation.z) / _streamingSettings.CellSize));
+
+    auto& cell = _cells[GetCellKey(cellCoordinate)];
+    cell.Coordinate = cellCoordinate;
+    // a cell which is loading or loaded already imports what the entity needs and picks it up with the remaining ones
+    if (cell.State != TSceneCellState::Unloaded) {
+        TAssetMeshNamesToLoad assetMeshNamesToLoad;
+        AcquireStreamedEntityAssets(cell, streamedEntity, assetMeshNamesToLoad);
+        LoadStreamedAssetMeshes(cell, assetMeshNamesToLoad);
+        cell.State = TSceneCellState::Loading;
+    }
+    cell.StreamedEntities.push_back(std::move(streamedEntity));
+}
+
+auto TScene::AddStreamedAsset(const std::string& assetName,
+                              const TAssetImportSettings& importSettings) -> void {
+
+    _streamedAssets[assetName] = TStreamedAsset{
+        .ImportSettings = importSettings,
+    };
+}
+
+auto TScene::SetStreamingSettings(const TSceneStreamingSettings& streamingSettings) -> void {
+
+    _streamingSettings = streamingSettings;
+}
+
+auto TScene::AcquireStreamedEntityAssets(TSceneCell& cell,
+                                         const TStreamedEntity& streamedEntity,
+                                         TAssetMeshNamesToLoad& assetMeshNamesToLoad) -> void {
+
+    if (!_streamedAssets.contains(streamedEntity.AssetName)) {
+        return;
+    }
+
+    if (!streamedEntity.AssetMaterialName.empty() &&
+        std::ranges::find(cell.AssetMaterialNames, streamedEntity.AssetMaterialName) == cell.AssetMaterialNames.end()) {
+        cell.AssetMaterialNames.push_back(streamedEntity.AssetMaterialName);
+        _assetMaterialReferenceCounts[streamedEntity.AssetMaterialName]++;
+    }
+
+    if (streamedEntity.AssetMeshName.empty() ||
+        std::ranges::find(cell.AssetMeshNames, streamedEntity.AssetMeshName) != cell.AssetMeshNames.end()) {
+        return;
+    }
+
+    cell.AssetMeshNames.push_back(streamedEntity.AssetMeshName);
+    _assetMeshReferenceCounts[streamedEntity.AssetMeshName]++;
+
+    if (auto assetMeshLoad = _assetMeshLoads.find(streamedEntity.AssetMeshName); assetMeshLoad != _assetMeshLoads.end()) {
+        cell.AssetLoads.push_back(assetMeshLoad->second);
+        return;
+    }
+
+    assetMeshNamesToLoad[streamedEntity.AssetName].push_back(streamedEntity.AssetMeshName);
+}
+
+// one import per asset and batch, its materials and images come along and are shared with the other imports
+auto TScene::LoadStreamedAssetMeshes(TSceneCell& cell,
+                                     const TAssetMeshNamesToLoad& assetMeshNamesToLoad) -> void {
+
+    for (const auto& [assetName, assetMeshNames] : assetMeshNamesToLoad) {
+        auto assetMeshesLoad = LoadAssetMeshesAsync(assetName, assetMeshNames, _streamedAssets.at(assetName).ImportSettings);
+        for (const auto& assetMeshName : assetMeshNames) {
+            _assetMeshLoads[assetMeshName] = assetMeshesLoad;
+        }
+
+        cell.AssetLoads.push_back(std::move(assetMeshesLoad));
+    }
+}
+
+auto TScene::LoadCell(TSceneCell& cell) -> void {
+
+    // only what the entities of the cell reference is imported, every mesh once, cells sharing it wait on the same import
+    TAssetMeshNamesToLoad assetMeshNamesToLoad;
+    for (const auto& streamedEntity : cell.StreamedEntities) {
+        AcquireStreamedEntityAssets(cell, streamedEntity, assetMeshNamesToLoad);
+    }
+
+    LoadStreamedAssetMeshes(cell, assetMeshNamesToLoad);
+    cell.State = TSceneCellState::Loading;
+}
+
+auto TScene::UnloadCell(TSceneCell& cell) -> void {
+
+    for (auto entity : cell.Entities) {
+        if (_registry.valid(entity)) {
+            _registry.destroy(entity);
+        }
+    }
+
+    // the last cell referencing a mesh or material releases it, the payloads stay published, the renderer drops the
+    // GPU resources no entity uses anymore and with them the CPU copies, a later cell imports or reads them back again
+    for (const auto& assetMeshName : cell.AssetMeshNames) {
+        auto assetMeshReferenceCount = _assetMeshReferenceCounts.find(assetMeshName);
+        if (--assetMeshReferenceCount->second == 0) {
+            _assetMeshReferenceCounts.erase(assetMeshReferenceCount);
+            _assetMeshLoads.erase(assetMeshName);
+            ReleaseAssetMesh(GetAssetMeshId(assetMeshName));
+        }
+    }
+
+    for (const auto& assetMaterialName : cell.AssetMaterialNames) {
+        auto assetMaterialReferenceCount = _assetMaterialReferenceCounts.find(assetMaterialName);
+        if (--assetMaterialReferenceCount->second == 0) {
+            _assetMaterialReferenceCounts.erase(assetMaterialReferenceCount);
+            ReleaseAssetMaterial(GetAssetMaterialId(assetMaterialName));
+        }
+    }
+
+    cell.Entities.clear();
+    cell.AssetMeshNames.clear();
+    cell.AssetMaterialNames.clear();
+    cell.AssetLoads.clear();
+    cell.State = TSceneCellState::Unloaded;
+}
+
+auto TScene::Stream(const glm::vec3& viewerPosition,
+                    std::chrono::steady_clock::time_point deadline) -> void {
+
+    if (_cells.empty()) {
+        return;
+    }
+
+    const auto viewerCellPosition = glm::vec2(viewerPosition.x, viewerPosition.z);
+    auto getCellDistance = [&](const TSceneCell& cell) {
+        const auto cellMin = glm::vec2(cell.Coordinate) * _streamingSettings.CellSize;
+        const auto cellMax = cellMin + _streamingSettings.CellSize;
+        return glm::distance(viewerCellPosition, glm::clamp(viewerCellPosition, cellMin, cellMax));
+    };
+
+    std::vector<std::pair<float, TSceneCell*>> creatingCells;
+    for (auto& [cellKey, cell] : _cells) {
+
+        const auto cellDistance = getCellDistance(cell);
+        if (cell.State == TSceneCellState::Unloaded) {
+            if (cellDistance < _streamingSettings.LoadDistance) {
+                LoadCell(cell);
+            }
+        } else if (cellDistance > _streamingSettings.UnloadDistance) {
+            UnloadCell(cell);
+            continue;
+        }
+
+        if (cell.State == TSceneCellState::Loading) {
+            const auto areAssetsLoaded = std::ranges::all_of(cell.AssetLoads, [](const std::shared_future<bool>& assetLoad) {
+                return assetLoad.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            });
+            if (areAssetsLoaded) {
+                cell.AssetLoads.clear();
+                cell.State = TSceneCellState::Creating;
+            }
+        }
+
+        if (cell.State == TSceneCellState::Creating) {
+            creatingCells.emplace_back(cellDistance, &cell);
+        }
+    }
+
+    std::ranges::sort(creatingCells, {}, &std::pair<float, TSceneCell*>::first);
+
+    // all imports of a creating cell have finished, a mesh of a streamed asset which is not published by then failed to import
+    auto hasAssetMeshFailed = [&](const TStreamedEntity& streamedEntity) {
+        return _streamedAssets.contains(streamedEntity.AssetName) &&
+               !HasAssetMesh(GetAssetMeshId(streamedEntity.AssetMeshName));
+    };
+
+    // at least one entity per frame, so that a budget smaller than a single creation still makes progress
+    auto createdEntityCount = 0u;
+    for (auto [cellDistance, cell] : creatingCells) {
+        while (cell->Entities.size() < cell->StreamedEntities.size()) {
+            if (createdEntityCount > 0 && std::chrono::steady_clock::now() >= deadline) {
+                return;
+            }
+
+            // a null entity keeps the place of a skipped one, entities and streamed entities stay index aligned
+            const auto& streamedEntity = cell->StreamedEntities[cell->Entities.size()];
+            if (hasAssetMeshFailed(streamedEntity)) {
+                spdlog::warn("Scene: Skipping {}, it failed to import from {}", streamedEntity.AssetMeshName, streamedEntity.AssetName);
+                cell->Entities.push_back(entt::null);
+                continue;
+            }
+
+            cell->Entities.push_back(AddEntity(std::nullopt,
+                                               streamedEntity.InitialTransform,
+                                               streamedEntity.AssetMeshName,
+                                               streamedEntity.AssetMaterialName,
+                                               streamedEntity.InstanceMatrices));
+            createdEntityCount++;
+        }
+
+        cell->State = TSceneCellState::Loaded;
+    }
+}
@@ -0,0 +1,159 @@
+#include "Check.hpp"
+
+#include <Hephaestus/Assets/AssetDeduplication.hpp>
+#include <Hephaestus/Assets/AssetMeshData.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+auto GetRandomAssetMeshData(std::mt19937& randomEngine) -> TAssetMeshData {
+
+    constexpr std::size_t VertexCount = 64;
+    constexpr std::size_t IndexCount = 96;
+
+    std::uniform_int_distribution<int32_t> positionDistribution(-32767, 32767);
+    std::uniform_int_distribution<uint32_t> attributeDistribution;
+    std::uniform_int_distribution<uint32_t> indexDistribution(0, VertexCount - 1);
+
+    TAssetMeshData assetMeshData;
+    for (std::size_t vertexIndex = 0; vertexIndex < VertexCount; ++vertexIndex) {
+        assetMeshData.QuantizedVertexPositions.push_back(TGpuVertexPosition{
+            .Position = glm::i16vec4(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine), 0),
+        });
+        assetMeshData.VertexNormalUvTangents.push_back(TGpuVertexNormalUvTangent{
+            .Normal = attributeDistribution(randomEngine),
+            .Tangent = attributeDistribution(randomEngine),
+            .Uv = attributeDistribution(randomEngine),
+        });
+    }
+
+    for (std::size_t index = 0; index < IndexCount; ++index) {
+        assetMeshData.Indices.push_back(indexDistribution(randomEngine));
+    }
+
+    assetMeshData.Lods = {
+        TAssetMeshLod{.IndexOffset = 0, .IndexCount = 96, .MeshletOffset = 0, .MeshletCount = 0, .Error = 0.0f},
+        TAssetMeshLod{.IndexOffset = 0, .IndexCount = 48, .MeshletOffset = 0, .MeshletCount = 0, .Error = 0.01f},
+    };
+
+    return assetMeshData;
+}
+
+// the mesh only views the streams, like a mesh mapped from the mesh cache does
+auto GetAssetMesh(const std::string& name,
+                  const TAssetMeshData& assetMeshData) -> TAssetMesh {
+
+    TAssetMesh assetMesh = {};
+    assetMesh.Name = name;
+    assetMesh.PositionDequantization = glm::mat4(1.0f);
+    assetMesh.VertexPositions = std::as_bytes(std::span(assetMeshData.QuantizedVertexPositions));
+    assetMesh.VertexPositionFormat = TVertexPositionFormat::Snorm16x4;
+    assetMesh.VertexNormalUvTangents = assetMeshData.VertexNormalUvTangents;
+    assetMesh.Lods = assetMeshData.Lods;
+    assetMesh.Indices = std::as_bytes(std::span(assetMeshData.Indices));
+    assetMesh.IndexElementType = TIndexElementType::UnsignedInteger;
+    return assetMesh;
+}
+
+auto GetAssetImage(const std::string& name,
+                   const std::vector<std::byte>& pixels) -> TAssetImage {
+
+    TAssetImage assetImage = {};
+    assetImage.Name = name;
+    assetImage.Width = 4;
+    assetImage.Height = 4;
+    assetImage.Components = 4;
+    assetImage.Format = TFormat::R8G8B8A8_UNORM;
+    assetImage.Levels = {TAssetImageLevel{.Width = 4, .Height = 4, .Offset = 0, .Size = pixels.size()}};
+    assetImage.Pixels.reset(static_cast<std::byte*>(malloc(pixels.size())));
+    std::memcpy(assetImage.Pixels.get(), pixels.data(), pixels.size());
+    return assetImage;
+}
+
+auto TestEqualMeshStreams(std::mt19937& randomEngine) -> void {
+
+    // separate copies of the same streams under different names, as two assets sharing a mesh would publish them
+    const auto assetMeshData = GetRandomAssetMeshData(randomEngine);
+    const auto otherAssetMeshData = assetMeshData;
+    const auto assetMesh = GetAssetMesh("A.mesh-0-0", assetMeshData);
+    const auto otherAssetMesh = GetAssetMesh("B.mesh-3-1", otherAssetMeshData);
+
+    CHECK(HashAssetMeshContent(assetMesh) == HashAssetMeshContent(otherAssetMesh));
+    CHECK(IsSameAssetMeshContent(assetMesh, otherAssetMesh));
+    CHECK(GetAssetMeshContentSize(assetMesh) == GetAssetMeshContentSize(otherAssetMesh));
+}
+
+auto TestDifferingMeshes(std::mt19937& randomEngine) -> void {
+
+    const auto assetMeshData = GetRandomAssetMeshData(randomEngine);
+    const auto assetMesh = GetAssetMesh("A.mesh-0-0", assetMeshData);
+
+    // levels of detail are not hashed, equal streams with another chain collide on the hash and have to be told apart by the compare
+    auto otherLodsAssetMeshData = assetMeshData;
+    otherLodsAssetMeshData.Lods.back().Error = 0.02f;
+    const auto otherLodsAssetMesh = GetAssetMesh("A.mesh-0-0", otherLodsAssetMeshData);
+    CHECK(HashAssetMeshContent(assetMesh) == HashAssetMeshContent(otherLodsAssetMesh));
+    CHECK(!IsSameAssetMeshContent(assetMesh, otherLodsAssetMesh));
+
+    auto fewerLodsAssetMeshData = assetMeshData;
+    fewerLodsAssetMeshData.Lods.pop_back();
+    CHECK(!IsSameAssetMeshContent(assetMesh, GetAssetMesh("A.mesh-0-0", fewerLodsAssetMeshData)));
+
+    auto otherIndicesAssetMeshData = assetMeshData;
+    std::swap(otherIndicesAssetMeshData.Indices.front(), otherIndicesAssetMeshData.Indices.back());
+    if (otherIndicesAssetMeshData.Indices != assetMeshData.Indices) {
+        const auto otherIndicesAssetMesh = GetAssetMesh("A.mesh-0-0", otherIndicesAssetMeshData);
+        CHECK(HashAssetMeshContent(assetMesh) != HashAssetMeshContent(otherIndicesAssetMesh));
+        CHECK(!IsSameAssetMeshContent(assetMesh, otherIndicesAssetMesh));
+    }
+
+    // the same bytes read as another position format are a different mesh
+    auto otherFormatAssetMesh = assetMesh;
+    otherFormatAssetMesh.VertexPositionFormat = TVertexPositionFormat::Float32x3;
+    CHECK(HashAssetMeshContent(assetMesh) != HashAssetMeshContent(otherFormatAssetMesh));
+    CHECK(!IsSameAssetMeshContent(assetMesh, otherFormatAssetMesh));
+
+    auto otherDequantizationAssetMesh = assetMesh;
+    otherDequantizationAssetMesh.PositionDequantization[0][0] = 2.0f;
+    CHECK(HashAssetMeshContent(assetMesh) != HashAssetMeshContent(otherDequantizationAssetMesh));
+    CHECK(!IsSameAssetMeshContent(assetMesh, otherDequantizationAssetMesh));
+}
+
+auto TestImages(std::mt19937& randomEngine) -> void {
+
+    std::uniform_int_distribution<uint32_t> byteDistribution(0, 255);
+    std::vector<std::byte> pixels(4 * 4 * 4);
+    for (auto& pixel : pixels) {
+        pixel = static_cast<std::byte>(byteDistribution(randomEngine));
+    }
+
+    const auto assetImage = GetAssetImage("A.image-0", pixels);
+    const auto otherAssetImage = GetAssetImage("B.image-2", pixels);
+    CHECK(HashAssetImageContent(assetImage) == HashAssetImageContent(otherAssetImage));
+    CHECK(IsSameAssetImageContent(assetImage, otherAssetImage));
+
+    // the same bytes read as another format are a different image
+    auto otherFormatAssetImage = GetAssetImage("A.image-0", pixels);
+    otherFormatAssetImage.Format = TFormat::R8G8B8A8_SRGB;
+    CHECK(HashAssetImageContent(assetImage) != HashAssetImageContent(otherFormatAssetImage));
+    CHECK(!IsSameAssetImageContent(assetImage, otherFormatAssetImage));
+
+    auto otherPixels = pixels;
+    otherPixels.back() ^= std::byte{1};
+    const auto otherPixelsAssetImage = GetAssetImage("A.image-0", otherPixels);
+    CHECK(HashAssetImageContent(assetImage) != HashAssetImageContent(otherPixelsAssetImage));
+    CHECK(!IsSameAssetImageContent(assetImage, otherPixelsAssetImage));
+}
+
+auto RunAssetDeduplicationTests() -> void {
+
+    std::mt19937 randomEngine(42);
+    TestEqualMeshStreams(randomEngine);
+    TestDifferingMeshes(randomEngine);
+    TestImages(randomEngine);
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "Check.hpp"
+
+#include <Hephaestus/Assets/AssetResidency.hpp>
+
+#include <algorithm>
+#include <vector>
+
+auto ContainsKey(const std::vector<TAssetResidencyKey>& keys,
+                 const TAssetResidencyKey& key) -> bool {
+
+    return std::ranges::any_of(keys, [&](const TAssetResidencyKey& otherKey) {
+        return otherKey.Kind == key.Kind && otherKey.ContentIndex == key.ContentIndex;
+    });
+}
+
+auto TestUnloadedPayloads() -> void {
+
+    const auto meshKey = TAssetResidencyKey{TAssetResidencyKind::Mesh, 0};
+    const auto imageKey = TAssetResidencyKey{TAssetResidencyKind::Image, 0};
+    const auto otherMeshKey = TAssetResidencyKey{TAssetResidencyKind::Mesh, 1};
+
+    TAssetResidency assetResidency;
+    assetResidency.Track(meshKey, 100, TAssetResidencySource{.AssetName = "A"});
+    assetResidency.Track(imageKey, 200, TAssetResidencySource{.AssetName = "A"});
+    assetResidency.Track(otherMeshKey, 300, TAssetResidencySource{.AssetName = "A"});
+    assetResidency.MarkUploaded(meshKey);
+    assetResidency.MarkUploaded(imageKey);
+    assetResidency.MarkUploaded(otherMeshKey);
+
+    // without a budget only what the renderer dropped goes
+    CHECK(assetResidency.CollectEvictions().empty());
+
+    assetResidency.MarkUnloaded(meshKey);
+    assetResidency.MarkUnloaded(imageKey);
+    assetResidency.Touch(imageKey);
+
+    const auto evictions = assetResidency.CollectEvictions();
+    CHECK(evictions.size() == 1);
+    CHECK(ContainsKey(evictions, meshKey));
+    CHECK(assetResidency.IsEvicted(meshKey));
+    CHECK(!assetResidency.IsEvicted(imageKey));
+    CHECK(!assetResidency.IsEvicted(otherMeshKey));
+    CHECK(assetResidency.GetStatistics().ResidentBytes == 500);
+    CHECK(assetResidency.GetStatistics().EvictedBytes == 100);
+
+    // read back, it is tracked like any other again
+    assetResidency.MarkReloaded(meshKey, 100);
+    CHECK(assetResidency.CollectEvictions().empty());
+}
+
+auto TestPinnedPayloads() -> void {
+
+    const auto meshKey = TAssetResidencyKey{TAssetResidencyKind::Mesh, 0};
+
+    // a payload the renderer has not uploaded yet cannot be unloaded
+    TAssetResidency assetResidency;
+    assetResidency.Track(meshKey, 100, TAssetResidencySource{.AssetName = "A"});
+    assetResidency.MarkUnloaded(meshKey);
+    CHECK(assetResidency.CollectEvictions().empty());
+    CHECK(!assetResidency.IsEvicted(meshKey));
+}
+
+auto TestBudget() -> void {
+
+    const auto meshKey = TAssetResidencyKey{TAssetResidencyKind::Mesh, 0};
+    const auto otherMeshKey = TAssetResidencyKey{TAssetResidencyKind::Mesh, 1};
+
+    TAssetResidency assetResidency;
+    assetResidency.SetBudget(150);
+    assetResidency.Track(meshKey, 100, TAssetResidencySource{.AssetName = "A"});
+    assetResidency.Track(otherMeshKey, 100, TAssetResidencySource{.AssetName = "A"});
+    assetResidency.MarkUploaded(meshKey);
+    assetResidency.MarkUploaded(otherMeshKey);
+    assetResidency.Touch(meshKey);
+
+    // least recently used first, until the resident bytes fit
+    const auto evictions = assetResidency.CollectEvictions();
+    CHECK(evictions.size() == 1);
+    CHECK(ContainsKey(evictions, otherMeshKey));
+    CHECK(assetResidency.GetStatistics().ResidentBytes == 100);
+}
+
+auto RunAssetResidencyTests() -> void {
+
+    TestUnloadedPayloads();
+    TestPinnedPayloads();
+    TestBudget();
+}
\ No newline at end of file
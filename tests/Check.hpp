@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <print>
+#include <source_location>
+
+inline int32_t g_failedCheckCount = 0;
+
+// reports a failed check and carries on, so that a single run lists every failure
+inline auto Check(
+    bool condition,
+    const char* expression,
+    std::source_location location = std::source_location::current()) -> void {
+
+    if (!condition) {
+        std::println(stderr, "{}:{}: CHECK({}) failed", location.file_name(), location.line(), expression);
+        g_failedCheckCount++;
+    }
+}
+
+#define CHECK(expression) Check((expression), #expression)
+
+// every test file registers one of these with Main.cpp
+auto RunAssetDeduplicationTests() -> void;
+auto RunAssetResidencyTests() -> void;
+auto RunFrustumCullingTests() -> void;
+auto RunRenderQueueTests() -> void;
+auto RunVertexQuantizationTests() -> void;
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "Check.hpp"
+
+#include <Hephaestus/FrustumCulling.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+// half the edge of the cube the test frustum encloses
+constexpr float FrustumHalfSize = 10.0f;
+// one short of a multiple of four, so that the full set covers the SSE2 lanes and the scalar tail
+constexpr int32_t RandomBoundsCount = 4095;
+// spans several batches of CullFrustum
+constexpr int32_t ParallelBoundsCount = 10003;
+constexpr int32_t StraddlingBoundsCount = 1000;
+
+struct TCullingTestBounds {
+    glm::vec4 Sphere;
+    glm::vec3 BoxMin;
+    glm::vec3 BoxMax;
+};
+
+// a rotated cube around the origin, so that no plane normal lines up with an axis
+auto GetCubeFrustumView(float minimumProjectedRadius) -> TFrustumCullingView {
+
+    const auto rotation = glm::mat3(glm::rotate(glm::mat4(1.0f), 0.6f, glm::normalize(glm::vec3{1.0f, 2.0f, 3.0f})));
+
+    auto view = TFrustumCullingView{};
+    for (int32_t axis = 0; axis < 3; ++axis) {
+        view.FrustumPlanes[axis * 2 + 0] = glm::vec4{-rotation[axis], FrustumHalfSize};
+        view.FrustumPlanes[axis * 2 + 1] = glm::vec4{rotation[axis], FrustumHalfSize};
+    }
+    view.CameraPosition = glm::vec3{0.0f};
+    view.ProjectionScale = 100.0f;
+    view.MinimumProjectedRadius = minimumProjectedRadius;
+    return view;
+}
+
+// the sphere encloses the box, as the bounds of a mesh do
+auto GetCullingTestBounds(const glm::vec3& boxCenter,
+                          const glm::vec3& boxExtent) -> TCullingTestBounds {
+
+    return TCullingTestBounds{
+        .Sphere = glm::vec4{boxCenter, glm::length(boxExtent)},
+        .BoxMin = boxCenter - boxExtent,
+        .BoxMax = boxCenter + boxExtent,
+    };
+}
+
+auto CullFrustumAtOnce(const TFrustumCullingView& view,
+                       std::span<const TCullingTestBounds> testBounds) -> std::vector<uint8_t> {
+
+    TFrustumCullingBounds bounds;
+    for (const auto& testBound : testBounds) {
+        bounds.Add(testBound.Sphere, testBound.BoxMin, testBound.BoxMax);
+    }
+
+    std::vector<uint8_t> visibility(testBounds.size(), 2);
+    CullFrustum(view, bounds, visibility);
+    return visibility;
+}
+
+// a single bounds does not fill the four SSE2 lanes, so every one of them takes the scalar path
+auto CullFrustumOneByOne(const TFrustumCullingView& view,
+                         std::span<const TCullingTestBounds> testBounds) -> std::vector<uint8_t> {
+
+    std::vector<uint8_t> visibility;
+    visibility.reserve(testBounds.size());
+    for (const auto& testBound : testBounds) {
+        visibility.push_back(CullFrustumAtOnce(view, std::span(&testBound, 1))[0]);
+    }
+    return visibility;
+}
+
+auto GetRandomCullingTestBounds(std::mt19937& randomEngine,
+                                int32_t count) -> std::vector<TCullingTestBounds> {
+
+    std::uniform_real_distribution<float> centerDistribution(-2.0f * FrustumHalfSize, 2.0f * FrustumHalfSize);
+    std::uniform_real_distribution<float> extentDistribution(0.001f, 5.0f);
+
+    std::vector<TCullingTestBounds> testBounds;
+    for (int32_t index = 0; index < count; ++index) {
+        const auto boxCenter = glm::vec3{centerDistribution(randomEngine), centerDistribution(randomEngine), centerDistribution(randomEngine)};
+        const auto boxExtent = glm::vec3{extentDistribution(randomEngine), extentDistribution(randomEngine), extentDistribution(randomEngine)};
+        testBounds.push_back(GetCullingTestBounds(boxCenter, boxExtent));
+    }
+    return testBounds;
+}
+
+auto TestRandomBounds(std::mt19937& randomEngine) -> void {
+
+    for (const auto minimumProjectedRadius : {0.0f, 4.0f}) {
+        const auto view = GetCubeFrustumView(minimumProjectedRadius);
+        for (const auto count : {RandomBoundsCount, ParallelBoundsCount}) {
+            const auto testBounds = GetRandomCullingTestBounds(randomEngine, count);
+            const auto visibility = CullFrustumAtOnce(view, testBounds);
+
+            CHECK(visibility == CullFrustumOneByOne(view, testBounds));
+            // the draw is neither all in nor all out, or the comparison above would say little
+            CHECK(std::ranges::count(visibility, 0) > 0);
+            CHECK(std::ranges::count(visibility, 1) > 0);
+        }
+    }
+}
+
+// boxes on one face of the cube and well inside the other five, they straddle the face, touch it from outside or miss it
+auto TestStraddlingBounds(std::mt19937& randomEngine) -> void {
+
+    std::uniform_real_distribution<float> extentDistribution(0.001f, 2.0f);
+    std::uniform_real_distribution<float> faceDistribution(-0.5f * FrustumHalfSize, 0.5f * FrustumHalfSize);
+    std::uniform_real_distribution<float> straddleDistribution(-0.99f, 0.99f);
+
+    const auto view = GetCubeFrustumView(0.0f);
+    for (const auto& frustumPlane : view.FrustumPlanes) {
+        const auto outward = -glm::vec3(frustumPlane);
+        const auto tangent = glm::normalize(glm::cross(outward, glm::abs(outward.x) < 0.9f ? glm::vec3{1.0f, 0.0f, 0.0f} : glm::vec3{0.0f, 1.0f, 0.0f}));
+        const auto bitangent = glm::cross(outward, tangent);
+
+        std::vector<TCullingTestBounds> straddlingBounds;
+        std::vector<TCullingTestBounds> touchingBounds;
+        std::vector<TCullingTestBounds> outsideBounds;
+        for (int32_t index = 0; index < StraddlingBoundsCount; ++index) {
+            const auto boxExtent = glm::vec3{extentDistribution(randomEngine), extentDistribution(randomEngine), extentDistribution(randomEngine)};
+            // how far the box reaches along the plane normal
+            const auto boxRadius = glm::dot(glm::abs(outward), boxExtent);
+            const auto faceCenter = outward * FrustumHalfSize + tangent * faceDistribution(randomEngine) + bitangent * faceDistribution(randomEngine);
+
+            straddlingBounds.push_back(GetCullingTestBounds(faceCenter + outward * (boxRadius * straddleDistribution(randomEngine)), boxExtent));
+            // the support point lands within rounding of the plane, where a differently summed distance would flip
+            touchingBounds.push_back(GetCullingTestBounds(faceCenter + outward * boxRadius, boxExtent));
+            outsideBounds.push_back(GetCullingTestBounds(faceCenter + outward * (boxRadius + 0.01f), boxExtent));
+        }
+
+        const auto straddlingVisibility = CullFrustumAtOnce(view, straddlingBounds);
+        CHECK(straddlingVisibility == CullFrustumOneByOne(view, straddlingBounds));
+        CHECK(std::ranges::all_of(straddlingVisibility, [](uint8_t isVisible) { return isVisible == 1; }));
+
+        CHECK(CullFrustumAtOnce(view, touchingBounds) == CullFrustumOneByOne(view, touchingBounds));
+
+        const auto outsideVisibility = CullFrustumAtOnce(view, outsideBounds);
+        CHECK(outsideVisibility == CullFrustumOneByOne(view, outsideBounds));
+        CHECK(std::ranges::all_of(outsideVisibility, [](uint8_t isVisible) { return isVisible == 0; }));
+    }
+}
+
+// spheres of a fixed size walk away from the camera, they drop out once their projected radius falls below the minimum
+auto TestTinyBounds() -> void {
+
+    const auto view = GetCubeFrustumView(4.0f);
+
+    std::vector<TCullingTestBounds> testBounds;
+    for (int32_t step = 1; step <= 100; ++step) {
+        const auto distance = FrustumHalfSize * static_cast<float>(step) / 100.0f;
+        testBounds.push_back(GetCullingTestBounds(glm::vec3(view.FrustumPlanes[0]) * distance, glm::vec3{0.01f}));
+    }
+
+    const auto visibility = CullFrustumAtOnce(view, testBounds);
+    CHECK(visibility == CullFrustumOneByOne(view, testBounds));
+    for (std::size_t index = 0; index < testBounds.size(); ++index) {
+        const auto& sphere = testBounds[index].Sphere;
+        const auto isLargeEnough = sphere.w * view.ProjectionScale >= view.MinimumProjectedRadius * glm::length(glm::vec3(sphere));
+        CHECK(visibility[index] == (isLargeEnough ? 1 : 0));
+    }
+}
+
+auto RunFrustumCullingTests() -> void {
+
+    // fixed seed, a failure has to be reproducible
+    std::mt19937 randomEngine(42);
+
+    TestRandomBounds(randomEngine);
+    TestStraddlingBounds(randomEngine);
+    TestTinyBounds();
+}
\ No newline at end of file
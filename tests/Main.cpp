@@ -0,0 +1,21 @@
+#include "Check.hpp"
+
+#include <cstdint>
+#include <print>
+
+auto main() -> int32_t {
+
+    RunAssetDeduplicationTests();
+    RunAssetResidencyTests();
+    RunFrustumCullingTests();
+    RunRenderQueueTests();
+    RunVertexQuantizationTests();
+
+    if (g_failedCheckCount > 0) {
+        std::println(stderr, "Tests: {} checks failed", g_failedCheckCount);
+        return 1;
+    }
+
+    std::println("Tests: All checks passed");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "Check.hpp"
+
+#include <Hephaestus/RenderQueue.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+constexpr int32_t SortKeyCount = 10000;
+
+// the keys in the order of the queue against std::sort, and the draw indices against std::stable_sort,
+// an LSD radix sort keeps draws of equal keys in the order they were added
+auto CheckSortedLikeStd(std::span<const uint64_t> sortKeys) -> void {
+
+    TRenderQueue renderQueue;
+    // a frame of leftovers first, Clear has to drop them and the scratch storage must not leak into the next sort
+    renderQueue.Add(~0ull, 0);
+    renderQueue.Sort();
+    renderQueue.Clear();
+
+    for (std::size_t index = 0; index < sortKeys.size(); ++index) {
+        renderQueue.Add(sortKeys[index], static_cast<uint32_t>(index));
+    }
+    renderQueue.Sort();
+
+    const auto drawIndices = renderQueue.GetDrawIndices();
+    CHECK(drawIndices.size() == sortKeys.size());
+
+    std::vector<uint64_t> radixSortedKeys;
+    for (const auto drawIndex : drawIndices) {
+        radixSortedKeys.push_back(sortKeys[drawIndex]);
+    }
+    std::vector<uint64_t> stdSortedKeys(sortKeys.begin(), sortKeys.end());
+    std::sort(stdSortedKeys.begin(), stdSortedKeys.end());
+    CHECK(radixSortedKeys == stdSortedKeys);
+
+    std::vector<uint32_t> stableDrawIndices(sortKeys.size());
+    std::iota(stableDrawIndices.begin(), stableDrawIndices.end(), 0u);
+    std::ranges::stable_sort(stableDrawIndices, {}, [&](uint32_t drawIndex) { return sortKeys[drawIndex]; });
+    CHECK(std::ranges::equal(drawIndices, stableDrawIndices));
+}
+
+// every byte differs between the keys, no pass is skipped
+auto TestRandomKeys(std::mt19937& randomEngine) -> void {
+
+    std::uniform_int_distribution<uint64_t> keyDistribution;
+
+    std::vector<uint64_t> sortKeys;
+    for (int32_t index = 0; index < SortKeyCount; ++index) {
+        sortKeys.push_back(keyDistribution(randomEngine));
+    }
+    CheckSortedLikeStd(sortKeys);
+}
+
+// keys as a frame with few pipelines, materials and meshes produces them, the upper bytes are the same for every key
+// and their passes are skipped, which also leaves the sorted keys in the scratch storage after an odd number of passes
+auto TestSkippedPasses(std::mt19937& randomEngine) -> void {
+
+    std::uniform_int_distribution<uint32_t> stateDistribution(0, 3);
+    std::uniform_real_distribution<float> depthDistribution(0.1f, 1000.0f);
+
+    std::vector<uint64_t> sortKeys;
+    for (int32_t index = 0; index < SortKeyCount; ++index) {
+        sortKeys.push_back(MakeDrawSortKey(0, 1, stateDistribution(randomEngine), stateDistribution(randomEngine), depthDistribution(randomEngine)));
+    }
+    CheckSortedLikeStd(sortKeys);
+
+    // a single pass, on the most significant byte
+    std::vector<uint64_t> topByteKeys;
+    for (int32_t index = 0; index < SortKeyCount; ++index) {
+        topByteKeys.push_back(static_cast<uint64_t>(stateDistribution(randomEngine)) << 56 | 0x0123456789abcdull);
+    }
+    CheckSortedLikeStd(topByteKeys);
+
+    // every pass skipped, the draws stay in the order they were added
+    CheckSortedLikeStd(std::vector<uint64_t>(SortKeyCount, MakeDrawSortKey(1, 2, 3, 4, 5.0f)));
+    CheckSortedLikeStd({});
+}
+
+auto RunRenderQueueTests() -> void {
+
+    // fixed seed, a failure has to be reproducible
+    std::mt19937 randomEngine(42);
+
+    TestRandomKeys(randomEngine);
+    TestSkippedPasses(randomEngine);
+}
\ No newline at end of file
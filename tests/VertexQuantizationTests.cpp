@@ -0,0 +1,126 @@
+#include "Check.hpp"
+
+#include <Hephaestus/Assets/VertexQuantization.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vector_relational.hpp>
+
+// a snorm 2x16 component steps by 1 / 32767, octahedral decoding bends that by less than a factor of two
+constexpr float NormalErrorBound = 1e-4f;
+// the bitangent sign takes the lowest bit of .y, which doubles its step
+constexpr float TangentErrorBound = 2e-4f;
+// half floats keep 11 significant bits, below 2^-14 they are denormal with a fixed step of 2^-24
+constexpr float UvRelativeErrorBound = 1.0f / 2048.0f;
+constexpr float UvAbsoluteErrorBound = 1.0f / 16777216.0f;
+constexpr int32_t RoundTripCount = 100000;
+
+auto GetRandomUnitVector(std::mt19937& randomEngine) -> glm::vec3 {
+
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    while (true) {
+        const auto vector = glm::vec3{distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)};
+        const auto length = glm::length(vector);
+        if (length > 1e-3f && length <= 1.0f) {
+            return vector / length;
+        }
+    }
+}
+
+auto TestNormalRoundTrip(std::mt19937& randomEngine) -> void {
+
+    // the axes and the octahedron edges of the lower hemisphere are where the folding kicks in
+    constexpr std::array edgeNormals = {
+        glm::vec3{1.0f, 0.0f, 0.0f}, glm::vec3{-1.0f, 0.0f, 0.0f},
+        glm::vec3{0.0f, 1.0f, 0.0f}, glm::vec3{0.0f, -1.0f, 0.0f},
+        glm::vec3{0.0f, 0.0f, 1.0f}, glm::vec3{0.0f, 0.0f, -1.0f},
+        glm::vec3{0.70710678f, 0.0f, -0.70710678f}, glm::vec3{0.0f, -0.70710678f, -0.70710678f},
+    };
+    for (const auto& normal : edgeNormals) {
+        CHECK(glm::length(DecodeNormal(EncodeNormal(normal)) - normal) <= NormalErrorBound);
+    }
+
+    auto maxError = 0.0f;
+    for (int32_t roundTrip = 0; roundTrip < RoundTripCount; ++roundTrip) {
+        const auto normal = GetRandomUnitVector(randomEngine);
+        maxError = std::max(maxError, glm::length(DecodeNormal(EncodeNormal(normal)) - normal));
+    }
+    CHECK(maxError <= NormalErrorBound);
+}
+
+auto TestTangentRoundTrip(std::mt19937& randomEngine) -> void {
+
+    auto maxError = 0.0f;
+    auto signMismatchCount = 0;
+    for (int32_t roundTrip = 0; roundTrip < RoundTripCount; ++roundTrip) {
+        const auto tangent = glm::vec4{GetRandomUnitVector(randomEngine), roundTrip % 2 == 0 ? 1.0f : -1.0f};
+        const auto decodedTangent = DecodeTangent(EncodeTangent(tangent));
+        maxError = std::max(maxError, glm::length(glm::vec3{decodedTangent} - glm::vec3{tangent}));
+        if (decodedTangent.w != tangent.w) {
+            signMismatchCount++;
+        }
+    }
+    CHECK(maxError <= TangentErrorBound);
+    CHECK(signMismatchCount == 0);
+}
+
+auto TestUvRoundTrip(std::mt19937& randomEngine) -> void {
+
+    // wrapping and mirroring materials reach well outside of 0..1
+    std::uniform_real_distribution<float> distribution(-8.0f, 8.0f);
+    auto outOfBoundsCount = 0;
+    for (int32_t roundTrip = 0; roundTrip < RoundTripCount; ++roundTrip) {
+        const auto uv = glm::vec2{distribution(randomEngine), distribution(randomEngine)};
+        const auto error = glm::abs(DecodeUv(EncodeUv(uv)) - uv);
+        const auto errorBound = glm::abs(uv) * UvRelativeErrorBound + UvAbsoluteErrorBound;
+        if (error.x > errorBound.x || error.y > errorBound.y) {
+            outOfBoundsCount++;
+        }
+    }
+    CHECK(outOfBoundsCount == 0);
+    CHECK(DecodeUv(EncodeUv(glm::vec2{0.0f, 1.0f})) == glm::vec2(0.0f, 1.0f));
+}
+
+auto TestPositionRoundTrip(std::mt19937& randomEngine) -> void {
+
+    std::uniform_real_distribution<float> boundsDistribution(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> unitDistribution(0.0f, 1.0f);
+    auto outOfBoundsCount = 0;
+    for (int32_t boundsIndex = 0; boundsIndex < 100; ++boundsIndex) {
+        const auto corner = glm::vec3{boundsDistribution(randomEngine), boundsDistribution(randomEngine), boundsDistribution(randomEngine)};
+        const auto otherCorner = glm::vec3{boundsDistribution(randomEngine), boundsDistribution(randomEngine), boundsDistribution(randomEngine)};
+        const auto boundsMin = glm::min(corner, otherCorner);
+        const auto boundsMax = glm::max(corner, otherCorner);
+        const auto positionQuantization = GetPositionQuantization(boundsMin, boundsMax);
+
+        // rounding to the nearest step is off by half a step at most, plus what floats lose at this magnitude
+        const auto errorBound = positionQuantization.Scale * (0.5f / 32767.0f) + 1e-5f;
+        for (int32_t positionIndex = 0; positionIndex < 1000; ++positionIndex) {
+            const auto position = glm::mix(boundsMin, boundsMax, glm::vec3{unitDistribution(randomEngine), unitDistribution(randomEngine), unitDistribution(randomEngine)});
+            const auto error = glm::abs(DecodePosition(EncodePosition(position, positionQuantization), positionQuantization) - position);
+            if (glm::any(glm::greaterThan(error, errorBound))) {
+                outOfBoundsCount++;
+            }
+        }
+    }
+    CHECK(outOfBoundsCount == 0);
+
+    // a flat axis has nothing to spread over, every position on it has to come back exactly
+    const auto flatPositionQuantization = GetPositionQuantization(glm::vec3{-1.0f, 2.0f, -1.0f}, glm::vec3{1.0f, 2.0f, 1.0f});
+    CHECK(DecodePosition(EncodePosition(glm::vec3{0.5f, 2.0f, 0.5f}, flatPositionQuantization), flatPositionQuantization).y == 2.0f);
+}
+
+auto RunVertexQuantizationTests() -> void {
+
+    // fixed seed, a failure has to be reproducible
+    std::mt19937 randomEngine(42);
+    TestNormalRoundTrip(randomEngine);
+    TestTangentRoundTrip(randomEngine);
+    TestUvRoundTrip(randomEngine);
+    TestPositionRoundTrip(randomEngine);
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <Hephaestus/Assets/AssetArchive.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <print>
+#include <vector>
+
+// AssetArchiver <archive> <directory>...
+//
+// every file below the given directories is stored under its path as given on the command line,
+// run it from the directory the application runs from, so the names match what the asset loader asks for
+auto main(
+    int32_t argc,
+    char* argv[]) -> int32_t {
+
+    if (argc < 3) {
+        std::println(stderr, "Usage: AssetArchiver <archive> <directory>...");
+        return 1;
+    }
+
+    std::vector<TAssetArchiveSourceFile> sourceFiles;
+    for (int32_t argumentIndex = 2; argumentIndex < argc; ++argumentIndex) {
+
+        const std::filesystem::path directory = argv[argumentIndex];
+        std::error_code errorCode;
+        for (const auto& directoryEntry : std::filesystem::recursive_directory_iterator(directory, errorCode)) {
+            if (directoryEntry.is_regular_file()) {
+                sourceFiles.push_back(TAssetArchiveSourceFile{
+                    .Name = GetAssetFileName(directoryEntry.path()),
+                    .FilePath = directoryEntry.path(),
+                });
+            }
+        }
+
+        if (errorCode) {
+            std::println(stderr, "AssetArchiver: Unable to read {}: {}", directory.string(), errorCode.message());
+            return 1;
+        }
+    }
+
+    // directory iteration order is unspecified, sorting keeps archives of the same files byte identical
+    std::ranges::sort(sourceFiles, {}, &TAssetArchiveSourceFile::Name);
+
+    if (auto writeResult = WriteAssetArchive(argv[1], sourceFiles); !writeResult) {
+        std::println(stderr, "{}", writeResult.error());
+        return 1;
+    }
+
+    std::println("AssetArchiver: Packed {} files into {}", sourceFiles.size(), argv[1]);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include <Hephaestus/Assets/Assets.hpp>
+#include <Hephaestus/Assets/AssetRegistry.hpp>
+#include <Hephaestus/Assets/MeshCache.hpp>
+#include <Hephaestus/FrustumCulling.hpp>
+#include <Hephaestus/MainThreadQueue.hpp>
+#include <Hephaestus/RenderQueue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <print>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_access.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <parallel_hashmap/phmap.h>
+
+constexpr int32_t FrameCount = 100;
+
+auto GetElapsedMilliseconds(std::chrono::steady_clock::time_point startTime) -> double {
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+// average over FrameCount runs of the frame
+auto MeasureFrame(auto&& frame) -> double {
+
+    const auto startTime = std::chrono::steady_clock::now();
+    for (int32_t frameIndex = 0; frameIndex < FrameCount; ++frameIndex) {
+        frame();
+    }
+
+    return GetElapsedMilliseconds(startTime) / FrameCount;
+}
+
+struct TBenchmarkMesh {
+    uint32_t IndexCount;
+};
+
+// the per frame lookups of the render loop, entities referencing their mesh by name through a string keyed map
+// against entities holding an interned id into TAssetRegistry
+auto RunAssetRegistryBenchmark() -> int32_t {
+
+    constexpr std::size_t EntityCount = 100000;
+    constexpr std::size_t MeshCount = 1000;
+
+    phmap::flat_hash_map<std::string, TBenchmarkMesh> meshesByName;
+    TAssetRegistry<TAssetMeshId, TBenchmarkMesh> meshRegistry;
+    for (std::size_t meshIndex = 0; meshIndex < MeshCount; ++meshIndex) {
+        // long enough to leave the small string buffer, like the asset.mesh-primitive names of real assets
+        auto meshName = std::format("Benchmark.mesh-{}-primitive", meshIndex);
+        meshesByName[meshName] = TBenchmarkMesh{static_cast<uint32_t>(meshIndex)};
+        meshRegistry.Publish(meshName, TBenchmarkMesh{static_cast<uint32_t>(meshIndex)}, meshIndex, [](const auto&, const auto&) { return false; });
+    }
+
+    std::vector<std::string> entityMeshNames;
+    std::vector<TAssetMeshId> entityMeshIds;
+    entityMeshNames.reserve(EntityCount);
+    entityMeshIds.reserve(EntityCount);
+    for (std::size_t entityIndex = 0; entityIndex < EntityCount; ++entityIndex) {
+        auto meshName = std::format("Benchmark.mesh-{}-primitive", (entityIndex * 7919) % MeshCount);
+        entityMeshIds.push_back(meshRegistry.Intern(meshName));
+        entityMeshNames.push_back(std::move(meshName));
+    }
+
+    // the sums keep the lookups from being optimized away and have to agree
+    uint64_t nameIndexCount = 0;
+    const auto nameDuration = MeasureFrame([&]() {
+        for (const auto& entityMeshName : entityMeshNames) {
+            nameIndexCount += meshesByName.at(entityMeshName).IndexCount;
+        }
+    });
+
+    uint64_t idIndexCount = 0;
+    const auto idDuration = MeasureFrame([&]() {
+        for (const auto entityMeshId : entityMeshIds) {
+            idIndexCount += meshRegistry.Get(entityMeshId).IndexCount;
+        }
+    });
+
+    std::println("AssetRegistry: {} entities, by name {:.3f} ms, by id {:.3f} ms per frame", EntityCount, nameDuration, idDuration);
+    return nameIndexCount == idIndexCount ? 0 : 1;
+}
+
+// sorting the draws of a frame, TRenderQueue's radix sort against std::sort on the same keys, with as many pipelines,
+// materials and meshes as a large scene has, so that only the passes of the upper bytes are skipped
+auto RunRenderQueueBenchmark() -> int32_t {
+
+    constexpr std::size_t DrawCount = 100000;
+
+    // fixed seed, every run sorts the same keys
+    std::mt19937 randomEngine(42);
+    std::uniform_int_distribution<uint32_t> pipelineDistribution(0, 7);
+    std::uniform_int_distribution<uint32_t> materialDistribution(0, 499);
+    std::uniform_int_distribution<uint32_t> meshDistribution(0, 1999);
+    std::uniform_real_distribution<float> depthDistribution(0.1f, 1000.0f);
+
+    std::vector<uint64_t> sortKeys;
+    sortKeys.reserve(DrawCount);
+    for (std::size_t drawIndex = 0; drawIndex < DrawCount; ++drawIndex) {
+        sortKeys.push_back(MakeDrawSortKey(0,
+                                           pipelineDistribution(randomEngine),
+                                           materialDistribution(randomEngine),
+                                           meshDistribution(randomEngine),
+                                           depthDistribution(randomEngine)));
+    }
+
+    TRenderQueue renderQueue;
+    const auto radixDuration = MeasureFrame([&]() {
+        renderQueue.Clear();
+        for (std::size_t drawIndex = 0; drawIndex < DrawCount; ++drawIndex) {
+            renderQueue.Add(sortKeys[drawIndex], static_cast<uint32_t>(drawIndex));
+        }
+        renderQueue.Sort();
+    });
+
+    // key and draw index together, as the queue carries them
+    std::vector<std::pair<uint64_t, uint32_t>> sortedDraws;
+    sortedDraws.reserve(DrawCount);
+    const auto stdDuration = MeasureFrame([&]() {
+        sortedDraws.clear();
+        for (std::size_t drawIndex = 0; drawIndex < DrawCount; ++drawIndex) {
+            sortedDraws.emplace_back(sortKeys[drawIndex], static_cast<uint32_t>(drawIndex));
+        }
+        std::sort(sortedDraws.begin(), sortedDraws.end(), [](const auto& left, const auto& right) { return left.first < right.first; });
+    });
+
+    // both orders have to put the same keys in the same places, draws of equal keys may differ
+    const auto drawIndices = renderQueue.GetDrawIndices();
+    auto isSortedAlike = drawIndices.size() == sortedDraws.size();
+    for (std::size_t index = 0; isSortedAlike && index < drawIndices.size(); ++index) {
+        isSortedAlike = sortKeys[drawIndices[index]] == sortedDraws[index].first;
+    }
+
+    std::println("RenderQueue: {} draws, radix sort {:.3f} ms, std::sort {:.3f} ms per frame", DrawCount, radixDuration, stdDuration);
+    return isSortedAlike ? 0 : 1;
+}
+
+// the visibility pass of a frame, 100k world bounds scattered around a camera at 1080p, culled as a whole across the pool
+// and batch by batch on this thread, the batches stay below the size CullFrustum splits at, so each runs inline
+auto RunFrustumCullingBenchmark() -> int32_t {
+
+    constexpr std::size_t BoundsCount = 100000;
+    constexpr std::size_t SequentialBatchSize = 4096;
+
+    const auto projectionMatrix = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const auto viewMatrix = glm::lookAt(glm::vec3{0.0f, 2.0f, 0.0f}, glm::vec3{1.0f, 2.0f, 1.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+    const auto viewProjectionMatrix = projectionMatrix * viewMatrix;
+
+    auto view = TFrustumCullingView{
+        .CameraPosition = glm::vec3{0.0f, 2.0f, 0.0f},
+        .ProjectionScale = projectionMatrix[1][1] * 0.5f * 1080.0f,
+        .MinimumProjectedRadius = 0.5f,
+    };
+    view.FrustumPlanes[0] = glm::row(viewProjectionMatrix, 3) + glm::row(viewProjectionMatrix, 0);
+    view.FrustumPlanes[1] = glm::row(viewProjectionMatrix, 3) - glm::row(viewProjectionMatrix, 0);
+    view.FrustumPlanes[2] = glm::row(viewProjectionMatrix, 3) + glm::row(viewProjectionMatrix, 1);
+    view.FrustumPlanes[3] = glm::row(viewProjectionMatrix, 3) - glm::row(viewProjectionMatrix, 1);
+    view.FrustumPlanes[4] = glm::row(viewProjectionMatrix, 3) + glm::row(viewProjectionMatrix, 2);
+    view.FrustumPlanes[5] = glm::row(viewProjectionMatrix, 3) - glm::row(viewProjectionMatrix, 2);
+    for (auto& frustumPlane : view.FrustumPlanes) {
+        frustumPlane /= glm::length(glm::vec3(frustumPlane));
+    }
+
+    // fixed seed, every run culls the same bounds, part of them in the frustum, part behind or beside the camera
+    std::mt19937 randomEngine(42);
+    std::uniform_real_distribution<float> centerDistribution(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> heightDistribution(0.0f, 20.0f);
+    std::uniform_real_distribution<float> extentDistribution(0.05f, 5.0f);
+
+    TFrustumCullingBounds bounds;
+    std::vector<TFrustumCullingBounds> sequentialBounds((BoundsCount + SequentialBatchSize - 1) / SequentialBatchSize);
+    for (std::size_t boundsIndex = 0; boundsIndex < BoundsCount; ++boundsIndex) {
+        const auto boxCenter = glm::vec3{centerDistribution(randomEngine), heightDistribution(randomEngine), centerDistribution(randomEngine)};
+        const auto boxExtent = glm::vec3{extentDistribution(randomEngine), extentDistribution(randomEngine), extentDistribution(randomEngine)};
+        const auto sphere = glm::vec4{boxCenter, glm::length(boxExtent)};
+        bounds.Add(sphere, boxCenter - boxExtent, boxCenter + boxExtent);
+        sequentialBounds[boundsIndex / SequentialBatchSize].Add(sphere, boxCenter - boxExtent, boxCenter + boxExtent);
+    }
+
+    std::vector<uint8_t> sequentialVisibility(BoundsCount);
+    const auto sequentialDuration = MeasureFrame([&]() {
+        for (std::size_t batchIndex = 0; batchIndex < sequentialBounds.size(); ++batchIndex) {
+            const auto first = batchIndex * SequentialBatchSize;
+            CullFrustum(view, sequentialBounds[batchIndex], std::span(sequentialVisibility).subspan(first, sequentialBounds[batchIndex].GetCount()));
+        }
+    });
+
+    std::vector<uint8_t> parallelVisibility(BoundsCount);
+    const auto parallelDuration = MeasureFrame([&]() {
+        CullFrustum(view, bounds, parallelVisibility);
+    });
+
+    const auto visibleCount = std::ranges::count(parallelVisibility, 1);
+    std::println("FrustumCulling: {} bounds, {} visible, single thread {:.3f} ms, pool {:.3f} ms per frame",
+                 BoundsCount, visibleCount, sequentialDuration, parallelDuration);
+    return sequentialVisibility == parallelVisibility ? 0 : 1;
+}
+
+// imports the asset once per pool size, from a single thread up to every core, the mesh cache is removed before
+// each pass, otherwise every pass after the first would only map the cooked meshes back in
+auto RunAssetLoadBenchmark(const std::filesystem::path& assetFilePath) -> int32_t {
+
+    const auto coreCount = std::max(std::thread::hardware_concurrency(), 1u);
+    for (uint32_t threadCount = 1; threadCount <= coreCount; ++threadCount) {
+
+        SetAssetThreadCount(threadCount);
+        RemoveMeshCacheEntries(assetFilePath);
+
+        // a name of its own per pass, so that no pass publishes as a reload of the previous one
+        const auto assetName = std::format("{}-{}", assetFilePath.stem().string(), threadCount);
+        if (auto scanResult = ScanAsset(assetName, assetFilePath); !scanResult) {
+            std::println(stderr, "{}", scanResult.error());
+            return 1;
+        }
+
+        const auto loadStartTime = std::chrono::steady_clock::now();
+        auto loadResult = LoadAssetAsync(assetName, TAssetImportSettings{}, {});
+        WaitForAssetLoads();
+        const auto loadDuration = GetElapsedMilliseconds(loadStartTime);
+        DrainMainThreadQueue();
+
+        if (!loadResult.get()) {
+            std::println(stderr, "Benchmarks: Unable to load {}", assetFilePath.string());
+            return 1;
+        }
+
+        std::println("AssetLoad: {} threads {:.2f} ms", threadCount, loadDuration);
+    }
+
+    RemoveMeshCacheEntries(assetFilePath);
+    return 0;
+}
+
+// Benchmarks <benchmark> [arguments]
+//
+// AssetLoad <asset>    parallel import of a glTF asset, sweeping the size of the asset thread pool
+// AssetRegistry        per frame mesh lookups of 100k entities, by name against by interned id
+// FrustumCulling       visibility of 100k world bounds, on a single thread against across the thread pool
+// RenderQueue          sorting the draw keys of 100k draws, radix sort against std::sort
+auto main(
+    int32_t argc,
+    char* argv[]) -> int32_t {
+
+    const auto benchmarkName = argc > 1 ? std::string_view(argv[1]) : std::string_view();
+    if (benchmarkName == "AssetLoad" && argc == 3) {
+        return RunAssetLoadBenchmark(argv[2]);
+    }
+    if (benchmarkName == "AssetRegistry") {
+        return RunAssetRegistryBenchmark();
+    }
+    if (benchmarkName == "FrustumCulling") {
+        return RunFrustumCullingBenchmark();
+    }
+    if (benchmarkName == "RenderQueue") {
+        return RunRenderQueueBenchmark();
+    }
+
+    std::println(stderr, "Usage: Benchmarks AssetLoad <asset> | AssetRegistry | FrustumCulling | RenderQueue");
+    return 1;
+}
\ No newline at end of file